@@ -1,11 +1,13 @@
 #include <benchmark/benchmark.h>
 
 #include "components/esm/refid.hpp"
+#include "components/esm/stringrefidtable.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -233,6 +235,40 @@ namespace
                 i = 0;
         }
     }
+
+    void findStringRefIdInUnorderedMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<ESM::RefId> refIds = generateStringRefIds(state.range(0), random);
+        std::unordered_map<ESM::RefId, std::size_t> map;
+        for (std::size_t i = 0; i < refIds.size(); ++i)
+            map.emplace(refIds[i], i + 1);
+        std::shuffle(refIds.begin(), refIds.end(), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(refIds[i]));
+            if (++i >= refIds.size())
+                i = 0;
+        }
+    }
+
+    void findStringRefIdInStringRefIdTable(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<ESM::RefId> refIds = generateStringRefIds(state.range(0), random);
+        ESM::StringRefIdTable<std::size_t> table;
+        for (std::size_t i = 0; i < refIds.size(); ++i)
+            table.set(*refIds[i].getIf<ESM::StringRefId>(), i + 1);
+        std::shuffle(refIds.begin(), refIds.end(), random);
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(table.get(*refIds[i].getIf<ESM::StringRefId>()));
+            if (++i >= refIds.size())
+                i = 0;
+        }
+    }
 }
 
 BENCHMARK(serializeRefId)->RangeMultiplier(4)->Range(8, 64);
@@ -245,5 +281,7 @@ BENCHMARK(serializeTextIndexRefId);
 BENCHMARK(deserializeTextIndexRefId);
 BENCHMARK(serializeTextESM3ExteriorCellRefId);
 BENCHMARK(deserializeTextESM3ExteriorCellRefId);
+BENCHMARK(findStringRefIdInUnorderedMap)->Arg(16);
+BENCHMARK(findStringRefIdInStringRefIdTable)->Arg(16);
 
 BENCHMARK_MAIN();
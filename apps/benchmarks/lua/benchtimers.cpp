@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include "components/lua/timerwheel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr double ticksPerSecond = 16;
+    constexpr double frameDuration = 1.0 / 60;
+    constexpr double maxDelay = 600;
+
+    struct Timer
+    {
+        int mScriptId;
+        std::int64_t mCallback;
+    };
+
+    // Binary heap, the way ScriptsContainer used to keep timers. Used as a baseline.
+    class TimerHeap
+    {
+    public:
+        explicit TimerHeap(double /*ticksPerUnit*/) {}
+
+        void insert(double time, Timer value)
+        {
+            mHeap.push_back(Entry{ time, value });
+            std::push_heap(mHeap.begin(), mHeap.end());
+        }
+
+        void advance(double /*time*/) {}
+
+        bool hasDue(double time) const { return !mHeap.empty() && mHeap.front().mTime <= time; }
+
+        Timer popDue()
+        {
+            std::pop_heap(mHeap.begin(), mHeap.end());
+            const Timer value = mHeap.back().mValue;
+            mHeap.pop_back();
+            return value;
+        }
+
+    private:
+        struct Entry
+        {
+            double mTime;
+            Timer mValue;
+
+            bool operator<(const Entry& other) const { return mTime > other.mTime; }
+        };
+
+        std::vector<Entry> mHeap;
+    };
+
+    template <class Queue, class Random>
+    void fill(Queue& queue, std::size_t count, double time, Random& random)
+    {
+        std::uniform_real_distribution<double> delay(0, maxDelay);
+        for (std::size_t i = 0; i < count; ++i)
+            queue.insert(time + delay(random), Timer{ static_cast<int>(i % 64), static_cast<std::int64_t>(i % 8) });
+    }
+
+    template <class Queue>
+    void insertTimers(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Queue queue(ticksPerSecond);
+            fill(queue, state.range(0), 0, random);
+            benchmark::DoNotOptimize(queue);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Every iteration is a frame: due timers are called and rescheduled, so the number of pending timers stays
+    // the same.
+    template <class Queue>
+    void processTimers(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<double> delay(0, maxDelay);
+        Queue queue(ticksPerSecond);
+        double time = 0;
+        fill(queue, state.range(0), time, random);
+        std::size_t called = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            time += frameDuration;
+            queue.advance(time);
+            while (queue.hasDue(time))
+            {
+                const Timer timer = queue.popDue();
+                benchmark::DoNotOptimize(timer);
+                queue.insert(time + delay(random), timer);
+                ++called;
+            }
+        }
+        state.counters["called"] = benchmark::Counter(static_cast<double>(called), benchmark::Counter::kAvgIterations);
+    }
+
+    using TimerWheel = LuaUtil::TimerWheel<Timer>;
+}
+
+BENCHMARK_TEMPLATE(insertTimers, TimerHeap)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(insertTimers, TimerWheel)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(processTimers, TimerHeap)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(processTimers, TimerWheel)->RangeMultiplier(10)->Range(1000, 100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include "components/misc/segmentedlist.hpp"
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Roughly the size and layout of MWWorld::LiveCellRef: a few pointers, position and some runtime data.
+    struct Ref
+    {
+        const void* mClass = nullptr;
+        std::array<float, 6> mPosition{};
+        std::array<std::byte, 160> mCellRef{};
+        bool mEnabled = true;
+        int mCount = 1;
+        std::array<std::byte, 64> mRefData{};
+    };
+
+    // A dense city cell has a few thousand references. While a cell is loaded other code allocates memory too, so
+    // list nodes are interleaved with unrelated allocations.
+    template <class List>
+    void fill(List& list, std::size_t count, std::vector<std::unique_ptr<std::byte[]>>& noise, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<std::size_t> noiseSize(16, 512);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Ref ref;
+            ref.mPosition[0] = static_cast<float>(i);
+            ref.mEnabled = i % 7 != 0;
+            list.push_back(ref);
+            noise.push_back(std::make_unique<std::byte[]>(noiseSize(random)));
+        }
+    }
+
+    template <class List>
+    void iterateRefs(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<std::unique_ptr<std::byte[]>> noise;
+        List list;
+        fill(list, state.range(0), noise, random);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            float sum = 0;
+            for (const Ref& ref : list)
+                if (ref.mEnabled && ref.mCount > 0)
+                    sum += ref.mPosition[0];
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <class List>
+    void loadAndUnloadRefs(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            std::vector<std::unique_ptr<std::byte[]>> noise;
+            List list;
+            fill(list, state.range(0), noise, random);
+            benchmark::DoNotOptimize(list);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    using StdList = std::list<Ref>;
+    using SegmentedList = Misc::SegmentedList<Ref>;
+}
+
+BENCHMARK_TEMPLATE(iterateRefs, StdList)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK_TEMPLATE(iterateRefs, SegmentedList)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK_TEMPLATE(loadAndUnloadRefs, StdList)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK_TEMPLATE(loadAndUnloadRefs, SegmentedList)->RangeMultiplier(4)->Range(256, 16384);
+
+BENCHMARK_MAIN();
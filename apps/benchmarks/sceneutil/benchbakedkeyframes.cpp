@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include "components/nifosg/controller.hpp"
+#include "components/sceneutil/bakedkeyframes.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Similar to a stock creature KF: a few dozen bones, linear rotation keys and Hermite translation keys at 15 keys
+    // per second, played at 60 frames per second.
+    constexpr std::size_t bonesCount = 40;
+    constexpr float duration = 120;
+    constexpr float keysPerSecond = 15;
+    constexpr float frameTime = 1.f / 60;
+    constexpr float bakingRate = 30;
+
+    class KeysTrack final : public SceneUtil::KeyframeController
+    {
+    public:
+        KeysTrack() = default;
+
+        KeysTrack(const KeysTrack& copy, const osg::CopyOp& copyop)
+            : osg::Object(copy, copyop)
+            , SceneUtil::KeyframeController(copy, copyop)
+            , mRotations(copy.mRotations)
+            , mTranslations(copy.mTranslations)
+        {
+        }
+
+        KeysTrack(std::shared_ptr<const Nif::QuaternionKeyMap> rotations,
+            std::shared_ptr<const Nif::Vector3KeyMap> translations)
+            : mRotations(std::move(rotations))
+            , mTranslations(std::move(translations))
+        {
+        }
+
+        META_Object(Benchmark, KeysTrack)
+
+        osg::Callback* getAsCallback() override { return nullptr; }
+
+        KfTransform getTransformation(float time) const override
+        {
+            KfTransform result;
+            result.mRotation = mRotations.interpKey(time);
+            result.mTranslation = mTranslations.interpKey(time);
+            return result;
+        }
+
+    private:
+        NifOsg::QuaternionInterpolator mRotations;
+        NifOsg::Vec3Interpolator mTranslations;
+    };
+
+    std::vector<osg::ref_ptr<KeysTrack>> generateTracks(std::minstd_rand& random)
+    {
+        std::uniform_real_distribution<float> coordinate(-50, 50);
+        std::uniform_real_distribution<float> angle(-osg::PI, osg::PI);
+        std::vector<osg::ref_ptr<KeysTrack>> result;
+        const std::size_t keysCount = static_cast<std::size_t>(duration * keysPerSecond) + 1;
+        for (std::size_t i = 0; i < bonesCount; ++i)
+        {
+            auto rotations = std::make_shared<Nif::QuaternionKeyMap>();
+            rotations->mInterpolationType = Nif::InterpolationType_Linear;
+            auto translations = std::make_shared<Nif::Vector3KeyMap>();
+            translations->mInterpolationType = Nif::InterpolationType_TCB;
+            for (std::size_t j = 0; j < keysCount; ++j)
+            {
+                const float time = j / keysPerSecond;
+                Nif::KeyT<osg::Quat> rotation;
+                rotation.mValue = osg::Quat(angle(random), osg::X_AXIS, angle(random), osg::Z_AXIS, 0, osg::Y_AXIS);
+                rotations->mKeys.emplace_back(time, rotation);
+                Nif::KeyT<osg::Vec3f> translation;
+                translation.mValue = osg::Vec3f(coordinate(random), coordinate(random), coordinate(random));
+                translation.mInTan = osg::Vec3f(coordinate(random), coordinate(random), coordinate(random));
+                translation.mOutTan = translation.mInTan;
+                translations->mKeys.emplace_back(time, translation);
+            }
+            result.push_back(new KeysTrack(std::move(rotations), std::move(translations)));
+        }
+        return result;
+    }
+
+    osg::ref_ptr<const SceneUtil::BakedKeyframes> bake(const std::vector<osg::ref_ptr<KeysTrack>>& tracks)
+    {
+        const std::vector<const SceneUtil::KeyframeController*> controllers(tracks.begin(), tracks.end());
+        return new SceneUtil::BakedKeyframes(controllers, 0, duration, bakingRate);
+    }
+
+    float advance(float time)
+    {
+        time += frameTime;
+        return time > duration ? 0 : time;
+    }
+
+    void sampleKeys(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<osg::ref_ptr<KeysTrack>> tracks = generateTracks(random);
+        float time = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (const osg::ref_ptr<KeysTrack>& track : tracks)
+                benchmark::DoNotOptimize(track->getTransformation(time));
+            time = advance(time);
+        }
+        state.SetItemsProcessed(state.iterations() * bonesCount);
+    }
+
+    void sampleBakedTracks(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const osg::ref_ptr<const SceneUtil::BakedKeyframes> baked = bake(generateTracks(random));
+        float time = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (std::size_t i = 0; i < bonesCount; ++i)
+                benchmark::DoNotOptimize(baked->sample(i, time));
+            time = advance(time);
+        }
+        state.SetItemsProcessed(state.iterations() * bonesCount);
+        state.counters["BakedBytes"] = static_cast<double>(baked->getMemorySize());
+    }
+}
+
+BENCHMARK(sampleKeys);
+BENCHMARK(sampleBakedTracks);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include "components/sceneutil/occlusionbuffer.hpp"
+
+#include <osg/BoundingBox>
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    // Hilly terrain of 32 x 32 cells with a chunk for every cell, like distant terrain around the player.
+    constexpr std::size_t chunksPerSide = 32;
+    constexpr std::size_t verticesPerSide = 17;
+    constexpr std::size_t occluderResolution = 4;
+    constexpr float chunkSize = 8192;
+    constexpr float objectsHeight = 1000;
+    constexpr float viewDistance = 8 * chunkSize;
+    constexpr std::size_t cameraPathSize = 16;
+
+    float getHeight(float x, float y)
+    {
+        return 3000 * std::sin(x * 0.00013f) * std::cos(y * 0.00011f) + 1500 * std::sin((x + y) * 0.00041f);
+    }
+
+    struct Chunk
+    {
+        osg::ref_ptr<SceneUtil::Occluder> mOccluder;
+        // Terrain and the objects standing on it.
+        osg::BoundingBox mBounds;
+    };
+
+    std::vector<Chunk> generateChunks()
+    {
+        std::vector<Chunk> chunks;
+        const float spacing = chunkSize / (verticesPerSide - 1);
+        for (std::size_t chunkY = 0; chunkY < chunksPerSide; ++chunkY)
+            for (std::size_t chunkX = 0; chunkX < chunksPerSide; ++chunkX)
+            {
+                Chunk& chunk = chunks.emplace_back();
+                std::vector<osg::Vec3f> positions;
+                for (std::size_t row = 0; row < verticesPerSide; ++row)
+                    for (std::size_t column = 0; column < verticesPerSide; ++column)
+                    {
+                        const float x = static_cast<float>(chunkX) * chunkSize + static_cast<float>(column) * spacing;
+                        const float y = static_cast<float>(chunkY) * chunkSize + static_cast<float>(row) * spacing;
+                        positions.emplace_back(x, y, getHeight(x, y));
+                        chunk.mBounds.expandBy(positions.back());
+                    }
+                chunk.mBounds._max.z() += objectsHeight;
+                chunk.mOccluder = SceneUtil::createHeightfieldOccluder(positions, verticesPerSide, occluderResolution);
+            }
+        return chunks;
+    }
+
+    struct Camera
+    {
+        osg::Vec3f mEye;
+        osg::Vec3f mDirection;
+        osg::Matrixf mViewProjection;
+    };
+
+    // Walk along the diagonal of the terrain at the height of a person looking ahead.
+    std::vector<Camera> generateCameraPath()
+    {
+        std::vector<Camera> cameras;
+        const osg::Matrixf projection = osg::Matrixf::perspective(60, 16.0 / 9.0, 1, viewDistance);
+        const float begin = 4 * chunkSize;
+        const float end = (chunksPerSide - 4) * chunkSize;
+        for (std::size_t i = 0; i < cameraPathSize; ++i)
+        {
+            const float position = begin + (end - begin) * static_cast<float>(i) / (cameraPathSize - 1);
+            Camera& camera = cameras.emplace_back();
+            camera.mEye = osg::Vec3f(position, position, getHeight(position, position) + 128);
+            camera.mDirection = osg::Vec3f(1, 1, -0.05f);
+            camera.mDirection.normalize();
+            camera.mViewProjection
+                = osg::Matrixf::lookAt(camera.mEye, camera.mEye + camera.mDirection, osg::Vec3f(0, 0, 1)) * projection;
+        }
+        return cameras;
+    }
+
+    // Coarse replacement for the frustum culling done before rasterizing occluders.
+    bool isInView(const Chunk& chunk, const Camera& camera)
+    {
+        const osg::Vec3f offset = chunk.mBounds.center() - camera.mEye;
+        const float radius = chunk.mBounds.radius();
+        return offset.length() < viewDistance + radius && offset * camera.mDirection > -radius;
+    }
+
+    void rasterize(SceneUtil::OcclusionBuffer& buffer, const std::vector<Chunk>& chunks, const Camera& camera)
+    {
+        buffer.clear();
+        for (const Chunk& chunk : chunks)
+            if (isInView(chunk, camera))
+                buffer.addOccluder(*chunk.mOccluder, camera.mViewProjection);
+        buffer.resolve();
+    }
+
+    void rasterizeOccluders(benchmark::State& state)
+    {
+        const std::vector<Chunk> chunks = generateChunks();
+        const std::vector<Camera> cameras = generateCameraPath();
+        const std::size_t width = static_cast<std::size_t>(state.range(0));
+        SceneUtil::OcclusionBuffer buffer(width, width / 2);
+        std::size_t triangles = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (const Camera& camera : cameras)
+            {
+                rasterize(buffer, chunks, camera);
+                triangles += buffer.getTriangleCount();
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * cameras.size());
+        state.counters["Triangles"] = benchmark::Counter(
+            static_cast<double>(triangles) / static_cast<double>(state.iterations() * cameras.size()));
+    }
+
+    void testOccludees(benchmark::State& state)
+    {
+        const std::vector<Chunk> chunks = generateChunks();
+        const std::vector<Camera> cameras = generateCameraPath();
+        const std::size_t width = static_cast<std::size_t>(state.range(0));
+        std::vector<SceneUtil::OcclusionBuffer> buffers(cameras.size(), SceneUtil::OcclusionBuffer(width, width / 2));
+        std::size_t visible = 0;
+        std::size_t occluded = 0;
+        for (std::size_t i = 0; i < cameras.size(); ++i)
+        {
+            rasterize(buffers[i], chunks, cameras[i]);
+            for (const Chunk& chunk : chunks)
+                if (isInView(chunk, cameras[i]))
+                {
+                    ++visible;
+                    if (buffers[i].isOccluded(chunk.mBounds, cameras[i].mViewProjection))
+                        ++occluded;
+                }
+        }
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (std::size_t i = 0; i < cameras.size(); ++i)
+                for (const Chunk& chunk : chunks)
+                    benchmark::DoNotOptimize(buffers[i].isOccluded(chunk.mBounds, cameras[i].mViewProjection));
+        }
+        state.SetItemsProcessed(state.iterations() * cameras.size() * chunks.size());
+        state.counters["Occluded"] = benchmark::Counter(static_cast<double>(occluded) / static_cast<double>(visible));
+    }
+}
+
+BENCHMARK(rasterizeOccluders)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(testOccludees)->Arg(128)->Arg(256)->Arg(512);
+
+BENCHMARK_MAIN();
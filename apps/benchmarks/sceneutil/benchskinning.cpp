@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+
+#include "components/sceneutil/skinning.hpp"
+
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // A detailed NPC mesh: vertices share influence sets with their neighbours, so there are a few hundred groups.
+    constexpr std::size_t verticesCount = 5000;
+    constexpr std::size_t bonesCount = 60;
+    constexpr std::size_t groupSize = 20;
+
+    struct Group
+    {
+        std::vector<std::size_t> mBones;
+        std::vector<float> mWeights;
+        std::vector<unsigned short> mVertices;
+    };
+
+    struct Mesh
+    {
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::vector<Group> mGroups;
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mNormals;
+    };
+
+    Mesh generateMesh(std::minstd_rand& random)
+    {
+        std::uniform_real_distribution<float> coordinate(-50, 50);
+        std::uniform_real_distribution<float> angle(0, osg::PI);
+        std::uniform_int_distribution<std::size_t> bone(0, bonesCount - 1);
+        std::uniform_int_distribution<std::size_t> influences(1, 4);
+        Mesh mesh;
+        for (std::size_t i = 0; i < bonesCount; ++i)
+            mesh.mBoneMatrices.push_back(osg::Matrixf::rotate(angle(random), osg::Vec3f(0, 0, 1))
+                * osg::Matrixf::translate(coordinate(random), coordinate(random), coordinate(random)));
+        for (std::size_t i = 0; i < verticesCount; ++i)
+        {
+            mesh.mPositions.emplace_back(coordinate(random), coordinate(random), coordinate(random));
+            mesh.mNormals.push_back(mesh.mPositions.back() / mesh.mPositions.back().length());
+        }
+        std::vector<unsigned short> order(verticesCount);
+        for (std::size_t i = 0; i < verticesCount; ++i)
+            order[i] = static_cast<unsigned short>(i);
+        std::shuffle(order.begin(), order.end(), random);
+        for (std::size_t i = 0; i < verticesCount; i += groupSize)
+        {
+            Group& group = mesh.mGroups.emplace_back();
+            const std::size_t count = influences(random);
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                group.mBones.push_back(bone(random));
+                group.mWeights.push_back(1.0f / count);
+            }
+            group.mVertices.assign(order.begin() + i, order.begin() + std::min(i + groupSize, verticesCount));
+        }
+        return mesh;
+    }
+
+    void skinScalar(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const Mesh mesh = generateMesh(random);
+        std::vector<osg::Vec3f> positions(verticesCount);
+        std::vector<osg::Vec3f> normals(verticesCount);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (const Group& group : mesh.mGroups)
+            {
+                osg::Matrixf matrix(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+                for (std::size_t i = 0; i < group.mBones.size(); ++i)
+                {
+                    const float* bonePtr = mesh.mBoneMatrices[group.mBones[i]].ptr();
+                    float* matrixPtr = matrix.ptr();
+                    for (int j = 0; j < 16; ++j, ++matrixPtr, ++bonePtr)
+                        if (j % 4 != 3)
+                            *matrixPtr += *bonePtr * group.mWeights[i];
+                }
+                for (unsigned short vertex : group.mVertices)
+                {
+                    positions[vertex] = matrix.preMult(mesh.mPositions[vertex]);
+                    normals[vertex] = osg::Matrixf::transform3x3(mesh.mNormals[vertex], matrix);
+                }
+            }
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::DoNotOptimize(normals.data());
+        }
+        state.SetItemsProcessed(state.iterations() * verticesCount);
+    }
+
+    void skinStreams(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const Mesh mesh = generateMesh(random);
+        std::array<std::vector<float>, 3> positionStreams;
+        std::array<std::vector<float>, 3> normalStreams;
+        for (const Group& group : mesh.mGroups)
+            for (unsigned short vertex : group.mVertices)
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    positionStreams[i].push_back(mesh.mPositions[vertex][i]);
+                    normalStreams[i].push_back(mesh.mNormals[vertex][i]);
+                }
+        std::vector<float> buffer(3 * groupSize);
+        const SceneUtil::SkinningStream skinned{ buffer.data(), buffer.data() + groupSize,
+            buffer.data() + 2 * groupSize };
+        std::vector<osg::Vec3f> positions(verticesCount);
+        std::vector<osg::Vec3f> normals(verticesCount);
+        const float* const boneMatrices = mesh.mBoneMatrices.front().ptr();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            std::size_t offset = 0;
+            for (const Group& group : mesh.mGroups)
+            {
+                osg::Matrixf matrix;
+                SceneUtil::blendSkinningMatrices(
+                    boneMatrices, group.mBones.data(), group.mWeights.data(), group.mBones.size(), matrix.ptr());
+                const std::size_t count = group.mVertices.size();
+                SceneUtil::skinPositions(matrix.ptr(),
+                    { positionStreams[0].data() + offset, positionStreams[1].data() + offset,
+                        positionStreams[2].data() + offset },
+                    count, skinned);
+                for (std::size_t i = 0; i < count; ++i)
+                    positions[group.mVertices[i]].set(skinned[0][i], skinned[1][i], skinned[2][i]);
+                SceneUtil::skinDirections(matrix.ptr(),
+                    { normalStreams[0].data() + offset, normalStreams[1].data() + offset,
+                        normalStreams[2].data() + offset },
+                    count, skinned);
+                for (std::size_t i = 0; i < count; ++i)
+                    normals[group.mVertices[i]].set(skinned[0][i], skinned[1][i], skinned[2][i]);
+                offset += count;
+            }
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::DoNotOptimize(normals.data());
+        }
+        state.SetItemsProcessed(state.iterations() * verticesCount);
+    }
+}
+
+BENCHMARK(skinScalar);
+BENCHMARK(skinStreams);
+
+BENCHMARK_MAIN();
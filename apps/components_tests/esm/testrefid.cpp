@@ -1,4 +1,5 @@
 #include <components/esm/refid.hpp>
+#include <components/esm/stringrefidtable.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/testing/expecterror.hpp>
@@ -78,6 +79,31 @@ namespace ESM
             EXPECT_NE(a, "foo");
         }
 
+        TEST(ESMRefIdTest, stringRefIdIndexShouldBeSameForCaseInsensitiveEqualValues)
+        {
+            EXPECT_EQ(StringRefId("Index_Id").getIndex(), StringRefId("index_id").getIndex());
+            EXPECT_NE(StringRefId("index_id_a").getIndex(), StringRefId("index_id_b").getIndex());
+            EXPECT_EQ(StringRefId().getIndex(), 0);
+        }
+
+        TEST(ESMRefIdTest, stringRefIdTableShouldReturnValueById)
+        {
+            StringRefIdTable<int> table;
+            const StringRefId a("table_id_a");
+            const StringRefId b("table_id_b");
+            EXPECT_EQ(table.get(a), 0);
+            table.set(a, 1);
+            table.set(b, 2);
+            EXPECT_EQ(table.get(StringRefId("TABLE_ID_A")), 1);
+            EXPECT_EQ(table.get(b), 2);
+            EXPECT_EQ(table.get(StringRefId("table_id_c")), 0);
+            table.erase(a);
+            EXPECT_EQ(table.get(a), 0);
+            EXPECT_EQ(table.get(b), 2);
+            table.clear();
+            EXPECT_EQ(table.get(b), 0);
+        }
+
         TEST(ESMRefIdTest, stringRefIdIsEqualToTheSameStringLiteralValue)
         {
             const RefId refId = RefId::stringRefId("ref_id");
@@ -0,0 +1,137 @@
+#include <components/files/compressedstream.hpp>
+#include <components/testing/util.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace Files;
+
+    std::string makeData(std::size_t size)
+    {
+        std::string result;
+        result.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result.push_back(static_cast<char>((i * 7 + i / 1000) % 251));
+        return result;
+    }
+
+    std::filesystem::path writeFile(std::string_view name, std::string_view data, bool compress)
+    {
+        const std::filesystem::path path = outputFilePath(name);
+        std::ofstream stream(path, std::ios::binary);
+        if (compress)
+            writeCompressedStream(stream, data);
+        else
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return path;
+    }
+
+    std::string readAll(std::istream& stream)
+    {
+        std::string result;
+        char buffer[4096];
+        while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+            result.append(buffer, static_cast<std::size_t>(stream.gcount()));
+        return result;
+    }
+
+    struct FilesCompressedStreamTest : TestWithParam<bool>
+    {
+    };
+
+    TEST_P(FilesCompressedStreamTest, shouldReadWrittenData)
+    {
+        const std::string data = makeData(3 * 1024 * 1024 + 123);
+        const auto path = writeFile("compressed_stream_read.bin", data, true);
+        EXPECT_LT(std::filesystem::file_size(path), data.size());
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, GetParam());
+        EXPECT_EQ(readAll(*stream), data);
+    }
+
+    TEST_P(FilesCompressedStreamTest, shouldReadEmptyData)
+    {
+        const auto path = writeFile("compressed_stream_empty.bin", {}, true);
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, GetParam());
+        EXPECT_EQ(readAll(*stream), "");
+    }
+
+    TEST_P(FilesCompressedStreamTest, shouldSupportForwardSeekAndTell)
+    {
+        const std::string data = makeData(3 * 1024 * 1024);
+        const auto path = writeFile("compressed_stream_seek.bin", data, true);
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, GetParam());
+
+        // Same as ESMReader does to find the size
+        stream->seekg(0, std::ios::end);
+        EXPECT_EQ(stream->tellg(), static_cast<std::streamoff>(data.size()));
+        stream->seekg(0, std::ios::beg);
+        EXPECT_EQ(stream->tellg(), 0);
+
+        char buffer[16];
+        stream->read(buffer, sizeof(buffer));
+        EXPECT_EQ(std::string_view(buffer, sizeof(buffer)), data.substr(0, sizeof(buffer)));
+        stream->seekg(10, std::ios::beg);
+        EXPECT_EQ(stream->get(), static_cast<unsigned char>(data[10]));
+
+        const std::size_t offset = 2 * 1024 * 1024 + 17;
+        stream->seekg(static_cast<std::streamoff>(offset - 11), std::ios::cur);
+        EXPECT_EQ(stream->tellg(), static_cast<std::streamoff>(offset));
+        stream->read(buffer, sizeof(buffer));
+        EXPECT_EQ(std::string_view(buffer, sizeof(buffer)), data.substr(offset, sizeof(buffer)));
+        EXPECT_EQ(stream->tellg(), static_cast<std::streamoff>(offset + sizeof(buffer)));
+
+        stream->seekg(0, std::ios::beg);
+        EXPECT_TRUE(stream->fail());
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Background, FilesCompressedStreamTest, Values(false, true));
+
+    TEST(FilesOpenMaybeCompressedFileStreamTest, shouldReadUncompressedFileAsIs)
+    {
+        const std::string data = makeData(1000);
+        const auto path = writeFile("compressed_stream_plain.bin", data, false);
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, true);
+        EXPECT_EQ(readAll(*stream), data);
+    }
+
+    TEST(FilesOpenMaybeCompressedFileStreamTest, shouldReadFileShorterThanHeaderAsIs)
+    {
+        const auto path = writeFile("compressed_stream_short.bin", "TES", false);
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, false);
+        EXPECT_EQ(readAll(*stream), "TES");
+    }
+
+    TEST(FilesOpenMaybeCompressedFileStreamTest, shouldFailOnTruncatedFile)
+    {
+        const std::string data = makeData(2 * 1024 * 1024);
+        const auto path = writeFile("compressed_stream_truncated.bin", data, true);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, true);
+        EXPECT_LT(readAll(*stream).size(), data.size());
+        EXPECT_TRUE(stream->bad());
+    }
+
+    TEST(FilesOpenMaybeCompressedFileStreamTest, shouldFailOnInvalidChunkSize)
+    {
+        std::string data = "OMWZ";
+        const std::uint32_t version = 1;
+        const std::uint64_t size = 1024;
+        const std::uint32_t chunkSize = 0xfffffff0;
+        data.append(reinterpret_cast<const char*>(&version), sizeof(version));
+        data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        data.append(reinterpret_cast<const char*>(&chunkSize), sizeof(chunkSize));
+        data.append(16, '\0');
+        const auto path = writeFile("compressed_stream_invalid_chunk.bin", data, false);
+        const IStreamPtr stream = openMaybeCompressedFileStream(path, false);
+        EXPECT_EQ(readAll(*stream), "");
+        EXPECT_TRUE(stream->bad());
+    }
+}
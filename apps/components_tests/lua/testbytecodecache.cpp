@@ -0,0 +1,131 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/bytecodecache.hpp>
+#include <components/lua/luastate.hpp>
+#include <components/testing/util.hpp>
+
+namespace
+{
+    using namespace testing;
+
+    constexpr VFS::Path::NormalizedView scriptPath("aaa/script.lua");
+
+    TestingOpenMW::VFSTestFile scriptFile("return { value = function() return 42 end }");
+
+    TestingOpenMW::VFSTestFile changedScriptFile("return { value = function() return 13 end }");
+
+    const LuaUtil::BytecodeCache::SourceHash hash{ 1, 2 };
+
+    TEST(LuaUtilBytecodeCacheTest, FindShouldReturnEntryWithMatchingHash)
+    {
+        LuaUtil::BytecodeCache cache("version");
+        cache.insert(scriptPath, hash, "bytecode");
+        ASSERT_NE(cache.find(scriptPath, hash), nullptr);
+        EXPECT_EQ(*cache.find(scriptPath, hash), "bytecode");
+        EXPECT_EQ(cache.find(scriptPath, { 1, 3 }), nullptr);
+        EXPECT_EQ(cache.find(VFS::Path::NormalizedView("other.lua"), hash), nullptr);
+    }
+
+    TEST(LuaUtilBytecodeCacheTest, SaveAndLoadShouldPreserveEntries)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("bytecode_cache_roundtrip.bin");
+        {
+            LuaUtil::BytecodeCache cache("version");
+            cache.insert(scriptPath, hash, std::string("byte\0code", 9));
+            EXPECT_TRUE(cache.isModified());
+            cache.save(path);
+            EXPECT_FALSE(cache.isModified());
+        }
+        LuaUtil::BytecodeCache cache("version");
+        cache.load(path);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_FALSE(cache.isModified());
+        ASSERT_NE(cache.find(scriptPath, hash), nullptr);
+        EXPECT_EQ(*cache.find(scriptPath, hash), std::string("byte\0code", 9));
+    }
+
+    TEST(LuaUtilBytecodeCacheTest, LoadShouldIgnoreCacheFromAnotherLuaVersion)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("bytecode_cache_version.bin");
+        {
+            LuaUtil::BytecodeCache cache("version");
+            cache.insert(scriptPath, hash, "bytecode");
+            cache.save(path);
+        }
+        LuaUtil::BytecodeCache cache("other version");
+        cache.load(path);
+        EXPECT_EQ(cache.size(), 0);
+        EXPECT_TRUE(cache.isModified());
+    }
+
+    TEST(LuaUtilBytecodeCacheTest, LoadShouldIgnoreCorruptedFile)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("bytecode_cache_corrupted.bin");
+        {
+            LuaUtil::BytecodeCache cache("version");
+            cache.insert(scriptPath, hash, "bytecode");
+            cache.save(path);
+        }
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+        LuaUtil::BytecodeCache cache("version");
+        cache.load(path);
+        EXPECT_EQ(cache.size(), 0);
+    }
+
+    TEST(LuaUtilBytecodeCacheTest, SaveShouldRemoveEntriesUnusedForSeveralSessions)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("bytecode_cache_unused.bin");
+        constexpr VFS::Path::NormalizedView usedPath("aaa/used.lua");
+        {
+            LuaUtil::BytecodeCache cache("version");
+            cache.insert(scriptPath, hash, "bytecode");
+            cache.insert(usedPath, hash, "bytecode");
+            cache.save(path);
+        }
+        for (std::uint32_t i = 0; i < LuaUtil::BytecodeCache::sMaxUnusedSessions; ++i)
+        {
+            LuaUtil::BytecodeCache cache("version");
+            cache.load(path);
+            EXPECT_EQ(cache.size(), 2);
+            EXPECT_NE(cache.find(usedPath, hash), nullptr);
+            cache.save(path);
+        }
+        LuaUtil::BytecodeCache cache("version");
+        cache.load(path);
+        EXPECT_NE(cache.find(usedPath, hash), nullptr);
+        cache.save(path);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_EQ(cache.find(scriptPath, hash), nullptr);
+        EXPECT_NE(cache.find(usedPath, hash), nullptr);
+    }
+
+    TEST(LuaUtilBytecodeCacheTest, LuaStateShouldReuseBytecodeOnlyForUnchangedSource)
+    {
+        const std::filesystem::path path = TestingOpenMW::outputFilePath("bytecode_cache_luastate.bin");
+        const VFS::Path::Normalized script(scriptPath);
+        LuaUtil::ScriptsConfiguration cfg;
+        {
+            auto vfs = TestingOpenMW::createTestVFS({ { scriptPath, &scriptFile } });
+            LuaUtil::LuaState lua(vfs.get(), &cfg);
+            lua.loadBytecodeCache(path);
+            sol::table result = lua.runInNewSandbox(script);
+            EXPECT_EQ(LuaUtil::call(result["value"]).get<int>(), 42);
+            lua.saveBytecodeCache();
+        }
+        {
+            auto vfs = TestingOpenMW::createTestVFS({ { scriptPath, &scriptFile } });
+            LuaUtil::LuaState lua(vfs.get(), &cfg);
+            lua.loadBytecodeCache(path);
+            sol::table result = lua.runInNewSandbox(script);
+            EXPECT_EQ(LuaUtil::call(result["value"]).get<int>(), 42);
+        }
+        {
+            auto vfs = TestingOpenMW::createTestVFS({ { scriptPath, &changedScriptFile } });
+            LuaUtil::LuaState lua(vfs.get(), &cfg);
+            lua.loadBytecodeCache(path);
+            sol::table result = lua.runInNewSandbox(script);
+            EXPECT_EQ(LuaUtil::call(result["value"]).get<int>(), 13);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/framebudget.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace std::chrono_literals;
+
+    TEST(LuaUtilFrameBudgetTest, ShouldNotLimitAnythingByDefault)
+    {
+        LuaUtil::FrameBudget budget;
+        budget.startFrame();
+        budget.addInstructions(0, 1000000000);
+        budget.addTime(1h);
+        EXPECT_FALSE(budget.isTimeLimited());
+        EXPECT_FALSE(budget.isTimeExhausted());
+        EXPECT_TRUE(budget.shouldUpdate(0, 0));
+        EXPECT_FALSE(budget.shouldDeferTimers());
+        budget.startFrame();
+        EXPECT_EQ(budget.getThrottle(0), 1);
+        EXPECT_TRUE(budget.shouldUpdate(0, 0));
+    }
+
+    TEST(LuaUtilFrameBudgetTest, ShouldDeferWorkWhenTimeBudgetIsSpent)
+    {
+        LuaUtil::FrameBudget budget({ .mTime = 2ms, .mMaxDeferredFrames = 3 });
+        budget.startFrame();
+        EXPECT_TRUE(budget.shouldUpdate(0, 0));
+        budget.addTime(3ms);
+        EXPECT_FALSE(budget.shouldUpdate(1, 0));
+        EXPECT_FALSE(budget.shouldUpdate(2, 2));
+        EXPECT_TRUE(budget.shouldUpdate(3, 3));
+        EXPECT_TRUE(budget.shouldDeferTimers());
+
+        budget.startFrame();
+        EXPECT_EQ(budget.getStats().mDeferredUpdates, 2);
+        EXPECT_EQ(budget.getStats().mDeferredTimerQueues, 1);
+        EXPECT_FALSE(budget.isTimeExhausted());
+        EXPECT_TRUE(budget.shouldUpdate(1, 1));
+        EXPECT_FALSE(budget.shouldDeferTimers());
+
+        budget.startFrame();
+        EXPECT_EQ(budget.getStats().mDeferredUpdates, 0);
+        EXPECT_EQ(budget.getStats().mDeferredTimerQueues, 0);
+    }
+
+    TEST(LuaUtilFrameBudgetTest, ShouldThrottleScriptExceedingInstructionBudget)
+    {
+        LuaUtil::FrameBudget budget({ .mInstructionsPerScript = 1000, .mMaxDeferredFrames = 8 });
+        budget.startFrame();
+        EXPECT_TRUE(budget.shouldUpdate(0, 0));
+        EXPECT_TRUE(budget.shouldUpdate(1, 0));
+        budget.addInstructions(0, 500);
+        budget.addInstructions(1, 2500);
+
+        std::vector<int> calls;
+        for (int frame = 0; frame < 6; ++frame)
+        {
+            budget.startFrame();
+            EXPECT_TRUE(budget.shouldUpdate(0, 0));
+            budget.addInstructions(0, 500);
+            if (budget.shouldUpdate(1, 0))
+            {
+                calls.push_back(frame);
+                budget.addInstructions(1, 2500);
+            }
+        }
+        EXPECT_EQ(budget.getThrottle(0), 1);
+        EXPECT_EQ(budget.getThrottle(1), 3);
+        EXPECT_EQ(budget.getStats().mThrottledScripts, 1);
+        EXPECT_THAT(calls, ElementsAre(0, 3));
+    }
+
+    TEST(LuaUtilFrameBudgetTest, ThrottleShouldBeLimitedByMaxDeferredFrames)
+    {
+        LuaUtil::FrameBudget budget({ .mInstructionsPerScript = 1000, .mMaxDeferredFrames = 2 });
+        budget.startFrame();
+        budget.addInstructions(0, 1000000);
+        budget.startFrame();
+        EXPECT_EQ(budget.getThrottle(0), 3);
+        EXPECT_TRUE(budget.shouldUpdate(0, 0));
+        budget.startFrame();
+        EXPECT_FALSE(budget.shouldUpdate(0, 0));
+        EXPECT_TRUE(budget.shouldUpdate(0, 2));
+    }
+}
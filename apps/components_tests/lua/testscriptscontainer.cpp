@@ -324,6 +324,32 @@ CUSTOM: customdata.lua
         }
     }
 
+    TEST_F(LuaScriptsContainerTest, CallEventWithValue)
+    {
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+
+        EXPECT_TRUE(scripts.addCustomScript(getId(test1Path)));
+        EXPECT_TRUE(scripts.addCustomScript(getId(stopEventPath)));
+        EXPECT_TRUE(scripts.addCustomScript(getId(test2Path)));
+
+        sol::state_view sol = mLua.unsafeState();
+        {
+            testing::internal::CaptureStdout();
+            scripts.receiveEventValue("Event1", sol.create_table_with("x", 1.5));
+            EXPECT_EQ(internal::GetCapturedStdout(),
+                "Test[test2.lua]:\t event1 1.5\n"
+                "Test[stopevent.lua]:\t event1 1.5\n"
+                "Test[test1.lua]:\t event1 1.5\n");
+        }
+        {
+            testing::internal::CaptureStdout();
+            scripts.receiveEventValue("Event1", sol.create_table_with("x", 0.5));
+            EXPECT_EQ(internal::GetCapturedStdout(),
+                "Test[test2.lua]:\t event1 0.5\n"
+                "Test[stopevent.lua]:\t event1 0.5\n");
+        }
+    }
+
     TEST_F(LuaScriptsContainerTest, RemoveScript)
     {
         LuaUtil::ScriptsContainer scripts(&mLua, "Test");
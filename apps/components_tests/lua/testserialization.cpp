@@ -253,6 +253,16 @@ namespace
             }
             return false;
         }
+
+        bool copy(const sol::userdata& data, lua_State* lua) const override
+        {
+            if (data.is<TestStruct1>())
+            {
+                sol::stack::push<TestStruct1>(lua, data.as<TestStruct1>());
+                return true;
+            }
+            return false;
+        }
     };
 
     TEST(LuaSerializationTest, UserdataSerializer)
@@ -276,4 +286,47 @@ namespace
         EXPECT_EQ(ry.b, 3);
     }
 
+    TEST(LuaSerializationTest, CopyShouldCreateIndependentTable)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        table["aa"] = 1;
+        table["ab"] = true;
+        table["nested"] = sol::table(lua, sol::create);
+        table["nested"]["bb"] = "something";
+        table[1] = osg::Vec3f(1, 2, 3);
+
+        sol::table copy = LuaUtil::copy(lua, table);
+        EXPECT_NE(copy, table);
+        EXPECT_NE(copy.get<sol::table>("nested"), table.get<sol::table>("nested"));
+        EXPECT_EQ(copy.get<int>("aa"), 1);
+        EXPECT_EQ(copy.get<bool>("ab"), true);
+        EXPECT_EQ(copy.get<sol::table>("nested").get<std::string>("bb"), "something");
+        EXPECT_EQ(copy.get<osg::Vec3f>(1), osg::Vec3f(1, 2, 3));
+
+        table["nested"]["bb"] = "changed";
+        EXPECT_EQ(copy.get<sol::table>("nested").get<std::string>("bb"), "something");
+    }
+
+    TEST(LuaSerializationTest, CopyShouldRejectWhatSerializeRejects)
+    {
+        sol::state lua;
+        EXPECT_EQ(LuaUtil::copy(lua, sol::nil), sol::nil);
+        EXPECT_ERROR(LuaUtil::copy(lua, lua.safe_script("return { f = function() end }").get<sol::object>()),
+            "Functions are not allowed to be serialized.");
+        EXPECT_ERROR(LuaUtil::copy(lua, lua.safe_script("local t = {} t.t = t return t").get<sol::object>()),
+            "Can not serialize more than 32 nested tables.");
+
+        sol::table table(lua, sol::create);
+        table["x"] = TestStruct1{ 1.5, 2.5 };
+        TestSerializer serializer;
+        EXPECT_ERROR(LuaUtil::copy(lua, table), "Value is not serializable.");
+        sol::table copy = LuaUtil::copy(lua, table, &serializer);
+        EXPECT_EQ(copy.get<TestStruct1>("x").b, 2.5);
+
+        table["y"] = TestStruct2{ 4, 3 };
+        EXPECT_ERROR(LuaUtil::copy(lua, table, &serializer), "Value is not serializable.");
+        EXPECT_EQ(lua_gettop(lua), 0);
+    }
+
 }
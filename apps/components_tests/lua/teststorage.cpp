@@ -125,4 +125,105 @@ namespace
         });
     }
 
+    TEST(LuaUtilStorageTest, IncrementalSaving)
+    {
+        LuaUtil::LuaState luaState{ nullptr, nullptr };
+        luaState.protectedCall([](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            LuaUtil::LuaStorage storage;
+            auto& lua = view.sol();
+            storage.setActive(true);
+
+            lua["a"] = storage.getMutableSection(lua, "a");
+            lua["b"] = storage.getMutableSection(lua, "b");
+            lua["c"] = storage.getMutableSection(lua, "c");
+            lua.safe_script("a:set('x', 1) a:set('y', 2) b:set('z', 3) c:set('v', 4)");
+
+            const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_incremental.bin";
+            std::filesystem::remove(tmpFile);
+            storage.save(lua, tmpFile);
+            const std::uintmax_t initialSize = std::filesystem::file_size(tmpFile);
+
+            lua.safe_script("a:set('x', 5) a:set('y', nil) b:reset({ w = 1 }) c:removeOnExit()");
+            storage.save(lua, tmpFile);
+            EXPECT_GT(std::filesystem::file_size(tmpFile), initialSize);
+            const std::uintmax_t appendedSize = std::filesystem::file_size(tmpFile);
+
+            storage.save(lua, tmpFile);
+            EXPECT_EQ(std::filesystem::file_size(tmpFile), appendedSize);
+
+            LuaUtil::LuaStorage storage2;
+            storage2.setActive(true);
+            storage2.load(lua, tmpFile);
+            lua["a"] = storage2.getMutableSection(lua, "a");
+            lua["b"] = storage2.getMutableSection(lua, "b");
+            lua["c"] = storage2.getMutableSection(lua, "c");
+            EXPECT_EQ(get<int>(lua, "a:get('x')"), 5);
+            EXPECT_TRUE(get<bool>(lua, "a:get('y') == nil"));
+            EXPECT_TRUE(get<bool>(lua, "b:get('z') == nil"));
+            EXPECT_EQ(get<int>(lua, "b:get('w')"), 1);
+            EXPECT_TRUE(get<bool>(lua, "c:get('v') == nil"));
+        });
+    }
+
+    TEST(LuaUtilStorageTest, Snapshot)
+    {
+        LuaUtil::LuaState luaState{ nullptr, nullptr };
+        luaState.protectedCall([](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            LuaUtil::LuaStorage storage;
+            auto& lua = view.sol();
+            storage.setActive(true);
+
+            sol::table callbackHiddenData(lua, sol::create);
+            callbackHiddenData[LuaUtil::ScriptsContainer::sScriptIdKey] = LuaUtil::ScriptId{};
+            LuaUtil::getAsyncPackageInitializer(
+                lua.lua_state(), []() { return 0.0; }, []() { return 0.0; })(callbackHiddenData);
+            lua["async"] = LuaUtil::AsyncPackageId{ nullptr, 0, callbackHiddenData };
+
+            lua["storage"] = LuaUtil::LuaStorage::initGlobalPackage(view, &storage);
+            lua["a"] = storage.getMutableSection(lua, "a");
+            lua["b"] = storage.getMutableSection(lua, "b");
+            lua["c"] = storage.getMutableSection(lua, "c");
+            lua["t"] = storage.getMutableSection(lua, "t");
+            lua.safe_script(R"(
+                a:set('x', 1)
+                b:setLifeTime(storage.LIFE_TIME.GameSession)
+                b:set('y', { 2, 3 })
+                t:removeOnExit()
+                t:set('z', 4)
+            )");
+
+            const LuaUtil::StorageSnapshot snapshot = storage.makeSnapshot();
+            EXPECT_EQ(snapshot.mSections.size(), 1);
+            EXPECT_TRUE(snapshot.mSections.contains("b"));
+
+            lua.safe_script(R"(
+                a:set('x', 5)
+                b:set('y', nil)
+                c:setLifeTime(storage.LIFE_TIME.GameSession)
+                c:set('v', 6)
+                t:set('z', 7)
+                callbackCalls = {}
+                for _, s in ipairs({ a, b, c, t }) do
+                    s:subscribe(async:callback(function(section, key)
+                        table.insert(callbackCalls, section .. '_' .. (key or '*'))
+                    end))
+                end
+            )");
+            storage.restoreSnapshot(snapshot);
+
+            // Persistent and temporary sections are not a part of the snapshot
+            EXPECT_EQ(get<int>(lua, "a:get('x')"), 5);
+            EXPECT_EQ(get<int>(lua, "b:get('y')[2]"), 3);
+            EXPECT_TRUE(get<bool>(lua, "c:get('v') == nil"));
+            EXPECT_EQ(get<int>(lua, "t:get('z')"), 7);
+            EXPECT_EQ(get<std::string>(lua, "table.concat(callbackCalls, ' ')"), "c_* b_*");
+
+            // The callbacks are not called if nothing has changed
+            lua.safe_script("callbackCalls = {}");
+            storage.restoreSnapshot(snapshot);
+            EXPECT_EQ(get<std::string>(lua, "table.concat(callbackCalls, ' ')"), "");
+        });
+    }
 }
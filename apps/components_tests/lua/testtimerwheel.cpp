@@ -0,0 +1,100 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/timerwheel.hpp>
+
+#include <random>
+#include <set>
+
+namespace
+{
+    using namespace testing;
+
+    std::vector<int> popAllDue(LuaUtil::TimerWheel<int>& wheel, double time)
+    {
+        std::vector<int> result;
+        wheel.advance(time);
+        while (wheel.hasDue(time))
+            result.push_back(wheel.popDue());
+        return result;
+    }
+
+    TEST(LuaUtilTimerWheelTest, ShouldReturnDueTimersInOrderOfTime)
+    {
+        LuaUtil::TimerWheel<int> wheel(16);
+        wheel.insert(3.0, 3);
+        wheel.insert(1.0, 1);
+        wheel.insert(1.01, 2);
+        wheel.insert(1e7, 5);
+        wheel.insert(100.0, 4);
+        EXPECT_EQ(wheel.size(), 5);
+        EXPECT_THAT(popAllDue(wheel, 0.5), IsEmpty());
+        EXPECT_THAT(popAllDue(wheel, 1.0), ElementsAre(1));
+        EXPECT_THAT(popAllDue(wheel, 5.0), ElementsAre(2, 3));
+        EXPECT_THAT(popAllDue(wheel, 1e6), ElementsAre(4));
+        EXPECT_THAT(popAllDue(wheel, 1e7), ElementsAre(5));
+        EXPECT_TRUE(wheel.empty());
+    }
+
+    TEST(LuaUtilTimerWheelTest, TimersWithEqualTimeShouldBeReturnedInOrderOfInsertion)
+    {
+        LuaUtil::TimerWheel<int> wheel(16);
+        for (int i = 0; i < 5; ++i)
+            wheel.insert(10.0, i);
+        EXPECT_THAT(popAllDue(wheel, 10.0), ElementsAre(0, 1, 2, 3, 4));
+    }
+
+    TEST(LuaUtilTimerWheelTest, TimerInsertedInThePastShouldBeDueImmediately)
+    {
+        LuaUtil::TimerWheel<int> wheel(16);
+        EXPECT_THAT(popAllDue(wheel, 100.0), IsEmpty());
+        wheel.insert(50.0, 1);
+        wheel.insert(100.01, 2);
+        EXPECT_THAT(popAllDue(wheel, 100.0), ElementsAre(1));
+        EXPECT_THAT(popAllDue(wheel, 100.02), ElementsAre(2));
+    }
+
+    TEST(LuaUtilTimerWheelTest, ForEachShouldVisitAllTimers)
+    {
+        LuaUtil::TimerWheel<int> wheel(16);
+        wheel.insert(1.0, 1);
+        wheel.insert(1e3, 2);
+        wheel.insert(1e9, 3);
+        wheel.advance(1.0);
+        std::vector<std::pair<double, int>> timers;
+        wheel.forEach([&](double time, int value) { timers.emplace_back(time, value); });
+        EXPECT_THAT(timers, UnorderedElementsAre(Pair(1.0, 1), Pair(1e3, 2), Pair(1e9, 3)));
+        wheel.clear();
+        EXPECT_TRUE(wheel.empty());
+        EXPECT_THAT(popAllDue(wheel, 1e10), IsEmpty());
+    }
+
+    TEST(LuaUtilTimerWheelTest, ShouldMatchSortedOrderForRandomTimers)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<double> delay(0, 1e6);
+        std::uniform_real_distribution<double> step(0, 1e3);
+        LuaUtil::TimerWheel<int> wheel(16);
+        std::set<std::pair<double, int>> expected;
+        double time = 0;
+        int id = 0;
+        while (id < 10000 || !expected.empty())
+        {
+            for (int i = 0; i < 10 && id < 10000; ++i, ++id)
+            {
+                const double timerTime = time + (id % 3 == 0 ? delay(random) / 1000 : delay(random)) - 10;
+                wheel.insert(timerTime, id);
+                expected.emplace(timerTime, id);
+            }
+            time += step(random);
+            std::vector<int> expectedDue;
+            while (!expected.empty() && expected.begin()->first <= time)
+            {
+                expectedDue.push_back(expected.begin()->second);
+                expected.erase(expected.begin());
+            }
+            ASSERT_EQ(popAllDue(wheel, time), expectedDue);
+            ASSERT_EQ(wheel.size(), expected.size());
+        }
+    }
+}
@@ -3,8 +3,10 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <stdexcept>
 
 namespace
 {
@@ -28,4 +30,20 @@ namespace
         const std::vector<std::byte> decompressed = decompress(compressed);
         EXPECT_EQ(decompressed, data);
     }
+
+    TEST(MiscCompressionTest, decompressShouldThrowWhenSizeIsGreaterThanMax)
+    {
+        const std::vector<std::byte> data(1024);
+        const std::vector<std::byte> compressed = compress(data);
+        EXPECT_EQ(decompress(compressed, data.size()), data);
+        EXPECT_THROW(decompress(compressed, data.size() - 1), std::runtime_error);
+    }
+
+    TEST(MiscCompressionTest, decompressShouldThrowWhenSizeCanNotBeProducedFromInput)
+    {
+        std::vector<std::byte> compressed(sizeof(std::uint64_t) + 1);
+        const std::uint64_t size = std::uint64_t{ 1 } << 40;
+        std::memcpy(compressed.data(), &size, sizeof(size));
+        EXPECT_THROW(decompress(compressed), std::runtime_error);
+    }
 }
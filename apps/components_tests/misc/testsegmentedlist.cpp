@@ -0,0 +1,149 @@
+#include <components/misc/segmentedlist.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    template <class T>
+    std::vector<T> toVector(const SegmentedList<T>& list)
+    {
+        return std::vector<T>(list.begin(), list.end());
+    }
+
+    TEST(MiscSegmentedListTest, ShouldKeepElementsInOrderOfInsertion)
+    {
+        SegmentedList<int> list;
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.begin(), list.end());
+        for (int i = 0; i < 100; ++i)
+            list.push_back(i);
+        EXPECT_EQ(list.size(), 100);
+        EXPECT_EQ(list.front(), 0);
+        EXPECT_EQ(list.back(), 99);
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_EQ(toVector(list), expected);
+    }
+
+    TEST(MiscSegmentedListTest, ShouldNotRelocateElements)
+    {
+        SegmentedList<int> list;
+        std::vector<const int*> addresses;
+        for (int i = 0; i < 1000; ++i)
+            addresses.push_back(&list.emplace_back(i));
+        for (int i = 0; i < 1000; ++i)
+            EXPECT_EQ(*addresses[i], i);
+        SegmentedList<int> moved = std::move(list);
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(&moved.front(), addresses.front());
+        EXPECT_EQ(&moved.back(), addresses.back());
+    }
+
+    TEST(MiscSegmentedListTest, ErasedElementsShouldBeSkipped)
+    {
+        SegmentedList<int> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        auto it = std::find(list.begin(), list.end(), 3);
+        it = list.erase(it);
+        EXPECT_EQ(*it, 4);
+        for (auto i = list.begin(); i != list.end();)
+            i = *i % 2 == 0 ? list.erase(i) : std::next(i);
+        EXPECT_THAT(toVector(list), ElementsAre(1, 5, 7, 9));
+        EXPECT_EQ(list.size(), 4);
+        EXPECT_EQ(*--list.end(), 9);
+        EXPECT_EQ(*std::prev(std::find(list.begin(), list.end(), 5)), 1);
+    }
+
+    TEST(MiscSegmentedListTest, ErasingLastElementsShouldAllowToReuseTheirSlots)
+    {
+        SegmentedList<int> list;
+        list.push_back(1);
+        list.push_back(2);
+        const int* const address = &list.back();
+        list.erase(std::prev(list.end()));
+        EXPECT_EQ(&list.emplace_back(3), address);
+        EXPECT_THAT(toVector(list), ElementsAre(1, 3));
+        list.erase(list.begin());
+        list.erase(list.begin());
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.begin(), list.end());
+        list.push_back(4);
+        EXPECT_THAT(toVector(list), ElementsAre(4));
+    }
+
+    TEST(MiscSegmentedListTest, ShouldDestroyElements)
+    {
+        auto value = std::make_shared<int>(42);
+        {
+            SegmentedList<std::shared_ptr<int>> list;
+            for (int i = 0; i < 10; ++i)
+                list.push_back(value);
+            list.erase(std::next(list.begin(), 5));
+            EXPECT_EQ(value.use_count(), 10);
+            SegmentedList<std::shared_ptr<int>> copy = list;
+            EXPECT_EQ(value.use_count(), 19);
+            copy.clear();
+            EXPECT_EQ(value.use_count(), 10);
+        }
+        EXPECT_EQ(value.use_count(), 1);
+    }
+
+    TEST(MiscSegmentedListTest, IteratorShouldBeConvertibleToConstIterator)
+    {
+        SegmentedList<int> list;
+        list.push_back(1);
+        SegmentedList<int>::const_iterator it = list.begin();
+        EXPECT_EQ(it, list.begin());
+        EXPECT_NE(it, list.end());
+        EXPECT_EQ(list.erase(it), list.end());
+    }
+
+    TEST(MiscSegmentedListTest, ReplacingElementsShouldKeepCapacityBounded)
+    {
+        SegmentedList<int> list;
+        for (int i = 0; i < 100; ++i)
+            list.push_back(i);
+        for (int i = 100; i < 100000; ++i)
+        {
+            list.erase(list.begin());
+            list.push_back(i);
+            ASSERT_LE(list.capacity(), 4 * list.size());
+        }
+        EXPECT_EQ(list.size(), 100);
+        EXPECT_EQ(list.front(), 99900);
+        EXPECT_EQ(list.back(), 99999);
+    }
+
+    TEST(MiscSegmentedListTest, ErasingAllElementsOfChunkShouldKeepOrder)
+    {
+        SegmentedList<int> list;
+        for (int i = 0; i < 30; ++i)
+            list.push_back(i);
+        for (auto it = list.begin(); it != list.end();)
+        {
+            if (*it >= 4 && *it < 12)
+                it = list.erase(it);
+            else
+                ++it;
+        }
+        std::vector<int> expected;
+        for (int i = 0; i < 30; ++i)
+            if (i < 4 || i >= 12)
+                expected.push_back(i);
+        EXPECT_EQ(toVector(list), expected);
+        EXPECT_EQ(list.back(), 29);
+        EXPECT_EQ(*std::prev(list.end(), 22), 0);
+        list.clear();
+        EXPECT_EQ(list.capacity(), 0);
+    }
+}
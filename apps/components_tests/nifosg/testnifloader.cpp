@@ -2,23 +2,29 @@
 
 #include <components/nif/node.hpp>
 #include <components/nif/property.hpp>
+#include <components/nif/data.hpp>
 #include <components/nifosg/nifloader.hpp>
 #include <components/resource/bgsmfilemanager.hpp>
 #include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/occlusionbuffer.hpp>
 #include <components/sceneutil/serialize.hpp>
 #include <components/vfs/manager.hpp>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <osg/Drawable>
+#include <osg/NodeVisitor>
 #include <osgDB/Registry>
 
 #include <array>
+#include <cstddef>
 #include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace
 {
@@ -112,6 +118,52 @@ osg::Group {
 )");
     }
 
+    struct CountDrawablesVisitor : osg::NodeVisitor
+    {
+        std::size_t mCount = 0;
+
+        CountDrawablesVisitor()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        {
+        }
+
+        void apply(osg::Drawable&) override { ++mCount; }
+    };
+
+    TEST_F(NifOsgLoaderTest, shouldLoadOccluderAsUserObjectOfRootInsteadOfDrawable)
+    {
+        Nif::NiTriShapeData data;
+        data.mRecordType = Nif::RC_NiTriShapeData;
+        data.mVertices = { osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), osg::Vec3f(1, 1, 0) };
+        data.mNumTriangles = 1;
+        data.mTriangles = { 0, 1, 2 };
+        Nif::NiTriShape shape;
+        init(shape);
+        shape.mName = "Occluder";
+        shape.mData = Nif::NiGeometryDataPtr(&data);
+        shape.mTransform.mTranslation = osg::Vec3f(0, 0, 1);
+        Nif::NiNode node;
+        init(node);
+        node.mRecordType = Nif::RC_NiNode;
+        node.mTransform.mTranslation = osg::Vec3f(1, 0, 0);
+        node.mChildren = Nif::NiAVObjectList{ Nif::NiAVObjectPtr(&shape) };
+        shape.mParents.push_back(&node);
+        Nif::NIFFile file(testNif);
+        file.mRoots.push_back(&node);
+        auto result = Loader::load(file, &mImageManager, &mMaterialManager);
+
+        std::vector<const SceneUtil::Occluder*> occluders;
+        SceneUtil::forEachOccluder(*result, [&](const SceneUtil::Occluder& v) { occluders.push_back(&v); });
+        ASSERT_EQ(occluders.size(), 1u);
+        EXPECT_EQ(occluders[0]->mVertices,
+            std::vector<osg::Vec3f>({ osg::Vec3f(1, 0, 1), osg::Vec3f(2, 0, 1), osg::Vec3f(2, 1, 1) }));
+        EXPECT_EQ(occluders[0]->mIndices, std::vector<unsigned short>({ 0, 1, 2 }));
+
+        CountDrawablesVisitor visitor;
+        result->accept(visitor);
+        EXPECT_EQ(visitor.mCount, 0u);
+    }
+
     std::string formatOsgNodeForBSShaderProperty(std::string_view shaderPrefix)
     {
         std::ostringstream oss;
@@ -0,0 +1,80 @@
+#include <components/sceneutil/bakedkeyframes.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    // Moves along a line and turns around z by one radian per second, has no scale.
+    class TestTrack final : public KeyframeController
+    {
+    public:
+        TestTrack() = default;
+
+        TestTrack(const TestTrack& copy, const osg::CopyOp& copyop)
+            : osg::Object(copy, copyop)
+            , KeyframeController(copy, copyop)
+        {
+        }
+
+        META_Object(SceneUtilTest, TestTrack)
+
+        osg::Callback* getAsCallback() override { return nullptr; }
+
+        KfTransform getTransformation(float time) const override
+        {
+            KfTransform result;
+            result.mTranslation = osg::Vec3f(time, 2 * time, 0);
+            result.mRotation = osg::Quat(time, osg::Z_AXIS);
+            return result;
+        }
+    };
+
+    struct SceneUtilBakedKeyframesTest : ::testing::Test
+    {
+        const osg::ref_ptr<TestTrack> mTrack{ new TestTrack };
+        const osg::ref_ptr<const BakedKeyframes> mBaked{ new BakedKeyframes({ mTrack.get(), mTrack.get() }, 1, 3, 10) };
+    };
+
+    TEST_F(SceneUtilBakedKeyframesTest, sampleShouldReturnTransformationAtSampleTime)
+    {
+        const KeyframeController::KfTransform result = mBaked->sample(1, 1.5f);
+        ASSERT_TRUE(result.mTranslation.has_value());
+        EXPECT_NEAR(result.mTranslation->x(), 1.5f, 1e-5f);
+        EXPECT_NEAR(result.mTranslation->y(), 3, 1e-5f);
+        ASSERT_TRUE(result.mRotation.has_value());
+        EXPECT_LT((result.mRotation->asVec4() - osg::Quat(1.5f, osg::Z_AXIS).asVec4()).length(), 1e-5f);
+    }
+
+    TEST_F(SceneUtilBakedKeyframesTest, sampleShouldInterpolateBetweenSamples)
+    {
+        const KeyframeController::KfTransform result = mBaked->sample(0, 2.025f);
+        ASSERT_TRUE(result.mTranslation.has_value());
+        EXPECT_NEAR(result.mTranslation->x(), 2.025f, 1e-5f);
+        ASSERT_TRUE(result.mRotation.has_value());
+        EXPECT_NEAR(result.mRotation->length(), 1, 1e-5f);
+        EXPECT_LT((result.mRotation->asVec4() - osg::Quat(2.025f, osg::Z_AXIS).asVec4()).length(), 1e-3f);
+    }
+
+    TEST_F(SceneUtilBakedKeyframesTest, sampleShouldNotReturnMissingChannels)
+    {
+        EXPECT_FALSE(mBaked->sample(0, 2).mScale.has_value());
+    }
+
+    TEST_F(SceneUtilBakedKeyframesTest, sampleShouldClampTimeToBakedRange)
+    {
+        EXPECT_FALSE(mBaked->contains(3.5f));
+        const KeyframeController::KfTransform result = mBaked->sample(0, 3.5f);
+        ASSERT_TRUE(result.mTranslation.has_value());
+        EXPECT_NEAR(result.mTranslation->x(), 3, 1e-5f);
+    }
+
+    TEST_F(SceneUtilBakedKeyframesTest, getMemorySizeShouldCountOnlyPresentChannels)
+    {
+        // 21 samples of 2 tracks with a translation and a rotation.
+        EXPECT_EQ(mBaked->getMemorySize(), 21 * 2 * 7 * sizeof(float));
+    }
+}
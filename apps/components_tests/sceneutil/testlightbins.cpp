@@ -0,0 +1,80 @@
+#include <components/sceneutil/lightbins.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilLightBinsTest, getCandidatesShouldReturnNothingWithoutLights)
+    {
+        LightBins bins;
+        bins.build({});
+        std::vector<std::size_t> candidates{ 42 };
+        bins.getCandidates(osg::BoundingSphere(osg::Vec3f(0, 0, 0), 1), candidates);
+        EXPECT_THAT(candidates, IsEmpty());
+    }
+
+    TEST(SceneUtilLightBinsTest, getCandidatesShouldReturnNothingForInvalidBound)
+    {
+        LightBins bins;
+        bins.build({ osg::BoundingSphere(osg::Vec3f(0, 0, 0), 1) });
+        std::vector<std::size_t> candidates;
+        bins.getCandidates(osg::BoundingSphere(), candidates);
+        EXPECT_THAT(candidates, IsEmpty());
+    }
+
+    TEST(SceneUtilLightBinsTest, getCandidatesShouldSkipLightsInOtherBins)
+    {
+        std::vector<osg::BoundingSphere> lights;
+        for (int i = 0; i < 16; ++i)
+            lights.emplace_back(osg::Vec3f(static_cast<float>(i) * 100, 0, 0), 10);
+        LightBins bins;
+        bins.build(lights);
+        std::vector<std::size_t> candidates;
+        bins.getCandidates(osg::BoundingSphere(osg::Vec3f(0, 0, 0), 1), candidates);
+        EXPECT_THAT(candidates, ElementsAre(0, 1));
+        bins.getCandidates(osg::BoundingSphere(osg::Vec3f(1500, 0, 0), 1), candidates);
+        EXPECT_THAT(candidates, ElementsAre(14, 15));
+    }
+
+    TEST(SceneUtilLightBinsTest, getCandidatesShouldReturnNothingOutsideOfLights)
+    {
+        LightBins bins;
+        bins.build({ osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10), osg::BoundingSphere(osg::Vec3f(100, 0, 0), 10) });
+        std::vector<std::size_t> candidates;
+        bins.getCandidates(osg::BoundingSphere(osg::Vec3f(0, 500, 0), 10), candidates);
+        EXPECT_THAT(candidates, IsEmpty());
+    }
+
+    TEST(SceneUtilLightBinsTest, getCandidatesShouldIncludeAllIntersectingLightsInAscendingOrder)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> coordinate(-2000, 2000);
+        std::uniform_real_distribution<float> radius(10, 500);
+        std::vector<osg::BoundingSphere> lights;
+        for (int i = 0; i < 100; ++i)
+            lights.emplace_back(osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)), radius(random));
+        LightBins bins;
+        bins.build(lights);
+        std::vector<std::size_t> candidates;
+        for (int i = 0; i < 100; ++i)
+        {
+            const osg::BoundingSphere bound(
+                osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)), radius(random));
+            bins.getCandidates(bound, candidates);
+            EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+            EXPECT_EQ(std::adjacent_find(candidates.begin(), candidates.end()), candidates.end());
+            for (std::size_t light = 0; light < lights.size(); ++light)
+                if (lights[light].intersects(bound))
+                    EXPECT_THAT(candidates, Contains(light)) << "bound " << i;
+        }
+    }
+}
@@ -0,0 +1,185 @@
+#include <components/sceneutil/occlusionbuffer.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    // Camera at the origin looking along the y-axis with z up.
+    osg::Matrixf makeViewProjection()
+    {
+        const osg::Matrixf view = osg::Matrixf::lookAt(osg::Vec3f(0, 0, 0), osg::Vec3f(0, 1, 0), osg::Vec3f(0, 0, 1));
+        return view * osg::Matrixf::perspective(90, 1, 1, 10000);
+    }
+
+    // Wall across the view at the given distance.
+    Occluder makeWall(float distance, float halfWidth, float bottom, float top)
+    {
+        Occluder wall;
+        wall.mVertices = { osg::Vec3f(-halfWidth, distance, bottom), osg::Vec3f(halfWidth, distance, bottom),
+            osg::Vec3f(halfWidth, distance, top), osg::Vec3f(-halfWidth, distance, top) };
+        wall.mIndices = { 0, 1, 2, 0, 2, 3 };
+        return wall;
+    }
+
+    osg::BoundingBox makeBox(const osg::Vec3f& center, float halfSize)
+    {
+        const osg::Vec3f extent(halfSize, halfSize, halfSize);
+        return osg::BoundingBox(center - extent, center + extent);
+    }
+
+    struct SceneUtilOcclusionBufferTest : Test
+    {
+        OcclusionBuffer mBuffer{ 64, 64 };
+        const osg::Matrixf mViewProjection = makeViewProjection();
+    };
+
+    TEST_F(SceneUtilOcclusionBufferTest, shouldRoundSizeUpToTiles)
+    {
+        const OcclusionBuffer buffer(60, 1);
+        EXPECT_EQ(buffer.getWidth(), 64);
+        EXPECT_EQ(buffer.getHeight(), OcclusionBuffer::sTileSize);
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnFalseWithoutOccluders)
+    {
+        mBuffer.resolve();
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, 0), 10), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnTrueForBoxBehindOccluder)
+    {
+        mBuffer.addOccluder(makeWall(100, 1000, -1000, 1000), mViewProjection);
+        mBuffer.resolve();
+        EXPECT_EQ(mBuffer.getTriangleCount(), 2);
+        EXPECT_TRUE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, 0), 10), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnFalseForBoxInFrontOfOccluder)
+    {
+        mBuffer.addOccluder(makeWall(1000, 1000, -1000, 1000), mViewProjection);
+        mBuffer.resolve();
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 100, 0), 10), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnFalseForBoxIntersectingOccluder)
+    {
+        mBuffer.addOccluder(makeWall(1000, 1000, -1000, 1000), mViewProjection);
+        mBuffer.resolve();
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, 0), 10), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnFalseForBoxPartiallyAboveOccluder)
+    {
+        mBuffer.addOccluder(makeWall(100, 1000, -1000, 0), mViewProjection);
+        mBuffer.resolve();
+        EXPECT_TRUE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, -500), 100), mViewProjection));
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, -50), 100), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnFalseForBoxCrossingNearPlane)
+    {
+        mBuffer.addOccluder(makeWall(100, 1000, -1000, 1000), mViewProjection);
+        mBuffer.resolve();
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 0, 0), 10), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, isOccludedShouldReturnFalseForInvalidBox)
+    {
+        mBuffer.addOccluder(makeWall(100, 1000, -1000, 1000), mViewProjection);
+        mBuffer.resolve();
+        EXPECT_FALSE(mBuffer.isOccluded(osg::BoundingBox(), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, addOccluderShouldClipTrianglesAtNearPlane)
+    {
+        // Floor from behind the camera to far ahead, below the eye.
+        Occluder floor;
+        floor.mVertices = { osg::Vec3f(-1000, -1000, -10), osg::Vec3f(1000, -1000, -10),
+            osg::Vec3f(1000, 5000, -10), osg::Vec3f(-1000, 5000, -10) };
+        floor.mIndices = { 0, 1, 2, 0, 2, 3 };
+        mBuffer.addOccluder(floor, mViewProjection);
+        mBuffer.resolve();
+        EXPECT_TRUE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, -100), 20), mViewProjection));
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, 100), 20), mViewProjection));
+    }
+
+    TEST_F(SceneUtilOcclusionBufferTest, clearShouldRemoveOccluders)
+    {
+        mBuffer.addOccluder(makeWall(100, 1000, -1000, 1000), mViewProjection);
+        mBuffer.resolve();
+        mBuffer.clear();
+        mBuffer.resolve();
+        EXPECT_EQ(mBuffer.getTriangleCount(), 0);
+        EXPECT_FALSE(mBuffer.isOccluded(makeBox(osg::Vec3f(0, 1000, 0), 10), mViewProjection));
+    }
+
+    std::vector<osg::Vec3f> makeHeightfield(std::size_t verticesPerSide, float spacing)
+    {
+        std::vector<osg::Vec3f> positions;
+        for (std::size_t row = 0; row < verticesPerSide; ++row)
+            for (std::size_t column = 0; column < verticesPerSide; ++column)
+            {
+                const float x = static_cast<float>(column) * spacing;
+                const float y = static_cast<float>(row) * spacing;
+                positions.emplace_back(x, y, 100 * std::sin(x * 0.01f) * std::cos(y * 0.02f));
+            }
+        return positions;
+    }
+
+    TEST(SceneUtilCreateHeightfieldOccluderTest, shouldReturnEmptyOccluderForTooFewVertices)
+    {
+        const std::vector<osg::Vec3f> positions(3);
+        const osg::ref_ptr<Occluder> occluder = createHeightfieldOccluder(positions, 2, 4);
+        EXPECT_THAT(occluder->mVertices, IsEmpty());
+        EXPECT_THAT(occluder->mIndices, IsEmpty());
+    }
+
+    TEST(SceneUtilCreateHeightfieldOccluderTest, shouldLimitResolutionToHeightfield)
+    {
+        const std::vector<osg::Vec3f> positions = makeHeightfield(3, 10);
+        const osg::ref_ptr<Occluder> occluder = createHeightfieldOccluder(positions, 3, 8);
+        EXPECT_EQ(occluder->mVertices.size(), 9);
+        EXPECT_EQ(occluder->mIndices.size(), 2 * 2 * 6);
+    }
+
+    TEST(SceneUtilCreateHeightfieldOccluderTest, shouldKeepCornersOfHeightfield)
+    {
+        const std::vector<osg::Vec3f> positions = makeHeightfield(65, 10);
+        const osg::ref_ptr<Occluder> occluder = createHeightfieldOccluder(positions, 65, 4);
+        ASSERT_EQ(occluder->mVertices.size(), 25);
+        EXPECT_FLOAT_EQ(occluder->mVertices.front().x(), positions.front().x());
+        EXPECT_FLOAT_EQ(occluder->mVertices.front().y(), positions.front().y());
+        EXPECT_FLOAT_EQ(occluder->mVertices.back().x(), positions.back().x());
+        EXPECT_FLOAT_EQ(occluder->mVertices.back().y(), positions.back().y());
+    }
+
+    TEST(SceneUtilCreateHeightfieldOccluderTest, shouldNotRiseAboveHeightfield)
+    {
+        const std::size_t verticesPerSide = 65;
+        const std::size_t resolution = 4;
+        const std::size_t step = (verticesPerSide - 1) / resolution;
+        const std::vector<osg::Vec3f> positions = makeHeightfield(verticesPerSide, 10);
+        const osg::ref_ptr<Occluder> occluder = createHeightfieldOccluder(positions, verticesPerSide, resolution);
+        ASSERT_EQ(occluder->mVertices.size(), (resolution + 1) * (resolution + 1));
+        // Every heightfield vertex is above the vertices of the occluder quad it lies in.
+        for (std::size_t row = 0; row < verticesPerSide; ++row)
+            for (std::size_t column = 0; column < verticesPerSide; ++column)
+            {
+                const std::size_t quadY = std::min(row / step, resolution - 1);
+                const std::size_t quadX = std::min(column / step, resolution - 1);
+                for (std::size_t y = quadY; y <= quadY + 1; ++y)
+                    for (std::size_t x = quadX; x <= quadX + 1; ++x)
+                        EXPECT_LE(occluder->mVertices[y * (resolution + 1) + x].z(),
+                            positions[row * verticesPerSide + column].z())
+                            << row << " " << column;
+            }
+    }
+}
@@ -0,0 +1,113 @@
+#include <components/sceneutil/skeleton.hpp>
+
+#include <osg/MatrixTransform>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    osg::ref_ptr<osg::MatrixTransform> makeBone(const std::string& name, const osg::Vec3f& translation)
+    {
+        osg::ref_ptr<osg::MatrixTransform> bone = new osg::MatrixTransform(osg::Matrix::translate(translation));
+        bone->setName(name);
+        return bone;
+    }
+
+    struct SceneUtilSkeletonTest : ::testing::Test
+    {
+        osg::ref_ptr<Skeleton> mSkeleton{ new Skeleton };
+        osg::ref_ptr<osg::MatrixTransform> mRoot = makeBone("Bip01", osg::Vec3f(1, 0, 0));
+        osg::ref_ptr<osg::MatrixTransform> mSpine = makeBone("Bip01 Spine", osg::Vec3f(0, 2, 0));
+        osg::ref_ptr<osg::MatrixTransform> mHead = makeBone("Bip01 Head", osg::Vec3f(0, 0, 3));
+
+        SceneUtilSkeletonTest()
+        {
+            mSkeleton->addChild(mRoot);
+            mRoot->addChild(mSpine);
+            mSpine->addChild(mHead);
+        }
+    };
+
+    TEST_F(SceneUtilSkeletonTest, getBoneShouldReturnNoBoneForMissingName)
+    {
+        EXPECT_EQ(mSkeleton->getBone("Bip01 Tail"), Skeleton::sNoBone);
+    }
+
+    TEST_F(SceneUtilSkeletonTest, getBoneShouldIgnoreCase)
+    {
+        EXPECT_EQ(mSkeleton->getBone("bip01 head"), mSkeleton->getBone("BIP01 HEAD"));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, getBoneShouldAddParentsBeforeChild)
+    {
+        const std::size_t head = mSkeleton->getBone("Bip01 Head");
+        EXPECT_LT(mSkeleton->getBone("Bip01"), head);
+        EXPECT_LT(mSkeleton->getBone("Bip01 Spine"), head);
+    }
+
+    TEST_F(SceneUtilSkeletonTest, updateBoneMatricesShouldComputeSkeletonSpaceMatrices)
+    {
+        const std::size_t head = mSkeleton->getBone("Bip01 Head");
+        mSkeleton->updateBoneMatrices(1);
+        EXPECT_EQ(mSkeleton->getBoneMatrix(head).getTrans(), osg::Vec3f(1, 2, 3));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, bonesShouldKeepIndicesWhenSkeletonChanges)
+    {
+        const std::size_t head = mSkeleton->getBone("Bip01 Head");
+        mSkeleton->addChild(makeBone("Bip01 Tail", osg::Vec3f(0, 0, 0)));
+        EXPECT_EQ(mSkeleton->getBone("Bip01 Head"), head);
+        EXPECT_NE(mSkeleton->getBone("Bip01 Tail"), Skeleton::sNoBone);
+    }
+
+    struct SceneUtilSkeletonLodTest : SceneUtilSkeletonTest
+    {
+        // Skeletons are never culled here, so their screen size stays 0 and below the reduced rate size.
+        SceneUtilSkeletonLodTest() { Skeleton::setLodScreenSizes({ 100, 0, 0 }); }
+
+        ~SceneUtilSkeletonLodTest() override { Skeleton::setLodScreenSizes({ 0, 0, 0 }); }
+
+        void update(unsigned int frameNumber)
+        {
+            osg::NodeVisitor visitor(osg::NodeVisitor::UPDATE_VISITOR, osg::NodeVisitor::TRAVERSE_ALL_CHILDREN);
+            visitor.setTraversalNumber(frameNumber);
+            mSkeleton->accept(visitor);
+            mSkeleton->updateBoneMatrices(frameNumber);
+        }
+    };
+
+    TEST_F(SceneUtilSkeletonLodTest, reducedRateShouldKeepPoseOfSkippedFrameWithoutPreviousUpdate)
+    {
+        update(1);
+        update(2);
+        EXPECT_EQ(mSkeleton->getLod(), Skeleton::Lod::ReducedRate);
+        EXPECT_TRUE(mSkeleton->isPoseUnchanged(2));
+        EXPECT_EQ(mRoot->getMatrix().getTrans(), osg::Vec3d(1, 0, 0));
+    }
+
+    TEST_F(SceneUtilSkeletonLodTest, reducedRateShouldExtrapolatePoseOfSkippedFrame)
+    {
+        const std::size_t head = mSkeleton->getBone("Bip01 Head");
+        update(1);
+        update(2);
+        mRoot->setMatrix(osg::Matrix::translate(3, 0, 0));
+        update(3);
+        update(4);
+        EXPECT_FALSE(mSkeleton->isPoseUnchanged(4));
+        EXPECT_EQ(mRoot->getMatrix().getTrans(), osg::Vec3d(4, 0, 0));
+        EXPECT_EQ(mSkeleton->getBoneMatrix(head).getTrans(), osg::Vec3f(4, 2, 3));
+    }
+
+    TEST_F(SceneUtilSkeletonLodTest, reducedRateShouldRestoreUpdatedPoseBeforeNextUpdate)
+    {
+        update(1);
+        update(2);
+        mRoot->setMatrix(osg::Matrix::translate(3, 0, 0));
+        update(3);
+        update(4);
+        update(5);
+        EXPECT_EQ(mRoot->getMatrix().getTrans(), osg::Vec3d(3, 0, 0));
+    }
+}
@@ -0,0 +1,61 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    // Rotation by 90 degrees around z followed by translation (10, 20, 30).
+    constexpr std::array<float, 16> rotateAndTranslate{ 0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 10, 20, 30, 1 };
+
+    TEST(SceneUtilSkinningTest, skinPositionsShouldApplyRotationAndTranslation)
+    {
+        const std::array<float, 3> x{ 1, 0, 0 };
+        const std::array<float, 3> y{ 0, 1, 0 };
+        const std::array<float, 3> z{ 0, 0, 1 };
+        std::array<float, 3> resultX{};
+        std::array<float, 3> resultY{};
+        std::array<float, 3> resultZ{};
+        skinPositions(rotateAndTranslate.data(), { x.data(), y.data(), z.data() }, 3,
+            { resultX.data(), resultY.data(), resultZ.data() });
+        EXPECT_THAT(resultX, ElementsAre(10, 9, 10));
+        EXPECT_THAT(resultY, ElementsAre(21, 20, 20));
+        EXPECT_THAT(resultZ, ElementsAre(30, 30, 31));
+    }
+
+    TEST(SceneUtilSkinningTest, skinDirectionsShouldIgnoreTranslation)
+    {
+        const std::array<float, 2> x{ 1, 0 };
+        const std::array<float, 2> y{ 0, 1 };
+        const std::array<float, 2> z{ 0, 0 };
+        std::array<float, 2> resultX{};
+        std::array<float, 2> resultY{};
+        std::array<float, 2> resultZ{};
+        skinDirections(rotateAndTranslate.data(), { x.data(), y.data(), z.data() }, 2,
+            { resultX.data(), resultY.data(), resultZ.data() });
+        EXPECT_THAT(resultX, ElementsAre(0, -1));
+        EXPECT_THAT(resultY, ElementsAre(1, 0));
+        EXPECT_THAT(resultZ, ElementsAre(0, 0));
+    }
+
+    TEST(SceneUtilSkinningTest, blendSkinningMatricesShouldSumWeightedMatricesWithAffineLastColumn)
+    {
+        std::array<float, 32> matrices{};
+        matrices.fill(1);
+        for (std::size_t i = 16; i < 32; ++i)
+            matrices[i] = 3;
+        const std::array<std::size_t, 2> indices{ 1, 0 };
+        const std::array<float, 2> weights{ 0.25f, 0.5f };
+        std::array<float, 16> result{};
+        blendSkinningMatrices(matrices.data(), indices.data(), weights.data(), 2, result.data());
+        EXPECT_THAT(result,
+            ElementsAre(1.25f, 1.25f, 1.25f, 0, 1.25f, 1.25f, 1.25f, 0, 1.25f, 1.25f, 1.25f, 0,
+                1.25f, 1.25f, 1.25f, 1));
+    }
+}
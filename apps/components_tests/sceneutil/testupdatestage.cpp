@@ -0,0 +1,133 @@
+#include <components/sceneutil/updatestage.hpp>
+
+#include <osg/BoundingBox>
+#include <osg/Drawable>
+#include <osg/observer_ptr>
+#include <osgParticle/ParticleSystem>
+#include <osgUtil/UpdateVisitor>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct CountingParticleSystem : osgParticle::ParticleSystem
+    {
+        std::atomic<int> mUpdates{ 0 };
+        double mDt = 0;
+
+        static void countUpdate(osgParticle::ParticleSystem& system, double dt)
+        {
+            CountingParticleSystem& self = static_cast<CountingParticleSystem&>(system);
+            ++self.mUpdates;
+            self.mDt = dt;
+        }
+    };
+
+    struct CountingComputeBoundingBox : osg::Drawable::ComputeBoundingBoxCallback
+    {
+        mutable int mCalls = 0;
+
+        osg::BoundingBox computeBound(const osg::Drawable&) const override
+        {
+            ++mCalls;
+            return osg::BoundingBox();
+        }
+    };
+
+    std::vector<osg::ref_ptr<CountingParticleSystem>> makeParticleSystems(std::size_t count)
+    {
+        std::vector<osg::ref_ptr<CountingParticleSystem>> result;
+        for (std::size_t i = 0; i < count; ++i)
+            result.emplace_back(new CountingParticleSystem);
+        return result;
+    }
+
+    TEST(SceneUtilUpdateStageTest, shouldBeAvailableOnlyThroughUpdateStageVisitor)
+    {
+        osg::ref_ptr<UpdateStage> stage = new UpdateStage(0);
+        UpdateStageVisitor stageVisitor(*stage);
+        osgUtil::UpdateVisitor otherVisitor;
+        EXPECT_EQ(UpdateStage::get(stageVisitor), stage.get());
+        EXPECT_EQ(UpdateStage::get(otherVisitor), nullptr);
+    }
+
+    TEST(SceneUtilUpdateStageTest, shouldUpdateEveryScheduledParticleSystemOnceWithWorkerThreads)
+    {
+        osg::ref_ptr<UpdateStage> stage = new UpdateStage(3);
+        UpdateStageVisitor visitor(*stage);
+        const auto systems = makeParticleSystems(100);
+        for (const auto& system : systems)
+            stage->add(*system, 0.5, &CountingParticleSystem::countUpdate);
+        stage->run(visitor);
+        EXPECT_EQ(stage->getLastParticleSystemCount(), systems.size());
+        for (const auto& system : systems)
+        {
+            EXPECT_EQ(system->mUpdates, 1);
+            EXPECT_EQ(system->mDt, 0.5);
+        }
+    }
+
+    TEST(SceneUtilUpdateStageTest, shouldUpdateParticleSystemsWithoutWorkerThreads)
+    {
+        osg::ref_ptr<UpdateStage> stage = new UpdateStage(0);
+        UpdateStageVisitor visitor(*stage);
+        const auto systems = makeParticleSystems(3);
+        for (const auto& system : systems)
+            stage->add(*system, 0.25, &CountingParticleSystem::countUpdate);
+        stage->run(visitor);
+        for (const auto& system : systems)
+            EXPECT_EQ(system->mUpdates, 1);
+    }
+
+    TEST(SceneUtilUpdateStageTest, shouldClearScheduleAfterRun)
+    {
+        osg::ref_ptr<UpdateStage> stage = new UpdateStage(2);
+        UpdateStageVisitor visitor(*stage);
+        const auto systems = makeParticleSystems(10);
+        for (const auto& system : systems)
+            stage->add(*system, 0.5, &CountingParticleSystem::countUpdate);
+        stage->run(visitor);
+        stage->run(visitor);
+        EXPECT_EQ(stage->getLastParticleSystemCount(), 0);
+        for (const auto& system : systems)
+            EXPECT_EQ(system->mUpdates, 1);
+    }
+
+    TEST(SceneUtilUpdateStageTest, shouldKeepScheduledParticleSystemAlive)
+    {
+        osg::ref_ptr<UpdateStage> stage = new UpdateStage(1);
+        UpdateStageVisitor visitor(*stage);
+        osg::observer_ptr<CountingParticleSystem> observer;
+        {
+            osg::ref_ptr<CountingParticleSystem> system = new CountingParticleSystem;
+            observer = system;
+            stage->add(*system, 0.5, &CountingParticleSystem::countUpdate);
+        }
+        EXPECT_TRUE(observer.valid());
+        stage->run(visitor);
+        EXPECT_FALSE(observer.valid());
+    }
+
+    TEST(SceneUtilUpdateStageTest, shouldDirtyParticleSystemBoundAfterRun)
+    {
+        osg::ref_ptr<UpdateStage> stage = new UpdateStage(1);
+        UpdateStageVisitor visitor(*stage);
+        osg::ref_ptr<CountingParticleSystem> system = new CountingParticleSystem;
+        osg::ref_ptr<CountingComputeBoundingBox> callback = new CountingComputeBoundingBox;
+        system->setComputeBoundingBoxCallback(callback);
+        system->getBoundingBox();
+        EXPECT_EQ(callback->mCalls, 1);
+        stage->add(*system, 0.5, &CountingParticleSystem::countUpdate);
+        stage->run(visitor);
+        system->getBoundingBox();
+        EXPECT_EQ(callback->mCalls, 2);
+    }
+}
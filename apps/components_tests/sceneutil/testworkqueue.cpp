@@ -0,0 +1,78 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilRunInParallelTest, shouldCallFunctionForEveryIndexWithoutWorkQueue)
+    {
+        std::vector<int> calls(10, 0);
+        runInParallel(nullptr, calls.size(), [&](std::size_t index) { ++calls[index]; });
+        EXPECT_THAT(calls, Each(1));
+    }
+
+    TEST(SceneUtilRunInParallelTest, shouldCallFunctionForEveryIndexOnce)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(3);
+        std::vector<std::atomic<int>> calls(1000);
+        runInParallel(workQueue, calls.size(), [&](std::size_t index) { ++calls[index]; });
+        for (std::size_t i = 0; i < calls.size(); ++i)
+            EXPECT_EQ(calls[i], 1) << i;
+    }
+
+    TEST(SceneUtilRunInParallelTest, shouldDoNothingForZeroCount)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+        bool called = false;
+        runInParallel(workQueue, 0, [&](std::size_t) { called = true; });
+        EXPECT_FALSE(called);
+    }
+
+    TEST(SceneUtilRunInParallelTest, shouldRethrowExceptionAfterAllCalls)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(2);
+        std::atomic<std::size_t> calls{ 0 };
+        EXPECT_THROW(runInParallel(workQueue, 100,
+                         [&](std::size_t index) {
+                             ++calls;
+                             if (index == 42)
+                                 throw std::runtime_error("error");
+                         }),
+            std::runtime_error);
+        EXPECT_EQ(calls, 100);
+    }
+
+    struct NestedRunItem : WorkItem
+    {
+        WorkQueue& mWorkQueue;
+        std::atomic<std::size_t> mCalls{ 0 };
+
+        explicit NestedRunItem(WorkQueue& workQueue)
+            : mWorkQueue(workQueue)
+        {
+        }
+
+        void doWork() override
+        {
+            runInParallel(&mWorkQueue, 100, [&](std::size_t) { ++mCalls; });
+        }
+    };
+
+    TEST(SceneUtilRunInParallelTest, shouldNotDeadlockWhenCalledFromWorkItemOfSameQueue)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+        osg::ref_ptr<NestedRunItem> item = new NestedRunItem(*workQueue);
+        workQueue->addWorkItem(item);
+        item->waitTillDone();
+        EXPECT_EQ(item->mCalls, 100);
+    }
+}
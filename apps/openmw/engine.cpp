@@ -24,6 +24,7 @@
 #include <components/sdlutil/imagetosurface.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
+#include <components/resource/keyframemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
@@ -339,6 +340,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
+        mSoundManager->reportStats(frameNumber, *stats);
 
         stats->setAttribute(frameNumber, "StringRefId Count", static_cast<double>(ESM::StringRefId::totalCount()));
     }
@@ -756,6 +758,7 @@ void OMW::Engine::prepareEngine()
     mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
         Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap,
         static_cast<float>(Settings::general().mAnisotropy));
+    mResourceSystem->getKeyframeManager()->setBakingRate(Settings::game().mAnimationBakingRate);
     mEnvironment.setResourceSystem(*mResourceSystem);
 
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
@@ -889,7 +892,7 @@ void OMW::Engine::prepareEngine()
     mEnvironment.setDialogueManager(*mDialogueManager);
 
     mLuaManager->loadPermanentStorage(mCfgMgr.getUserConfigPath());
-    mLuaManager->initPreLoad();
+    mLuaManager->initPreLoad(mCfgMgr.getCachePath());
 
     Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
     Loading::AsyncListener asyncListener(*listener);
@@ -1085,6 +1088,7 @@ void OMW::Engine::go()
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
     Settings::ShaderManager::get().save();
     mLuaManager->savePermanentStorage(mCfgMgr.getUserConfigPath());
+    mLuaManager->saveBytecodeCache();
 }
 
 void OMW::Engine::setCompileAll(bool all)
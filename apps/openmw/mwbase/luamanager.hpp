@@ -45,6 +45,7 @@ namespace LuaUtil
     {
         class Registry;
     }
+    struct StorageSnapshot;
 }
 
 namespace osg
@@ -109,6 +110,13 @@ namespace MWBase
         virtual void uiModeChanged(const MWWorld::Ptr& arg) = 0;
         virtual void viewportResized(int width, int height) = 0;
         virtual void savePermanentStorage(const std::filesystem::path& userConfigPath) = 0;
+
+        // Lua storage is not a part of saved games, so in-memory snapshots of the game state copy the GameSession
+        // sections separately. Persistent sections are left as they are.
+        virtual void makeStorageSnapshot(LuaUtil::StorageSnapshot& global, LuaUtil::StorageSnapshot& player) const = 0;
+        virtual void restoreStorageSnapshot(
+            const LuaUtil::StorageSnapshot& global, const LuaUtil::StorageSnapshot& player)
+            = 0;
         virtual void applyMagicEffects(ESM::RefId id, const MWWorld::Ptr& caster, ESM::RefNum item,
             const MWWorld::Ptr& target, const std::vector<int>& effects, bool ignoreReflect, bool ignoreSpellAbsorption,
             bool stackable, bool isReflect)
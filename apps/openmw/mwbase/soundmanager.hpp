@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -11,6 +12,11 @@
 #include "../mwsound/type.hpp"
 #include "../mwworld/ptr.hpp"
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWWorld
 {
     class CellStore;
@@ -221,6 +227,9 @@ namespace MWBase
         ///< Is the given sound currently playing on the given object?
         ///  If you want to check if sound played with playSound is playing, use empty Ptr
 
+        virtual void preloadSounds(std::span<const ESM::RefId> soundIds) = 0;
+        ///< Start decoding the given sounds in background, so they are ready before they are played.
+
         virtual void pauseSounds(MWSound::BlockerType blocker, int types = int(Type::Mask)) = 0;
         ///< Pauses all currently playing sounds, including music.
 
@@ -242,6 +251,8 @@ namespace MWBase
         float getSimulationTimeScale() const { return mSimulationTimeScale; }
 
         virtual void clear() = 0;
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
     };
 }
 
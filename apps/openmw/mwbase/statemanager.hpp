@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <list>
 #include <string>
+#include <string_view>
 
 namespace MWState
 {
@@ -71,6 +72,24 @@ namespace MWBase
         virtual void loadGame(const MWState::Character* character, const std::filesystem::path& filepath) = 0;
         ///< Load a saved game file belonging to the given character.
 
+        virtual void saveSnapshot(std::string_view name) = 0;
+        ///< Write the state of the running game into memory, replacing the snapshot with the same name.
+        ///
+        /// \note A snapshot is an in-memory saved game: it skips the disk, the compression and the screenshot, but
+        /// restoring it reloads the world like loading a saved game does. Unlike saved games, snapshots also
+        /// include the GameSession sections of Lua global and player storage.
+
+        virtual void requestRestoreSnapshot(std::string_view name) = 0;
+
+        virtual void restoreSnapshot(std::string_view name) = 0;
+        ///< Replace the state of the game by the snapshot, doesn't change the current character.
+        ///
+        /// \note The game is cleaned up and the world is rebuilt from the snapshot, the running world isn't reused.
+
+        virtual bool hasSnapshot(std::string_view name) const = 0;
+
+        virtual void deleteSnapshot(std::string_view name) = 0;
+
         /// Simple saver, writes over the file if already existing
         /** Used for quick save and autosave **/
         virtual void quickSave(std::string = "Quicksave") = 0;
@@ -212,6 +212,25 @@ namespace MWClass
         }
     }
 
+    void Creature::getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const
+    {
+        const MWWorld::LiveCellRef<ESM::Creature>* ref = ptr.get<ESM::Creature>();
+        const ESM::RefId& ourId = (ref->mBase->mOriginal.empty()) ? ptr.getCellRef().getRefId() : ref->mBase->mOriginal;
+
+        // Same lookup as getSoundIdFromSndGen, except the fallback to creatures with the same model
+        const std::size_t begin = sounds.size();
+        const MWWorld::Store<ESM::SoundGenerator>& store
+            = MWBase::Environment::get().getESMStore()->get<ESM::SoundGenerator>();
+        for (const ESM::SoundGenerator& sound : store)
+            if (!sound.mCreature.empty() && ourId == sound.mCreature)
+                sounds.push_back(sound.mSound);
+        if (sounds.size() != begin)
+            return;
+        for (const ESM::SoundGenerator& sound : store)
+            if (sound.mCreature.empty())
+                sounds.push_back(sound.mSound);
+    }
+
     std::string_view Creature::getName(const MWWorld::ConstPtr& ptr) const
     {
         return getNameOrId<ESM::Creature>(ptr);
@@ -114,6 +114,9 @@ namespace MWClass
         ///< Get a list of models to preload that this object may use (directly or indirectly). default implementation:
         ///< list getModel().
 
+        void getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const override;
+        ///< Get a list of sounds to preload that this object may play on its own. default implementation: none.
+
         bool isBipedal(const MWWorld::ConstPtr& ptr) const override;
         bool canFly(const MWWorld::ConstPtr& ptr) const override;
         bool canSwim(const MWWorld::ConstPtr& ptr) const override;
@@ -532,6 +532,16 @@ namespace MWClass
         }
     }
 
+    void Npc::getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const
+    {
+        // Footsteps are shared by all NPCs, the equipped boots decide which ones are played
+        sounds.insert(sounds.end(),
+            { npcParts.mFootBareLeft, npcParts.mFootBareRight, npcParts.mFootLightLeft, npcParts.mFootLightRight,
+                npcParts.mFootMediumLeft, npcParts.mFootMediumRight, npcParts.mFootHeavyLeft,
+                npcParts.mFootHeavyRight, npcParts.mFootWaterLeft, npcParts.mFootWaterRight, npcParts.mSwimLeft,
+                npcParts.mSwimRight });
+    }
+
     std::string_view Npc::getName(const MWWorld::ConstPtr& ptr) const
     {
         if (ptr.getRefData().getCustomData()
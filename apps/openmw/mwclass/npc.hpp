@@ -90,6 +90,9 @@ namespace MWClass
         ///< Get a list of models to preload that this object may use (directly or indirectly). default implementation:
         ///< list getModel().
 
+        void getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const override;
+        ///< Get a list of sounds to preload that this object may play on its own. default implementation: none.
+
         std::string_view getWerewolfRefusalSoundId() const override { return "WolfNPC"; }
 
         std::unique_ptr<MWWorld::Action> activate(const MWWorld::Ptr& ptr, const MWWorld::Ptr& actor) const override;
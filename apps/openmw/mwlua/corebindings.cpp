@@ -92,9 +92,10 @@ namespace MWLua
         };
         if (context.mType != Context::Load)
         {
-            api["quit"] = [lua = context.mLua]() {
+            api["quit"] = [lua = context.mLua, luaManager = context.mLuaManager]() {
                 Log(Debug::Warning) << "Quit requested by a Lua script.\n" << lua->debugTraceback();
-                MWBase::Environment::get().getStateManager()->requestQuit();
+                luaManager->addAction(
+                    [] { MWBase::Environment::get().getStateManager()->requestQuit(); }, "quitAction");
             };
             addCoreTimeBindings(api, context);
 
@@ -147,8 +148,7 @@ namespace MWLua
             if (context.mType != Context::Menu)
             {
                 api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData) {
-                    context.mLuaEvents->addGlobalEvent(
-                        { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    context.mLuaEvents->addGlobalEvent(eventData.lua_state(), std::move(eventName), eventData);
                 };
                 api["sound"]
                     = context.cachePackage("openmw_core_sound", [context]() { return initCoreSoundBindings(context); });
@@ -160,8 +160,7 @@ namespace MWLua
                     {
                         throw std::logic_error("Can't send global events when no game is loaded");
                     }
-                    context.mLuaEvents->addGlobalEvent(
-                        { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    context.mLuaEvents->addGlobalEvent(eventData.lua_state(), std::move(eventName), eventData);
                 };
             }
         }
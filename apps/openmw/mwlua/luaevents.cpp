@@ -27,6 +27,38 @@ namespace MWLua
         mMenuEvents.clear();
     }
 
+    static LuaEvents::EventData copyEventData(
+        lua_State* lua, const sol::object& eventData, const LuaUtil::UserdataSerializer* serializer)
+    {
+        if (eventData == sol::nil)
+            return LuaUtil::BinaryData{};
+        return sol::main_object(LuaUtil::copy(lua, eventData, serializer));
+    }
+
+    void LuaEvents::addGlobalEvent(lua_State* lua, std::string eventName, const sol::object& eventData)
+    {
+        addGlobalEvent({ std::move(eventName), copyEventData(lua, eventData, mGlobalSerializer) });
+    }
+
+    void LuaEvents::addMenuEvent(lua_State* lua, std::string eventName, const sol::object& eventData)
+    {
+        addMenuEvent({ std::move(eventName), copyEventData(lua, eventData, nullptr) });
+    }
+
+    void LuaEvents::addLocalEvent(lua_State* lua, ESM::RefNum dest, std::string eventName, const sol::object& eventData)
+    {
+        addLocalEvent({ dest, std::move(eventName), copyEventData(lua, eventData, mLocalSerializer) });
+    }
+
+    template <class Scripts>
+    static void deliverEvent(Scripts& scripts, const std::string& eventName, const LuaEvents::EventData& eventData)
+    {
+        if (const auto* value = std::get_if<sol::main_object>(&eventData))
+            scripts.receiveEventValue(eventName, *value);
+        else
+            scripts.receiveEvent(eventName, std::get<LuaUtil::BinaryData>(eventData));
+    }
+
     void LuaEvents::finalizeEventBatch()
     {
         mNewGlobalEventBatch.swap(mGlobalEventBatch);
@@ -38,14 +70,14 @@ namespace MWLua
     void LuaEvents::callEventHandlers()
     {
         for (const Global& e : mGlobalEventBatch)
-            mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
+            deliverEvent(mGlobalScripts, e.mEventName, e.mEventData);
         mGlobalEventBatch.clear();
         for (const Local& e : mLocalEventBatch)
         {
             MWWorld::Ptr ptr = MWBase::Environment::get().getWorldModel()->getPtr(e.mDest);
             LocalScripts* scripts = ptr.isEmpty() ? nullptr : ptr.getRefData().getLuaScripts();
             if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
+                deliverEvent(*scripts, e.mEventName, e.mEventData);
             else
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << e.mDest.toString()
                                   << ". Object not found or has no attached scripts";
@@ -56,17 +88,25 @@ namespace MWLua
     void LuaEvents::callMenuEventHandlers()
     {
         for (const Global& e : mMenuEvents)
-            mMenuScripts.receiveEvent(e.mEventName, e.mEventData);
+            deliverEvent(mMenuScripts, e.mEventName, e.mEventData);
         mMenuEvents.clear();
     }
 
     template <typename Event>
-    static void saveEvent(ESM::ESMWriter& esm, ESM::RefNum dest, const Event& event)
+    static void saveEvent(
+        ESM::ESMWriter& esm, ESM::RefNum dest, const Event& event, const LuaUtil::UserdataSerializer* serializer)
     {
         esm.writeHNString("LUAE", event.mEventName);
         esm.writeFormId(dest, true);
-        if (!event.mEventData.empty())
-            saveLuaBinaryData(esm, event.mEventData);
+        LuaUtil::BinaryData serialized;
+        const LuaUtil::BinaryData* data = std::get_if<LuaUtil::BinaryData>(&event.mEventData);
+        if (data == nullptr)
+        {
+            serialized = LuaUtil::serialize(std::get<sol::main_object>(event.mEventData), serializer);
+            data = &serialized;
+        }
+        if (!data->empty())
+            saveLuaBinaryData(esm, *data);
     }
 
     void LuaEvents::load(lua_State* lua, ESM::ESMReader& esm, const std::map<int, int>& contentFileMapping,
@@ -104,13 +144,13 @@ namespace MWLua
         constexpr ESM::RefNum globalId;
 
         for (const Global& e : mGlobalEventBatch)
-            saveEvent(esm, globalId, e);
+            saveEvent(esm, globalId, e, mGlobalSerializer);
         for (const Global& e : mNewGlobalEventBatch)
-            saveEvent(esm, globalId, e);
+            saveEvent(esm, globalId, e, mGlobalSerializer);
         for (const Local& e : mLocalEventBatch)
-            saveEvent(esm, e.mDest, e);
+            saveEvent(esm, e.mDest, e, mLocalSerializer);
         for (const Local& e : mNewLocalEventBatch)
-            saveEvent(esm, e.mDest, e);
+            saveEvent(esm, e.mDest, e, mLocalSerializer);
     }
 
 }
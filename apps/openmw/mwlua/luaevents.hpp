@@ -3,8 +3,12 @@
 
 #include <map>
 #include <string>
+#include <variant>
+
+#include <sol/object.hpp>
 
 #include <components/esm3/cellref.hpp> // defines RefNum that is used as a unique id
+#include <components/lua/serialization.hpp>
 
 struct lua_State;
 
@@ -34,22 +38,38 @@ namespace MWLua
         {
         }
 
+        // Events sent from Lua keep a copy of the Lua value (see LuaUtil::copy) that is passed to the handlers
+        // directly. Binary data is used for events sent from C++ and loaded from saves.
+        using EventData = std::variant<LuaUtil::BinaryData, sol::main_object>;
+
         struct Global
         {
             std::string mEventName;
-            std::string mEventData;
+            EventData mEventData;
         };
         struct Local
         {
             ESM::RefNum mDest;
             std::string mEventName;
-            std::string mEventData;
+            EventData mEventData;
         };
 
+        // Serializers of the receiving scripts. Used to convert objects in event data to the receiver's type.
+        void setSerializers(const LuaUtil::UserdataSerializer* global, const LuaUtil::UserdataSerializer* local)
+        {
+            mGlobalSerializer = global;
+            mLocalSerializer = local;
+        }
+
         void addGlobalEvent(Global event) { mNewGlobalEventBatch.push_back(std::move(event)); }
         void addMenuEvent(Global event) { mMenuEvents.push_back(std::move(event)); }
         void addLocalEvent(Local event) { mNewLocalEventBatch.push_back(std::move(event)); }
 
+        // Should be called from Lua. Copies eventData in the form expected by the receiver.
+        void addGlobalEvent(lua_State* lua, std::string eventName, const sol::object& eventData);
+        void addMenuEvent(lua_State* lua, std::string eventName, const sol::object& eventData);
+        void addLocalEvent(lua_State* lua, ESM::RefNum dest, std::string eventName, const sol::object& eventData);
+
         void clear();
         void finalizeEventBatch();
         void callEventHandlers();
@@ -62,6 +82,8 @@ namespace MWLua
     private:
         GlobalScripts& mGlobalScripts;
         MenuScripts& mMenuScripts;
+        const LuaUtil::UserdataSerializer* mGlobalSerializer = nullptr;
+        const LuaUtil::UserdataSerializer* mLocalSerializer = nullptr;
         std::vector<Global> mNewGlobalEventBatch;
         std::vector<Local> mNewLocalEventBatch;
         std::vector<Global> mGlobalEventBatch;
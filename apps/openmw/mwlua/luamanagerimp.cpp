@@ -72,7 +72,13 @@ namespace MWLua
         return { .mInstructionLimit = Settings::lua().mInstructionLimitPerCall,
             .mMemoryLimit = Settings::lua().mMemoryLimit,
             .mSmallAllocMaxSize = Settings::lua().mSmallAllocMaxSize,
-            .mLogMemoryUsage = Settings::lua().mLogMemoryUsage };
+            .mLogMemoryUsage = Settings::lua().mLogMemoryUsage,
+            .mFrameBudget = {
+                .mInstructionsPerScript = Settings::lua().mUpdateInstructionBudgetPerScript,
+                .mTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<float, std::milli>(Settings::lua().mUpdateTimeBudget.get())),
+                .mMaxDeferredFrames = static_cast<unsigned>(Settings::lua().mMaxDeferredUpdateFrames.get()),
+            } };
     }
 
     LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
@@ -87,6 +93,7 @@ namespace MWLua
         mLocalLoader = createUserdataSerializer(true, &mContentFileMapping);
 
         mGlobalScripts.setSerializer(mGlobalSerializer.get());
+        mLuaEvents.setSerializers(mGlobalSerializer.get(), mLocalSerializer.get());
     }
 
     LuaManager::~LuaManager()
@@ -104,8 +111,11 @@ namespace MWLua
         mGlobalScripts.setAutoStartConf(mConfiguration.getGlobalConf());
     }
 
-    void LuaManager::initPreLoad()
+    void LuaManager::initPreLoad(const std::filesystem::path& cachePath)
     {
+        if (Settings::lua().mBytecodeCache)
+            mLua.loadBytecodeCache(cachePath / "lua_bytecode_cache.bin");
+
         mLua.protectedCall([&](LuaUtil::LuaView& view) {
             Context context;
             context.mType = Context::Load;
@@ -200,6 +210,28 @@ namespace MWLua
         });
     }
 
+    void LuaManager::makeStorageSnapshot(LuaUtil::StorageSnapshot& global, LuaUtil::StorageSnapshot& player) const
+    {
+        global = mGlobalStorage.makeSnapshot();
+        player = mPlayerStorage.makeSnapshot();
+    }
+
+    void LuaManager::restoreStorageSnapshot(
+        const LuaUtil::StorageSnapshot& global, const LuaUtil::StorageSnapshot& player)
+    {
+        // Is called right before loading the game state, which activates global storage anyway.
+        mLua.protectedCall([&](LuaUtil::LuaView&) {
+            mGlobalStorage.setActive(true);
+            mGlobalStorage.restoreSnapshot(global);
+            mPlayerStorage.restoreSnapshot(player);
+        });
+    }
+
+    void LuaManager::saveBytecodeCache()
+    {
+        mLua.saveBytecodeCache();
+    }
+
     void LuaManager::sendLocalEvent(
         const MWWorld::Ptr& target, const std::string& name, const std::optional<sol::table>& data)
     {
@@ -239,6 +271,7 @@ namespace MWLua
             return l == nullptr || l->getPtrOrEmpty().isEmpty() || l->getPtrOrEmpty().mRef->isDeleted();
         });
 
+        mLua.getFrameBudget().startFrame();
         mGlobalScripts.statsNextFrame();
         for (const LuaUtil::ScriptsContainerWeakPtr& ptr : mActiveLocalScripts)
             asLocal(ptr)->statsNextFrame();
@@ -793,7 +826,7 @@ namespace MWLua
         ESM::LuaScripts globalScripts;
         mGlobalScripts.save(globalScripts);
         globalScripts.save(writer);
-        mLuaEvents.save(writer);
+        mLua.protectedCall([&](LuaUtil::LuaView&) { mLuaEvents.save(writer); });
 
         writer.endRecord(ESM::REC_LUAM);
     }
@@ -979,6 +1012,10 @@ namespace MWLua
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         stats.setAttribute(frameNumber, "Lua UsedMemory", static_cast<double>(mLua.getTotalMemoryUsage()));
+        const LuaUtil::FrameBudget::Stats& budgetStats = mLua.getFrameBudget().getStats();
+        stats.setAttribute(frameNumber, "Lua DeferredUpdates", budgetStats.mDeferredUpdates);
+        stats.setAttribute(frameNumber, "Lua DeferredTimerQueues", budgetStats.mDeferredTimerQueues);
+        stats.setAttribute(frameNumber, "Lua ThrottledScripts", budgetStats.mThrottledScripts);
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -42,12 +42,16 @@ namespace MWLua
         ~LuaManager();
 
         // Called by engine.cpp as part of content file loading
-        void initPreLoad();
+        void initPreLoad(const std::filesystem::path& cachePath);
         void contentFilesLoaded() override;
         void initPostLoad();
 
         void loadPermanentStorage(const std::filesystem::path& userConfigPath);
         void savePermanentStorage(const std::filesystem::path& userConfigPath) override;
+        void makeStorageSnapshot(LuaUtil::StorageSnapshot& global, LuaUtil::StorageSnapshot& player) const override;
+        void restoreStorageSnapshot(
+            const LuaUtil::StorageSnapshot& global, const LuaUtil::StorageSnapshot& player) override;
+        void saveBytecodeCache();
 
         // \brief Executes lua handlers. Defaults to running in parallel with OSG Cull.
         //
@@ -97,6 +97,23 @@ namespace MWLua
             manager->saveGame(description, slot);
         };
 
+        api["saveSnapshot"] = [context](std::string_view name) {
+            if (!context.mLuaManager->isSynchronizedUpdateRunning())
+                throw std::runtime_error(
+                    "menu.saveSnapshot can only be used during engine or event handler processing");
+            MWBase::Environment::get().getStateManager()->saveSnapshot(name);
+        };
+
+        api["restoreSnapshot"] = [](std::string_view name) {
+            MWBase::StateManager* manager = MWBase::Environment::get().getStateManager();
+            if (!manager->hasSnapshot(name))
+                throw std::runtime_error("Snapshot not found: " + std::string(name));
+            manager->requestRestoreSnapshot(name);
+        };
+
+        api["deleteSnapshot"]
+            = [](std::string_view name) { MWBase::Environment::get().getStateManager()->deleteSnapshot(name); };
+
         auto getSaves = [](sol::state_view currentState, const MWState::Character& character) {
             sol::table saves(currentState, sol::create);
             for (const MWState::Slot& slot : character)
@@ -137,7 +154,10 @@ namespace MWLua
             return saves;
         };
 
-        api["quit"] = []() { MWBase::Environment::get().getStateManager()->requestQuit(); };
+        api["quit"] = [context]() {
+            context.mLuaManager->addAction(
+                [] { MWBase::Environment::get().getStateManager()->requestQuit(); }, "quitAction");
+        };
 
         return LuaUtil::makeReadOnly(api);
     }
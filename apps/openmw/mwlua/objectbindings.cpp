@@ -346,8 +346,7 @@ namespace MWLua
             objectT[sol::meta_function::equal_to] = [](const ObjectT& a, const ObjectT& b) { return a.id() == b.id(); };
             objectT[sol::meta_function::to_string] = &ObjectT::toString;
             objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData) {
-                context.mLuaEvents->addLocalEvent(
-                    { dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                context.mLuaEvents->addLocalEvent(eventData.lua_state(), dest.id(), std::move(eventName), eventData);
             };
 
             objectT["activateBy"] = [](const ObjectT& object, const ObjectT& actor) {
@@ -104,6 +104,34 @@ namespace MWLua
             return false;
         }
 
+        // Converts objects to the type that is used by the scripts this serializer belongs to
+        // (e.g. GObject to LObject for local scripts).
+        bool copy(const sol::userdata& data, lua_State* lua) const override
+        {
+            if (data.is<GObject>() || data.is<LObject>())
+            {
+                ObjectId id = data.as<Object>().id();
+                if (mLocalSerializer)
+                    sol::stack::push<LObject>(lua, LObject(id));
+                else
+                    sol::stack::push<GObject>(lua, GObject(id));
+                return true;
+            }
+            if (data.is<GObjectList>() || data.is<LObjectList>())
+            {
+                // Lists like `nearby.actors` are updated in place, so the ids have to be copied.
+                const ObjectIdList& ids
+                    = data.is<GObjectList>() ? data.as<GObjectList>().mIds : data.as<LObjectList>().mIds;
+                ObjectIdList objList = std::make_shared<std::vector<ObjectId>>(*ids);
+                if (mLocalSerializer)
+                    sol::stack::push<LObjectList>(lua, LObjectList{ std::move(objList) });
+                else
+                    sol::stack::push<GObjectList>(lua, GObjectList{ std::move(objList) });
+                return true;
+            }
+            return false;
+        }
+
         bool mLocalSerializer;
         std::map<int, int>* mContentFileMapping;
     };
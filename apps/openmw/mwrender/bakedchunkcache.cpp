@@ -0,0 +1,254 @@
+#include "bakedchunkcache.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+#include <osg/Drawable>
+#include <osg/Texture>
+#include <osg/ValueObject>
+#include <osgDB/Callbacks>
+#include <osgDB/ObjectWrapper>
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/serialize.hpp>
+#include <components/shader/shadervisitor.hpp>
+#include <components/vfs/pathutil.hpp>
+
+namespace MWRender
+{
+    namespace
+    {
+        constexpr std::uint32_t sFormatVersion = 2;
+
+        bool hasWrapper(const osg::Object& object)
+        {
+            std::string name = object.libraryName();
+            name += "::";
+            name += object.className();
+            return osgDB::Registry::instance()->getObjectWrapperManager()->findWrapper(name) != nullptr;
+        }
+
+        // SceneUtil::registerSerializers replaces it with a serializer discarding the vertex data
+        bool canWriteGeometry()
+        {
+            osgDB::ObjectWrapper* const wrapper
+                = osgDB::Registry::instance()->getObjectWrapperManager()->findWrapper("osg::Geometry");
+            return wrapper != nullptr && wrapper->getSerializer("VertexArray") != nullptr;
+        }
+
+        class ReadImageCallback : public osgDB::ReadFileCallback
+        {
+        public:
+            explicit ReadImageCallback(Resource::ImageManager* imageManager)
+                : mImageManager(imageManager)
+            {
+            }
+
+            osgDB::ReaderWriter::ReadResult readImage(const std::string& fileName, const osgDB::Options*) override
+            {
+                const osg::ref_ptr<osg::Image> image = mImageManager->getImage(VFS::Path::Normalized(fileName));
+                return osgDB::ReaderWriter::ReadResult(image.get());
+            }
+
+        private:
+            Resource::ImageManager* mImageManager;
+        };
+
+        // Replaces the state sets of a copied chunk by copies with the state from before the ShaderVisitor, which
+        // recreates the shaders on load, and checks that every object can be read back.
+        class PrepareStoreVisitor : public osg::NodeVisitor
+        {
+        public:
+            bool mWritable = true;
+
+            PrepareStoreVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (!hasWrapper(node) || node.getUpdateCallback() != nullptr || node.getEventCallback() != nullptr
+                    || node.getCullCallback() != nullptr)
+                    mWritable = false;
+                if (const osg::Drawable* drawable = node.asDrawable(); drawable && drawable->getDrawCallback())
+                    mWritable = false;
+
+                node.setUserDataContainer(nullptr);
+                if (const osg::StateSet* stateSet = node.getStateSet())
+                {
+                    const StateSetCopy& stateSetCopy = copy(*stateSet);
+                    node.setStateSet(stateSetCopy.mStateSet);
+                    if (!stateSetCopy.mShaderPrefix.empty())
+                        node.setUserValue("shaderPrefix", stateSetCopy.mShaderPrefix);
+                }
+
+                traverse(node);
+            }
+
+        private:
+            struct StateSetCopy
+            {
+                osg::ref_ptr<osg::StateSet> mStateSet;
+                std::string mShaderPrefix;
+            };
+
+            std::unordered_map<const osg::StateSet*, StateSetCopy> mStateSets;
+
+            const StateSetCopy& copy(const osg::StateSet& stateSet)
+            {
+                StateSetCopy& stateSetCopy = mStateSets[&stateSet];
+                if (stateSetCopy.mStateSet != nullptr)
+                    return stateSetCopy;
+
+                // The user data is shared with the chunk, but the ShaderVisitor state is removed from it
+                osg::ref_ptr<osg::StateSet> result = osg::clone(&stateSet, osg::CopyOp::SHALLOW_COPY);
+                if (const osg::UserDataContainer* userData = result->getUserDataContainer())
+                    result->setUserDataContainer(osg::clone(userData, osg::CopyOp::SHALLOW_COPY));
+                stateSetCopy.mShaderPrefix = Shader::removeShaderState(*result);
+                stateSetCopy.mStateSet = result;
+
+                // Programs are not owned by the ShaderManager once read back
+                if (result->getAttribute(osg::StateAttribute::PROGRAM) != nullptr)
+                    mWritable = false;
+                if (result->getUpdateCallback() != nullptr || result->getEventCallback() != nullptr)
+                    mWritable = false;
+                if (const osg::UserDataContainer* userData = result->getUserDataContainer())
+                    for (unsigned int i = 0; i < userData->getNumUserObjects(); ++i)
+                        if (!hasWrapper(*userData->getUserObject(i)))
+                            mWritable = false;
+                for (const auto& [type, attribute] : result->getAttributeList())
+                    check(*attribute.first);
+                for (const osg::StateSet::AttributeList& attributes : result->getTextureAttributeList())
+                    for (const auto& [type, attribute] : attributes)
+                        check(*attribute.first);
+                for (const auto& [name, uniform] : result->getUniformList())
+                    if (!hasWrapper(*uniform.first) || uniform.first->getUpdateCallback() != nullptr
+                        || uniform.first->getEventCallback() != nullptr)
+                        mWritable = false;
+                return stateSetCopy;
+            }
+
+            void check(const osg::StateAttribute& attribute)
+            {
+                if (!hasWrapper(attribute) || attribute.getUpdateCallback() != nullptr
+                    || attribute.getEventCallback() != nullptr)
+                    mWritable = false;
+
+                // Images are read back from the VFS
+                if (const osg::Texture* texture = attribute.asTexture())
+                    for (unsigned int i = 0; i < texture->getNumImages(); ++i)
+                        if (const osg::Image* image = texture->getImage(i); image && image->getFileName().empty())
+                            mWritable = false;
+            }
+        };
+    }
+
+    BakedChunkCache::BakedChunkCache(Resource::SceneManager* sceneManager, const std::filesystem::path& path)
+        : mSceneManager(sceneManager)
+        , mPath(path)
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("osgb"))
+        , mOptions(new osgDB::Options)
+    {
+        SceneUtil::registerReadableSerializers();
+
+        if (mReaderWriter == nullptr)
+            Log(Debug::Warning) << "Can not find readerwriter for osgb, baked object paging chunks are disabled";
+
+        mOptions->setPluginStringData("WriteImageHint", "UseExternal");
+        mOptions->setReadFileCallback(new ReadImageCallback(mSceneManager->getImageManager()));
+    }
+
+    BakedChunkCache::~BakedChunkCache() = default;
+
+    osg::ref_ptr<osg::Node> BakedChunkCache::load(const std::string& name, const Hash& hash)
+    {
+        if (mReaderWriter == nullptr || !canWriteGeometry())
+            return nullptr;
+
+        const std::filesystem::path path = mPath / name;
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return nullptr;
+
+        std::uint32_t version = 0;
+        Hash fileHash{};
+        stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+        stream.read(reinterpret_cast<char*>(fileHash.data()), sizeof(fileHash));
+        if (!stream || version != sFormatVersion || fileHash != hash)
+            return nullptr;
+
+        osgDB::ReaderWriter::ReadResult result = mReaderWriter->readNode(stream, mOptions);
+        osg::ref_ptr<osg::Node> node = result.getNode();
+        if (!result.success() || node == nullptr)
+        {
+            Log(Debug::Warning) << "Failed to read baked chunk \"" << Files::pathToUnicodeString(path)
+                                << "\": " << result.message();
+            return nullptr;
+        }
+
+        // The programs come from the ShaderManager with the current shader settings and sources
+        mSceneManager->recreateShaders(node);
+        mSceneManager->shareState(node);
+
+        return node;
+    }
+
+    bool BakedChunkCache::store(const std::string& name, const Hash& hash, const osg::Node& chunk)
+    {
+        if (mReaderWriter == nullptr || !canWriteGeometry())
+            return false;
+
+        // The arrays and state attributes stay shared with the chunk
+        const osg::ref_ptr<osg::Node> copy
+            = osg::clone(&chunk, osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES);
+        PrepareStoreVisitor prepareStore;
+        copy->accept(prepareStore);
+        if (!prepareStore.mWritable)
+            return false;
+
+        const std::filesystem::path path = mPath / name;
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+        try
+        {
+            std::filesystem::create_directories(mPath);
+
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            stream.write(reinterpret_cast<const char*>(&sFormatVersion), sizeof(sFormatVersion));
+            stream.write(reinterpret_cast<const char*>(hash.data()), sizeof(hash));
+
+            const osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeNode(*copy, stream, mOptions);
+            if (!result.success())
+                throw std::runtime_error(result.message());
+
+            stream.close();
+            if (stream.fail())
+                throw std::runtime_error(
+                    "Write operation failed (file stream): " + std::generic_category().message(errno));
+
+            std::filesystem::rename(temporaryPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write baked chunk \"" << Files::pathToUnicodeString(path)
+                                << "\": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef OPENMW_MWRENDER_BAKEDCHUNKCACHE_H
+#define OPENMW_MWRENDER_BAKEDCHUNKCACHE_H
+
+#include <osg/ref_ptr>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class Options;
+    class ReaderWriter;
+}
+
+namespace Resource
+{
+    class SceneManager;
+}
+
+namespace MWRender
+{
+    /// @brief Files of the chunks built by ObjectPaging, so a chunk built in an earlier session is read instead of
+    /// being merged again.
+    /// @par Every file starts with the hash of everything its chunk was built from. A file with another hash is
+    /// outdated and gets replaced by the next store of the chunk.
+    class BakedChunkCache
+    {
+    public:
+        using Hash = std::array<std::uint64_t, 2>;
+
+        BakedChunkCache(Resource::SceneManager* sceneManager, const std::filesystem::path& path);
+        ~BakedChunkCache();
+
+        /// @return nullptr if there is no readable file with the given name and hash.
+        osg::ref_ptr<osg::Node> load(const std::string& name, const Hash& hash);
+
+        /// Writes a copy of the chunk without its shaders, which are recreated on load. Skips the chunk when it
+        /// contains objects which can't be read back.
+        /// @return true if the chunk was written.
+        bool store(const std::string& name, const Hash& hash, const osg::Node& chunk);
+
+    private:
+        Resource::SceneManager* mSceneManager;
+        std::filesystem::path mPath;
+        osgDB::ReaderWriter* mReaderWriter;
+        osg::ref_ptr<osgDB::Options> mOptions;
+    };
+}
+
+#endif
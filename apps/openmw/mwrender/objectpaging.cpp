@@ -1,7 +1,12 @@
 #include "objectpaging.hpp"
 
+#include <cctype>
+#include <chrono>
+#include <format>
 #include <limits>
+#include <sstream>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <osg/LOD>
@@ -28,6 +33,8 @@
 #include <components/esm4/loadfurn.hpp>
 #include <components/esm4/loadstat.hpp>
 #include <components/esm4/loadtree.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/osguservalues.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
@@ -35,11 +42,13 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
+#include <components/sceneutil/occlusionbuffer.hpp>
 #include <components/sceneutil/optimizer.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 #include <components/sceneutil/util.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -48,6 +57,7 @@
 #include "apps/openmw/mwclass/esm4base.hpp"
 #include "apps/openmw/mwworld/esmstore.hpp"
 
+#include "bakedchunkcache.hpp"
 #include "vismask.hpp"
 
 namespace MWRender
@@ -460,22 +470,39 @@ namespace MWRender
                 node.getOrCreateUserDataContainer()->addUserObject(marker);
             }
         };
+
+        std::string getBakedChunksDirectory(ESM::RefId worldspace)
+        {
+            std::string result = worldspace.serializeText();
+            std::replace_if(
+                result.begin(), result.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); }, '_');
+            return result;
+        }
     }
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace)
+    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, SceneUtil::WorkQueue* workQueue,
+        ESM::RefId worldspace, const std::filesystem::path& bakedChunksPath)
         : GenericResourceManager<ChunkId>(nullptr, Settings::cells().mCacheExpiryDelay)
         , Terrain::QuadTreeWorld::ChunkManager(worldspace)
         , mSceneManager(sceneManager)
+        , mWorkQueue(workQueue)
         , mActiveGrid(Settings::terrain().mObjectPagingActiveGrid)
         , mDebugBatches(Settings::terrain().mDebugChunks)
+        , mOcclusionCulling(Settings::terrain().mOcclusionCulling)
         , mMergeFactor(Settings::terrain().mObjectPagingMergeFactor)
         , mMinSize(Settings::terrain().mObjectPagingMinSize)
         , mMinSizeMergeFactor(Settings::terrain().mObjectPagingMinSizeMergeFactor)
         , mMinSizeCostMultiplier(Settings::terrain().mObjectPagingMinSizeCostMultiplier)
         , mRefTrackerLocked(false)
     {
+        // Debug colors would end up in the files
+        if (Settings::terrain().mObjectPagingCache && !mDebugBatches)
+            mBakedChunks = std::make_unique<BakedChunkCache>(
+                sceneManager, bakedChunksPath / getBakedChunksDirectory(worldspace));
     }
 
+    ObjectPaging::~ObjectPaging() = default;
+
     namespace
     {
         struct PagedCellRef
@@ -487,6 +514,13 @@ namespace MWRender
             float mScale;
         };
 
+        osg::Quat getAttitude(const PagedCellRef& ref)
+        {
+            return osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
+                * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
+                * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
+        }
+
         PagedCellRef makePagedCellRef(const ESM::CellRef& value)
         {
             return PagedCellRef{
@@ -620,6 +654,7 @@ namespace MWRender
     osg::ref_ptr<osg::Node> ObjectPaging::createChunk(float size, const osg::Vec2f& center, bool activeGrid,
         const osg::Vec3f& viewPoint, bool compile, unsigned char lod)
     {
+        const auto gatherStart = std::chrono::steady_clock::now();
         const osg::Vec2i startCell(static_cast<int>(std::floor(center.x() - size / 2.f)),
             static_cast<int>(std::floor(center.y() - size / 2.f)));
         const MWBase::World& world = *MWBase::Environment::get().getWorld();
@@ -659,6 +694,7 @@ namespace MWRender
             static_cast<int>(std::ceil(maxBound.x())), static_cast<int>(std::ceil(maxBound.y())));
         struct InstanceList
         {
+            VFS::Path::Normalized mModel;
             std::vector<const PagedCellRef*> mInstances;
             AnalyzeVisitor::Result mAnalyzeResult;
             bool mNeedCompile = false;
@@ -772,6 +808,7 @@ namespace MWRender
             const auto emplaced = nodes.emplace(std::move(cnode), InstanceList());
             if (emplaced.second)
             {
+                emplaced.first->second.mModel = model;
                 analyzeVisitor.mDistances = lodDistances / ref.mScale;
                 const osg::Node* const nodePtr = emplaced.first->first.get();
                 // const-trickery required because there is no const version of NodeVisitor
@@ -786,16 +823,21 @@ namespace MWRender
 
         const osg::Vec3f worldCenter
             = osg::Vec3f(center.x(), center.y(), 0) * static_cast<float>(getCellSize(mWorldspace));
-        osg::ref_ptr<osg::Group> group = new osg::Group;
-        osg::ref_ptr<osg::Group> mergeGroup = new osg::Group;
-        osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
-        osgUtil::StateToCompile stateToCompile(0, nullptr);
-        CopyOp copyop(activeGrid, copyMask);
-        for (const auto& pair : nodes)
-        {
-            const osg::Node* cnode = pair.first;
 
-            const AnalyzeVisitor::Result& analyzeResult = pair.second.mAnalyzeResult;
+        // Merging is decided for the whole chunk, because the benefit depends on the state sets used by other meshes.
+        struct MeshInstances
+        {
+            const osg::Node* mNode;
+            const InstanceList* mInstanceList;
+            bool mMerge;
+            std::vector<const PagedCellRef*> mRefs;
+            osg::ref_ptr<osg::Group> mInstances;
+        };
+        std::vector<MeshInstances> meshes;
+        meshes.reserve(nodes.size());
+        for (const auto& [cnode, instanceList] : nodes)
+        {
+            const AnalyzeVisitor::Result& analyzeResult = instanceList.mAnalyzeResult;
 
             const float mergeCost = analyzeResult.mNumVerts * size;
             const float mergeBenefit = analyzeVisitor.getMergeBenefit(analyzeResult) * mMergeFactor;
@@ -806,24 +848,156 @@ namespace MWRender
             const float minSizeMergeFactor2 = (1 - factor2) * mMinSizeMergeFactor + factor2;
             const float minSizeMerged = minSizeMergeFactor2 > 0 ? mMinSize * minSizeMergeFactor2 : mMinSize;
 
-            unsigned int numinstances = 0;
-            for (const PagedCellRef* refPtr : pair.second.mInstances)
+            std::vector<const PagedCellRef*> instanceRefs;
+            instanceRefs.reserve(instanceList.mInstances.size());
+            for (const PagedCellRef* ref : instanceList.mInstances)
             {
-                const PagedCellRef& ref = *refPtr;
-
                 if (!activeGrid && minSizeMerged != minSize
-                    && cnode->getBound().radius2() * ref.mScale * ref.mScale
-                        < (viewPoint - ref.mPosition).length2() * minSizeMerged * minSizeMerged)
+                    && cnode->getBound().radius2() * ref->mScale * ref->mScale
+                        < (viewPoint - ref->mPosition).length2() * minSizeMerged * minSizeMerged)
                     continue;
+                instanceRefs.push_back(ref);
+            }
+
+            meshes.push_back(MeshInstances{ cnode.get(), &instanceList, merge, std::move(instanceRefs), nullptr });
+        }
+
+        // Occluders of the meshes are in the space of their template. They are not stored with baked chunks, so they
+        // are built for both.
+        std::vector<osg::ref_ptr<SceneUtil::Occluder>> occluders;
+        if (mOcclusionCulling)
+        {
+            for (const MeshInstances& mesh : meshes)
+            {
+                SceneUtil::forEachOccluder(*mesh.mNode, [&](const SceneUtil::Occluder& occluder) {
+                    for (const PagedCellRef* ref : mesh.mRefs)
+                    {
+                        // Indices of an occluder are 16 bits
+                        if (occluders.empty()
+                            || occluders.back()->mVertices.size() + occluder.mVertices.size()
+                                > std::numeric_limits<unsigned short>::max() + std::size_t{ 1 })
+                            occluders.push_back(new SceneUtil::Occluder);
+                        SceneUtil::Occluder& chunkOccluder = *occluders.back();
+
+                        osg::Matrixf matrix;
+                        matrix.preMultTranslate(ref->mPosition - worldCenter);
+                        matrix.preMultRotate(getAttitude(*ref));
+                        matrix.preMultScale(osg::Vec3f(ref->mScale, ref->mScale, ref->mScale));
+
+                        const std::size_t offset = chunkOccluder.mVertices.size();
+                        for (const osg::Vec3f& vertex : occluder.mVertices)
+                            chunkOccluder.mVertices.push_back(vertex * matrix);
+                        for (const unsigned short index : occluder.mIndices)
+                            chunkOccluder.mIndices.push_back(static_cast<unsigned short>(offset + index));
+                    }
+                });
+            }
+        }
+
+        std::string bakedName;
+        BakedChunkCache::Hash bakedHash;
+        if (mBakedChunks != nullptr && !activeGrid)
+        {
+            bakedName = std::format("{}_{}_{}_{}.osgb", size, center.x(), center.y(), lod);
+
+            // Disabled and too small refs are already filtered out, so the hash changes along with them
+            std::vector<const MeshInstances*> sortedMeshes;
+            for (const MeshInstances& mesh : meshes)
+                if (!mesh.mRefs.empty())
+                    sortedMeshes.push_back(&mesh);
+            std::sort(sortedMeshes.begin(), sortedMeshes.end(), [](const MeshInstances* l, const MeshInstances* r) {
+                return l->mInstanceList->mModel.value() < r->mInstanceList->mModel.value();
+            });
+
+            std::string hashInput;
+            const auto addHashInput
+                = [&](const auto& value) { hashInput.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+            // Shaders are recreated on load, but the textures added for them are stored
+            addHashInput(Settings::shaders().mAutoUseObjectNormalMaps.get());
+            addHashInput(Settings::shaders().mAutoUseObjectSpecularMaps.get());
+            hashInput += Settings::shaders().mNormalMapPattern.get();
+            hashInput += '\0';
+            hashInput += Settings::shaders().mNormalHeightMapPattern.get();
+            hashInput += '\0';
+            hashInput += Settings::shaders().mSpecularMapPattern.get();
+            hashInput += '\0';
+            for (const MeshInstances* mesh : sortedMeshes)
+            {
+                std::string fileHash;
+                mesh->mNode->getUserValue(Misc::OsgUserValues::sFileHash, fileHash);
+                hashInput += mesh->mInstanceList->mModel.value();
+                hashInput += '\0';
+                hashInput += fileHash;
+                hashInput += '\0';
+                addHashInput(mesh->mMerge);
+                addHashInput(mesh->mRefs.size());
+                for (const PagedCellRef* ref : mesh->mRefs)
+                {
+                    addHashInput(ref->mRefNum);
+                    addHashInput(ref->mPosition);
+                    addHashInput(ref->mRotation);
+                    addHashInput(ref->mScale);
+                }
+            }
+            std::istringstream hashStream(std::move(hashInput));
+            bakedHash = Files::getHash(bakedName, hashStream);
+            if (osg::ref_ptr<osg::Node> baked = mBakedChunks->load(bakedName, bakedHash))
+            {
+                osgUtil::IncrementalCompileOperation* const ico = mSceneManager->getIncrementalCompileOperation();
+                if (compile && ico)
+                {
+                    osgUtil::StateToCompile stateToCompile(osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS
+                            | osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES,
+                        nullptr);
+                    baked->accept(stateToCompile);
+                    if (!stateToCompile.empty())
+                    {
+                        auto compileSet = new osgUtil::IncrementalCompileOperation::CompileSet(baked);
+                        compileSet->buildCompileMap(ico->getContextSet(), stateToCompile);
+                        ico->add(compileSet, false);
+                    }
+                }
+
+                baked->getBound();
+                baked->setNodeMask(Mask_Static);
+                for (const osg::ref_ptr<SceneUtil::Occluder>& occluder : occluders)
+                    baked->getOrCreateUserDataContainer()->addUserObject(occluder);
+
+                const std::lock_guard<std::mutex> lock(mBuildStatsMutex);
+                ++mBuildStats.mBakedLoads;
+                mBuildStats.mGatherTime += std::chrono::steady_clock::now() - gatherStart;
+                return baked;
+            }
+        }
+
+        const auto instanceStart = std::chrono::steady_clock::now();
+
+        // Meshes are instanced independently of each other on the preload threads.
+        SceneUtil::runInParallel(mWorkQueue, meshes.size(), [&](std::size_t index) {
+            MeshInstances& mesh = meshes[index];
+            const osg::Node* const cnode = mesh.mNode;
+            mesh.mInstances = new osg::Group;
+
+            // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays is
+            // generally unsafe. In this specific case the operation is safe under the following two assumptions:
+            // - When Arrays are removed or replaced in the cloned geometry, the original Arrays in their place must
+            // outlive the cloned geometry regardless. (ensured by TemplateMultiRef)
+            // - Arrays that we add or replace in the cloned geometry must be explicitely forbidden from reusing
+            // BufferObjects of the original geometry. (ensured by needvbo() in optimizer.cpp)
+            CopyOp copyop(activeGrid, copyMask);
+            copyop.setCopyFlags(mesh.mMerge ? osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
+                                            : osg::CopyOp::DEEP_COPY_NODES);
+
+            for (const PagedCellRef* refPtr : mesh.mRefs)
+            {
+                const PagedCellRef& ref = *refPtr;
 
                 const osg::Vec3f nodePos = ref.mPosition - worldCenter;
-                const osg::Quat nodeAttitude = osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
-                    * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
-                    * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
+                const osg::Quat nodeAttitude = getAttitude(ref);
                 const osg::Vec3f nodeScale(ref.mScale, ref.mScale, ref.mScale);
 
                 osg::ref_ptr<osg::Group> trans;
-                if (merge)
+                if (mesh.mMerge)
                 {
                     // Optimizer currently supports only MatrixTransforms.
                     osg::Matrixf matrix;
@@ -843,20 +1017,12 @@ namespace MWRender
                     pat->setAttitude(nodeAttitude);
                 }
 
-                // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays is
-                // generally unsafe. In this specific case the operation is safe under the following two assumptions:
-                // - When Arrays are removed or replaced in the cloned geometry, the original Arrays in their place must
-                // outlive the cloned geometry regardless. (ensured by TemplateMultiRef)
-                // - Arrays that we add or replace in the cloned geometry must be explicitely forbidden from reusing
-                // BufferObjects of the original geometry. (ensured by needvbo() in optimizer.cpp)
-                copyop.setCopyFlags(merge ? osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
-                                          : osg::CopyOp::DEEP_COPY_NODES);
                 copyop.mDistances = lodDistances / ref.mScale;
                 copyop.copy(cnode, trans);
 
                 if (activeGrid)
                 {
-                    if (merge)
+                    if (mesh.mMerge)
                     {
                         AddRefnumMarkerVisitor visitor(ref.mRefNum);
                         trans->accept(visitor);
@@ -869,24 +1035,47 @@ namespace MWRender
                     }
                 }
 
-                osg::Group* const attachTo = merge ? mergeGroup : group;
-                attachTo->addChild(trans);
-                ++numinstances;
+                mesh.mInstances->addChild(trans);
             }
-            if (numinstances > 0)
+
+            // Baking the transforms into the vertices is the most expensive part of merging and doesn't depend on the
+            // other meshes, the geometry is merged across meshes afterwards.
+            if (mesh.mMerge && mesh.mInstances->getNumChildren() > 0)
             {
-                // add a ref to the original template to help verify the safety of shallow cloning operations
-                // in addition, we hint to the cache that it's still being used and should be kept in cache
-                templateRefs->addRef(cnode);
+                SceneUtil::Optimizer optimizer;
+                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+                optimizer.optimize(mesh.mInstances, SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS);
+            }
+        });
 
-                if (pair.second.mNeedCompile)
-                {
-                    int mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES;
-                    if (!merge)
-                        mode |= osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
-                    stateToCompile._mode = mode;
-                    const_cast<osg::Node*>(cnode)->accept(stateToCompile);
-                }
+        const auto optimizeStart = std::chrono::steady_clock::now();
+
+        osg::ref_ptr<osg::Group> group = new osg::Group;
+        osg::ref_ptr<osg::Group> mergeGroup = new osg::Group;
+        osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
+        osgUtil::StateToCompile stateToCompile(0, nullptr);
+        for (const MeshInstances& mesh : meshes)
+        {
+            const unsigned int numinstances = mesh.mInstances->getNumChildren();
+            if (numinstances == 0)
+                continue;
+
+            osg::Group* const attachTo = mesh.mMerge ? mergeGroup : group;
+            for (unsigned int i = 0; i < numinstances; ++i)
+                attachTo->addChild(mesh.mInstances->getChild(i));
+            mesh.mInstances->removeChildren(0, numinstances);
+
+            // add a ref to the original template to help verify the safety of shallow cloning operations
+            // in addition, we hint to the cache that it's still being used and should be kept in cache
+            templateRefs->addRef(mesh.mNode);
+
+            if (mesh.mInstanceList->mNeedCompile)
+            {
+                int mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES;
+                if (!mesh.mMerge)
+                    mode |= osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
+                stateToCompile._mode = mode;
+                const_cast<osg::Node*>(mesh.mNode)->accept(stateToCompile);
             }
         }
 
@@ -901,8 +1090,8 @@ namespace MWRender
                 optimizer.setMergeAlphaBlending(true);
             }
             optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
-            const unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
-                | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
+            const unsigned int options
+                = SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
 
             optimizer.optimize(mergeGroup, options);
 
@@ -940,6 +1129,21 @@ namespace MWRender
             group->addCullCallback(new SceneUtil::LightListCallback);
         }
         udc->addUserObject(templateRefs);
+        for (const osg::ref_ptr<SceneUtil::Occluder>& occluder : occluders)
+            udc->addUserObject(occluder);
+
+        const bool stored = !bakedName.empty() && mBakedChunks->store(bakedName, bakedHash, *group);
+
+        const auto end = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mBuildStatsMutex);
+            ++mBuildStats.mChunks;
+            if (stored)
+                ++mBuildStats.mBakedStores;
+            mBuildStats.mGatherTime += instanceStart - gatherStart;
+            mBuildStats.mInstanceTime += optimizeStart - instanceStart;
+            mBuildStats.mOptimizeTime += end - optimizeStart;
+        }
 
         return group;
     }
@@ -1107,6 +1311,21 @@ namespace MWRender
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Object Chunk", frameNumber, mCache->getStats(), *stats);
+
+        BuildStats buildStats;
+        {
+            std::lock_guard<std::mutex> lock(mBuildStatsMutex);
+            buildStats = std::exchange(mBuildStats, BuildStats{});
+        }
+        stats->setAttribute(frameNumber, "Object Chunk Builds", static_cast<double>(buildStats.mChunks));
+        stats->setAttribute(frameNumber, "Object Chunk Baked Loads", static_cast<double>(buildStats.mBakedLoads));
+        stats->setAttribute(frameNumber, "Object Chunk Baked Stores", static_cast<double>(buildStats.mBakedStores));
+        stats->setAttribute(frameNumber, "Object Chunk Gather Time",
+            std::chrono::duration<double, std::milli>(buildStats.mGatherTime).count());
+        stats->setAttribute(frameNumber, "Object Chunk Instance Time",
+            std::chrono::duration<double, std::milli>(buildStats.mInstanceTime).count());
+        stats->setAttribute(frameNumber, "Object Chunk Optimize Time",
+            std::chrono::duration<double, std::milli>(buildStats.mOptimizeTime).count());
     }
 
 }
@@ -5,6 +5,9 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include <chrono>
+#include <filesystem>
+#include <memory>
 #include <mutex>
 
 namespace Resource
@@ -12,16 +15,25 @@ namespace Resource
     class SceneManager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWRender
 {
+    class BakedChunkCache;
 
     typedef std::tuple<osg::Vec2f, float, bool> ChunkId; // Center, Size, ActiveGrid
 
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace);
-        ~ObjectPaging() = default;
+        /// @param workQueue Helps building a chunk when it has idle threads, may be nullptr.
+        /// @param bakedChunksPath Directory for the files of the chunks of every worldspace.
+        ObjectPaging(Resource::SceneManager* sceneManager, SceneUtil::WorkQueue* workQueue, ESM::RefId worldspace,
+            const std::filesystem::path& bakedChunksPath);
+        ~ObjectPaging();
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
             bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
@@ -49,8 +61,11 @@ namespace MWRender
 
     private:
         Resource::SceneManager* mSceneManager;
+        SceneUtil::WorkQueue* mWorkQueue;
+        std::unique_ptr<BakedChunkCache> mBakedChunks;
         bool mActiveGrid;
         bool mDebugBatches;
+        bool mOcclusionCulling;
         float mMergeFactor;
         float mMinSize;
         float mMinSizeMergeFactor;
@@ -81,6 +96,19 @@ namespace MWRender
         typedef std::pair<std::string, unsigned char> LODNameCacheKey; // Key: mesh name, lod level
         using LODNameCache = std::map<LODNameCacheKey, VFS::Path::Normalized>; // Cache: key, mesh name to use
         LODNameCache mLODNameCache;
+
+        // Accumulated by chunk builds since the last reportStats call.
+        struct BuildStats
+        {
+            std::size_t mChunks = 0;
+            std::size_t mBakedLoads = 0;
+            std::size_t mBakedStores = 0;
+            std::chrono::steady_clock::duration mGatherTime{ 0 };
+            std::chrono::steady_clock::duration mInstanceTime{ 0 };
+            std::chrono::steady_clock::duration mOptimizeTime{ 0 };
+        };
+        mutable std::mutex mBuildStatsMutex;
+        mutable BuildStats mBuildStats;
     };
 
     class RefnumMarker : public osg::Object
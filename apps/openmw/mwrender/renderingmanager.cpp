@@ -32,11 +32,14 @@
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
+#include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/stateupdater.hpp>
 #include <components/sceneutil/texmat.hpp>
+#include <components/sceneutil/updatestage.hpp>
 #include <components/sceneutil/visitor.hpp>
 #include <components/sceneutil/workqueue.hpp>
 #include <components/sceneutil/writescene.hpp>
@@ -131,6 +134,26 @@ namespace
     private:
         bool mDoThreadUnsafeOps = false;
     };
+
+    // Runs the update stage after the update traversal has scheduled drawables and particle systems and updated the
+    // skeletons.
+    class UpdateStageRunner : public SceneUtil::NodeCallback<UpdateStageRunner>
+    {
+    public:
+        explicit UpdateStageRunner(SceneUtil::UpdateStage& stage)
+            : mStage(&stage)
+        {
+        }
+
+        void operator()(osg::Node* node, osg::NodeVisitor* nv)
+        {
+            traverse(node, nv);
+            mStage->run(*nv);
+        }
+
+    private:
+        osg::ref_ptr<SceneUtil::UpdateStage> mStage;
+    };
 }
 
 namespace MWRender
@@ -171,7 +194,7 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-        SceneUtil::UnrefQueue& unrefQueue)
+        SceneUtil::UnrefQueue& unrefQueue, const std::filesystem::path& userDataPath)
         : mSkyBlending(Settings::fog().mSkyBlending)
         , mViewer(viewer)
         , mRootNode(rootNode)
@@ -188,6 +211,7 @@ namespace MWRender
         , mFieldOfView(Settings::camera().mFieldOfView)
         , mFirstPersonFieldOfView(Settings::camera().mFirstPersonFieldOfView)
         , mGroundCoverStore(groundcoverStore)
+        , mUserDataPath(userDataPath)
     {
         bool reverseZ = SceneUtil::AutoDepth::isReversed();
 
@@ -313,6 +337,17 @@ namespace MWRender
         mSharedUniformStateUpdater = new SceneUtil::SharedUniformStateUpdater(Settings::fog().mSkyBlendingStart);
         rootNode->addUpdateCallback(mSharedUniformStateUpdater);
 
+        mUpdateStage = new SceneUtil::UpdateStage(Settings::general().mUpdateStageNumThreads);
+        osgUtil::UpdateVisitor* defaultUpdateVisitor = viewer->getUpdateVisitor();
+        osg::ref_ptr<SceneUtil::UpdateStageVisitor> updateVisitor = new SceneUtil::UpdateStageVisitor(*mUpdateStage);
+        updateVisitor->setTraversalMode(defaultUpdateVisitor->getTraversalMode());
+        updateVisitor->setTraversalMask(defaultUpdateVisitor->getTraversalMask());
+        updateVisitor->setFrameStamp(defaultUpdateVisitor->getFrameStamp());
+        viewer->setUpdateVisitor(updateVisitor);
+        rootNode->addUpdateCallback(new UpdateStageRunner(*mUpdateStage));
+        SceneUtil::Skeleton::setLodScreenSizes({ Settings::game().mAnimationLodReducedRateSize,
+            Settings::game().mAnimationLodReducedBonesSize, Settings::game().mAnimationLodFrozenSize });
+
         mPerViewUniformStateUpdater = new SceneUtil::PerViewUniformStateUpdater(mResourceSystem->getSceneManager(),
             mResourceSystem->getSceneManager()->getShaderManager().reserveGlobalTextureUnits(
                 Shader::ShaderManager::Slot::OpaqueDepthTexture));
@@ -1293,10 +1328,12 @@ namespace MWRender
             auto quadTreeWorld = std::make_unique<Terrain::QuadTreeWorld>(mSceneRoot, mRootNode, mResourceSystem,
                 mTerrainStorage.get(), Mask_Terrain, Mask_PreCompile, Mask_Debug, compMapResolution, compMapLevel,
                 lodFactor, vertexLodMod, maxCompGeometrySize, debugChunks, worldspace, expiryDelay);
+            quadTreeWorld->setOcclusionCulling(Settings::terrain().mOcclusionCulling);
             if (Settings::terrain().mObjectPaging)
             {
                 newChunkMgr.mObjectPaging
-                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace);
+                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), mWorkQueue.get(), worldspace,
+                        mUserDataPath / "objectpaging");
                 quadTreeWorld->addChunkManager(newChunkMgr.mObjectPaging.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mObjectPaging.get());
             }
@@ -1331,6 +1368,20 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            mSceneRoot->reportStats(frameNumber, *stats);
+            stats->setAttribute(
+                frameNumber, "Deformation Drawables", static_cast<double>(mUpdateStage->getLastCount()));
+            stats->setAttribute(
+                frameNumber, "Particle Systems", static_cast<double>(mUpdateStage->getLastParticleSystemCount()));
+            constexpr std::pair<SceneUtil::Skeleton::Lod, const char*> skeletonLods[] = {
+                { SceneUtil::Skeleton::Lod::Full, "Animation LOD Full" },
+                { SceneUtil::Skeleton::Lod::ReducedRate, "Animation LOD Reduced Rate" },
+                { SceneUtil::Skeleton::Lod::ReducedBones, "Animation LOD Reduced Bones" },
+                { SceneUtil::Skeleton::Lod::Frozen, "Animation LOD Frozen" },
+            };
+            for (const auto& [lod, name] : skeletonLods)
+                stats->setAttribute(
+                    frameNumber, name, static_cast<double>(mUpdateStage->getLastSkeletonCount(lod)));
         }
     }
 
@@ -13,6 +13,7 @@
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <deque>
+#include <filesystem>
 #include <memory>
 #include <span>
 #include <unordered_map>
@@ -66,6 +67,7 @@ namespace SceneUtil
     class SharedUniformStateUpdater;
     class StateUpdater;
     class Light;
+    class UpdateStage;
 }
 
 namespace DetourNavigator
@@ -113,7 +115,7 @@ namespace MWRender
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
             DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-            SceneUtil::UnrefQueue& unrefQueue);
+            SceneUtil::UnrefQueue& unrefQueue, const std::filesystem::path& userDataPath);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
@@ -349,6 +351,7 @@ namespace MWRender
         osg::ref_ptr<SceneUtil::StateUpdater> mStateUpdater;
         osg::ref_ptr<SceneUtil::SharedUniformStateUpdater> mSharedUniformStateUpdater;
         osg::ref_ptr<SceneUtil::PerViewUniformStateUpdater> mPerViewUniformStateUpdater;
+        osg::ref_ptr<SceneUtil::UpdateStage> mUpdateStage;
 
         osg::Vec4f mAmbientColor;
         float mNightEyeFactor;
@@ -363,6 +366,7 @@ namespace MWRender
         bool mNight = false;
         osg::Vec2f mProjectionOffset;
         const MWWorld::GroundcoverStore& mGroundCoverStore;
+        const std::filesystem::path mUserDataPath;
 
         void operator=(const RenderingManager&);
         RenderingManager(const RenderingManager&);
@@ -862,7 +862,8 @@ namespace MWSound
             mDevice = nullptr;
             return false;
         }
-        Log(Debug::Info) << "Allocated " << mFreeSources.size() << " sound sources";
+        mSourceCount = mFreeSources.size();
+        Log(Debug::Info) << "Allocated " << mSourceCount << " sound sources";
 
         if (ALC.EXT_EFX)
         {
@@ -979,6 +980,7 @@ namespace MWSound
         for (ALuint source : mFreeSources)
             alDeleteSources(1, &source);
         mFreeSources.clear();
+        mSourceCount = 0;
 
         if (mEffectSlot)
             alDeleteAuxiliaryEffectSlots(1, &mEffectSlot);
@@ -1029,43 +1031,49 @@ namespace MWSound
         return ret;
     }
 
-    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
+    DecodedSound OpenALOutput::decodeSound(VFS::Path::NormalizedView fname)
     {
-        getALError();
-
-        std::vector<char> data;
-        ALenum format = AL_NONE;
-        int srate = 0;
-
+        DecodedSound result;
         try
         {
             DecoderPtr decoder = mManager.getDecoder();
             decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder->mResourceMgr));
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
+            decoder->getInfo(&result.mSampleRate, &result.mChannelConfig, &result.mSampleType);
+            decoder->readAll(result.mData);
         }
         catch (std::exception& e)
         {
             Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+            result.mData.clear();
         }
+        return result;
+    }
 
-        if (data.empty())
+    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(const DecodedSound& sound)
+    {
+        getALError();
+
+        ALenum format = AL_NONE;
+        if (!sound.mData.empty())
+            format = getALFormat(sound.mChannelConfig, sound.mSampleType);
+
+        const char* data = sound.mData.data();
+        std::size_t dataSize = sound.mData.size();
+        int srate = sound.mSampleRate;
+        static const std::vector<char> silence(8000, -128);
+        if (!format)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            data = silence.data();
+            dataSize = silence.size();
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), static_cast<ALsizei>(data.size()), srate);
+        alBufferData(buf, format, data, static_cast<ALsizei>(dataSize), srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1320,6 +1328,40 @@ namespace MWSound
         getALError();
     }
 
+    float OpenALOutput::getSoundOffset(Sound* sound)
+    {
+        if (!sound->mHandle)
+            return 0.0f;
+        ALuint source = GET_PTRID(sound->mHandle);
+        ALfloat offset = 0.0f;
+
+        alGetSourcef(source, AL_SEC_OFFSET, &offset);
+        getALError();
+
+        return offset;
+    }
+
+    float OpenALOutput::getSoundDuration(Sound_Handle data)
+    {
+        ALuint buffer = GET_PTRID(data);
+        if (!buffer)
+            return 0.0f;
+        ALint size = 0;
+        ALint bits = 0;
+        ALint channels = 0;
+        ALint frequency = 0;
+
+        alGetBufferi(buffer, AL_SIZE, &size);
+        alGetBufferi(buffer, AL_BITS, &bits);
+        alGetBufferi(buffer, AL_CHANNELS, &channels);
+        alGetBufferi(buffer, AL_FREQUENCY, &frequency);
+        if (getALError() != AL_NO_ERROR || bits < 8 || channels <= 0 || frequency <= 0)
+            return 0.0f;
+
+        const ALint frames = size / (bits / 8 * channels);
+        return static_cast<float>(frames) / static_cast<float>(frequency);
+    }
+
     bool OpenALOutput::streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData)
     {
         if (mFreeSources.empty())
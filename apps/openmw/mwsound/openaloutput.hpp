@@ -39,6 +39,7 @@ namespace MWSound
 
         typedef std::deque<ALuint> IDDq;
         IDDq mFreeSources;
+        std::size_t mSourceCount = 0;
 
         typedef std::vector<Sound*> SoundVec;
         SoundVec mActiveSounds;
@@ -88,7 +89,8 @@ namespace MWSound
 
         std::vector<std::string> enumerateHrtf() override;
 
-        std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override;
+        DecodedSound decodeSound(VFS::Path::NormalizedView fname) override;
+        std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound* sound, Sound_Handle data, float offset) override;
@@ -96,6 +98,9 @@ namespace MWSound
         void finishSound(Sound* sound) override;
         bool isSoundPlaying(Sound* sound) override;
         void updateSound(Sound* sound) override;
+        float getSoundOffset(Sound* sound) override;
+        float getSoundDuration(Sound_Handle data) override;
+        std::size_t getSourceCount() const override { return mSourceCount; }
 
         bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false) override;
         bool streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData) override;
@@ -0,0 +1,79 @@
+#include "pcmcompression.hpp"
+
+#include <components/misc/compression.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace MWSound
+{
+    namespace
+    {
+        // Replaces every sample by its difference to the previous sample of the same channel, or reverts that.
+        // A trailing incomplete sample is copied as is.
+        template <class T, bool encode>
+        void filterDelta(const void* input, void* output, std::size_t size, std::size_t channels)
+        {
+            const auto* const in = static_cast<const std::byte*>(input);
+            auto* const out = static_cast<std::byte*>(output);
+            const std::size_t count = size / sizeof(T);
+            for (std::size_t channel = 0; channel < channels; ++channel)
+            {
+                T previous = 0;
+                for (std::size_t i = channel; i < count; i += channels)
+                {
+                    T value;
+                    std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+                    const T result = encode ? static_cast<T>(value - previous) : static_cast<T>(value + previous);
+                    previous = encode ? value : result;
+                    std::memcpy(out + i * sizeof(T), &result, sizeof(T));
+                }
+            }
+            std::memcpy(out + count * sizeof(T), in + count * sizeof(T), size - count * sizeof(T));
+        }
+
+        template <bool encode>
+        void filter(const void* input, void* output, std::size_t size, ChannelConfig config, SampleType type)
+        {
+            const std::size_t channels = framesToBytes(1, config, SampleType_UInt8);
+            switch (type)
+            {
+                case SampleType_UInt8:
+                    filterDelta<std::uint8_t, encode>(input, output, size, channels);
+                    return;
+                case SampleType_Int16:
+                    filterDelta<std::uint16_t, encode>(input, output, size, channels);
+                    return;
+                case SampleType_Float32:
+                    break;
+            }
+            std::memcpy(output, input, size);
+        }
+    }
+
+    CompressedSound compressSound(const DecodedSound& sound)
+    {
+        std::vector<std::byte> filtered(sound.mData.size());
+        filter<true>(sound.mData.data(), filtered.data(), filtered.size(), sound.mChannelConfig, sound.mSampleType);
+
+        CompressedSound result;
+        result.mData = Misc::compress(filtered);
+        result.mChannelConfig = sound.mChannelConfig;
+        result.mSampleType = sound.mSampleType;
+        result.mSampleRate = sound.mSampleRate;
+        return result;
+    }
+
+    DecodedSound decompressSound(const CompressedSound& sound)
+    {
+        const std::vector<std::byte> filtered = Misc::decompress(sound.mData);
+
+        DecodedSound result;
+        result.mData.resize(filtered.size());
+        filter<false>(filtered.data(), result.mData.data(), filtered.size(), sound.mChannelConfig, sound.mSampleType);
+        result.mChannelConfig = sound.mChannelConfig;
+        result.mSampleType = sound.mSampleType;
+        result.mSampleRate = sound.mSampleRate;
+        return result;
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef GAME_SOUND_PCMCOMPRESSION_H
+#define GAME_SOUND_PCMCOMPRESSION_H
+
+#include <cstddef>
+#include <vector>
+
+#include "sounddecoder.hpp"
+
+namespace MWSound
+{
+    // Losslessly compressed PCM samples. Integer samples are stored as differences to the previous sample of the
+    // same channel, which makes them compress much better.
+    struct CompressedSound
+    {
+        std::vector<std::byte> mData;
+        ChannelConfig mChannelConfig = ChannelConfig_Mono;
+        SampleType mSampleType = SampleType_UInt8;
+        int mSampleRate = 0;
+    };
+
+    CompressedSound compressSound(const DecodedSound& sound);
+
+    DecodedSound decompressSound(const CompressedSound& sound);
+}
+
+#endif
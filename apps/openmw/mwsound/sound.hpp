@@ -165,6 +165,7 @@ namespace MWSound
         bool getUseEnv() const { return !(mParams.mFlags & MWSound::PlayMode::NoEnv); }
         bool getIsLooping() const { return mParams.mFlags & MWSound::PlayMode::Loop; }
         bool getDistanceCull() const { return mParams.mFlags & MWSound::PlayMode::RemoveAtDistance; }
+        bool getTimeScaled() const { return !(mParams.mFlags & MWSound::PlayMode::NoScaling); }
         bool getIs3D() const { return mParams.mFlags & Play_3D; }
         bool getInFade() const { return mParams.mFlags & Play_InFade; }
 
@@ -183,7 +184,19 @@ namespace MWSound
         Sound(const Sound&) = delete;
         Sound(Sound&&) = delete;
 
+        // A virtual sound isn't bound to an output source, its playback position is tracked by the sound manager
+        // until the sound is audible enough to get a source back.
+        bool mVirtual = false;
+        float mVirtualOffset = 0.0f;
+        // 0 if the output can't tell the duration of the buffer.
+        float mDuration = 0.0f;
+        Sound_Handle mData = nullptr;
+
+        friend class SoundManager;
+
     public:
+        bool getIsVirtual() const { return mVirtual; }
+
         Sound() = default;
     };
 
@@ -12,6 +12,8 @@
 #include <components/settings/values.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include <osg/Stats>
+
 #include <algorithm>
 #include <cmath>
 
@@ -41,11 +43,28 @@ namespace MWSound
         }
     }
 
+    void DecodeSoundItem::decode()
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (mCompressed != nullptr)
+            mResult = decompressSound(*mCompressed);
+        else
+            mResult = mOutput.decodeSound(mFileName);
+        mDecodeTime = std::chrono::steady_clock::now() - start;
+    }
+
+    void CompressSoundItem::doWork()
+    {
+        mResult = std::make_shared<const CompressedSound>(compressSound(mSound));
+        mSound = DecodedSound();
+    }
+
     SoundBufferPool::SoundBufferPool(SoundOutput& output)
         : mOutput(&output)
         , mBufferCacheMax(Settings::sound().mBufferCacheMax * 1024 * 1024)
         , mBufferCacheMin(
               std::min(static_cast<std::size_t>(Settings::sound().mBufferCacheMin) * 1024 * 1024, mBufferCacheMax))
+        , mCompressedCacheMax(static_cast<std::size_t>(Settings::sound().mCompressedBufferCacheMax) * 1024 * 1024)
     {
     }
 
@@ -83,7 +102,48 @@ namespace MWSound
         if (sfx->getHandle() != nullptr)
             return sfx;
 
-        auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+        if (sfx->mDecodeItem == nullptr)
+        {
+            const osg::ref_ptr<DecodeSoundItem> item = makeDecodeItem(*sfx);
+            item->claim();
+            item->decode();
+            return loadDecoded(sfx, *item);
+        }
+
+        // The sound is needed right now, don't wait for the background thread to get to it.
+        const osg::ref_ptr<DecodeSoundItem> item = sfx->mDecodeItem;
+        sfx->mDecodeItem = nullptr;
+        if (item->claim())
+            item->decode();
+        else
+            item->waitTillDone();
+        mPendingBuffers.erase(std::find(mPendingBuffers.begin(), mPendingBuffers.end(), sfx));
+        return loadDecoded(sfx, *item);
+    }
+
+    osg::ref_ptr<DecodeSoundItem> SoundBufferPool::makeDecodeItem(SoundBuffer& sfx)
+    {
+        if (sfx.mCompressed != nullptr)
+        {
+            ++mCompressedHits;
+            const auto it = std::find(mCompressedBuffers.begin(), mCompressedBuffers.end(), &sfx);
+            if (it != mCompressedBuffers.begin())
+            {
+                mCompressedBuffers.erase(it);
+                mCompressedBuffers.push_front(&sfx);
+            }
+        }
+        else if (mCompressedCacheMax > 0)
+            ++mCompressedMisses;
+        return new DecodeSoundItem(*mOutput, sfx.getResourceName(), sfx.mCompressed);
+    }
+
+    SoundBuffer* SoundBufferPool::loadDecoded(SoundBuffer* sfx, DecodeSoundItem& item)
+    {
+        mFrameDecodeTime += item.getDecodeTime();
+
+        DecodedSound& sound = item.getResult();
+        auto [handle, size] = mOutput->loadSound(sound);
         if (handle == nullptr)
             return {};
 
@@ -98,10 +158,43 @@ namespace MWSound
         }
         mUnusedBuffers.push_front(sfx);
 
+        if (item.isFromFile() && !sound.mData.empty() && mCompressedCacheMax > 0)
+        {
+            osg::ref_ptr<CompressSoundItem> compressItem(new CompressSoundItem(std::move(sound)));
+            addWorkItem(compressItem);
+            mCompressingBuffers.emplace_back(sfx, std::move(compressItem));
+        }
+
         return sfx;
     }
 
-    SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    void SoundBufferPool::addWorkItem(osg::ref_ptr<SceneUtil::WorkItem> item)
+    {
+        if (mWorkQueue == nullptr)
+            mWorkQueue = new SceneUtil::WorkQueue(1);
+        mWorkQueue->addWorkItem(std::move(item));
+    }
+
+    void SoundBufferPool::insertCompressed(SoundBuffer& sfx, std::shared_ptr<const CompressedSound> compressed)
+    {
+        const std::size_t size = compressed->mData.size();
+        if (sfx.mCompressed != nullptr || size > mCompressedCacheMax)
+            return;
+
+        sfx.mCompressed = std::move(compressed);
+        mCompressedCacheSize += size;
+        mCompressedBuffers.push_front(&sfx);
+
+        while (mCompressedCacheSize > mCompressedCacheMax)
+        {
+            SoundBuffer* const oldest = mCompressedBuffers.back();
+            mCompressedCacheSize -= oldest->mCompressed->mData.size();
+            oldest->mCompressed = nullptr;
+            mCompressedBuffers.pop_back();
+        }
+    }
+
+    SoundBuffer* SoundBufferPool::find(const ESM::RefId& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -114,21 +207,67 @@ namespace MWSound
                 insertSound(sound.mId, sound);
         }
 
-        SoundBuffer* sfx;
         const auto it = mBufferNameMap.find(soundId);
         if (it != mBufferNameMap.end())
-            sfx = it->second;
-        else
-        {
-            const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
-            if (sound == nullptr)
-                return {};
-            sfx = insertSound(soundId, *sound);
-        }
+            return it->second;
+
+        const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
+        if (sound == nullptr)
+            return nullptr;
+        return insertSound(soundId, *sound);
+    }
+
+    SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    {
+        SoundBuffer* sfx = find(soundId);
+        if (sfx == nullptr)
+            return {};
 
         return loadSfx(sfx);
     }
 
+    void SoundBufferPool::preload(const ESM::RefId& soundId)
+    {
+        SoundBuffer* sfx = find(soundId);
+        if (sfx == nullptr || sfx->getHandle() != nullptr || sfx->mDecodeItem != nullptr)
+            return;
+
+        sfx->mDecodeItem = makeDecodeItem(*sfx);
+        addWorkItem(sfx->mDecodeItem);
+        mPendingBuffers.push_back(sfx);
+    }
+
+    void SoundBufferPool::update()
+    {
+        mLastFrameDecodeTime = mFrameDecodeTime;
+        mFrameDecodeTime = std::chrono::steady_clock::duration(0);
+
+        std::erase_if(mPendingBuffers, [&](SoundBuffer* sfx) {
+            if (!sfx->mDecodeItem->isDone())
+                return false;
+            loadDecoded(sfx, *sfx->mDecodeItem);
+            sfx->mDecodeItem = nullptr;
+            return true;
+        });
+
+        std::erase_if(mCompressingBuffers, [&](const auto& v) {
+            if (!v.second->isDone())
+                return false;
+            insertCompressed(*v.first, v.second->getResult());
+            return true;
+        });
+    }
+
+    void SoundBufferPool::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Sound CompressedCache Count", static_cast<double>(mCompressedBuffers.size()));
+        stats.setAttribute(frameNumber, "Sound CompressedCache Size", static_cast<double>(mCompressedCacheSize));
+        stats.setAttribute(frameNumber, "Sound CompressedCache Hit", static_cast<double>(mCompressedHits));
+        stats.setAttribute(frameNumber, "Sound CompressedCache Miss", static_cast<double>(mCompressedMisses));
+        stats.setAttribute(frameNumber, "Sound DecodeTime",
+            std::chrono::duration<double, std::milli>(mLastFrameDecodeTime).count());
+    }
+
     SoundBuffer* SoundBufferPool::load(VFS::Path::NormalizedView fileName)
     {
         SoundBuffer* sfx;
@@ -143,16 +282,29 @@ namespace MWSound
 
     void SoundBufferPool::clear()
     {
+        for (SoundBuffer* sfx : mPendingBuffers)
+        {
+            // Make sure the background thread doesn't use the output anymore.
+            if (!sfx->mDecodeItem->claim())
+                sfx->mDecodeItem->waitTillDone();
+            sfx->mDecodeItem = nullptr;
+        }
+        mPendingBuffers.clear();
+        mCompressingBuffers.clear();
+
         for (auto& sfx : mSoundBuffers)
         {
             if (sfx.mHandle)
                 mOutput->unloadSound(sfx.mHandle);
             sfx.mHandle = nullptr;
+            sfx.mCompressed = nullptr;
         }
 
         mBufferFileNameMap.clear();
         mBufferNameMap.clear();
         mUnusedBuffers.clear();
+        mCompressedBuffers.clear();
+        mCompressedCacheSize = 0;
     }
 
     SoundBuffer* SoundBufferPool::insertSound(VFS::Path::NormalizedView fileName)
@@ -2,12 +2,18 @@
 #define GAME_SOUND_SOUNDBUFFER_H
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <components/esm/refid.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include "pcmcompression.hpp"
 #include "soundoutput.hpp"
 
 namespace ESM
@@ -26,10 +32,74 @@ namespace VFS
     class Manager;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWSound
 {
     class SoundBufferPool;
 
+    /// Worker thread item: decode a sound to be loaded into a sound buffer.
+    class DecodeSoundItem : public SceneUtil::WorkItem
+    {
+    public:
+        /// @param compressed If not null, the sound is restored from it instead of the file.
+        DecodeSoundItem(
+            SoundOutput& output, VFS::Path::NormalizedView fileName, std::shared_ptr<const CompressedSound> compressed)
+            : mOutput(output)
+            , mFileName(fileName)
+            , mCompressed(std::move(compressed))
+        {
+        }
+
+        /// Returns true if the calling thread is the one that has to decode the sound.
+        bool claim() { return !mClaimed.exchange(true); }
+
+        void doWork() override
+        {
+            if (claim())
+                decode();
+        }
+
+        void abort() override { claim(); }
+
+        void decode();
+
+        bool isFromFile() const { return mCompressed == nullptr; }
+
+        DecodedSound& getResult() { return mResult; }
+
+        std::chrono::steady_clock::duration getDecodeTime() const { return mDecodeTime; }
+
+    private:
+        SoundOutput& mOutput;
+        VFS::Path::Normalized mFileName;
+        std::shared_ptr<const CompressedSound> mCompressed;
+        std::atomic_bool mClaimed{ false };
+        DecodedSound mResult;
+        std::chrono::steady_clock::duration mDecodeTime{ 0 };
+    };
+
+    /// Worker thread item: make a compressed copy of a decoded sound.
+    class CompressSoundItem : public SceneUtil::WorkItem
+    {
+    public:
+        explicit CompressSoundItem(DecodedSound&& sound)
+            : mSound(std::move(sound))
+        {
+        }
+
+        void doWork() override;
+
+        const std::shared_ptr<const CompressedSound>& getResult() const { return mResult; }
+
+    private:
+        DecodedSound mSound;
+        std::shared_ptr<const CompressedSound> mResult;
+    };
+
     class SoundBuffer
     {
     public:
@@ -59,6 +129,10 @@ namespace MWSound
         float mMaxDist;
         Sound_Handle mHandle = nullptr;
         std::size_t mUses = 0;
+        // Not null while the sound is being decoded in background.
+        osg::ref_ptr<DecodeSoundItem> mDecodeItem;
+        // Not null while the sound is in the compressed cache.
+        std::shared_ptr<const CompressedSound> mCompressed;
 
         friend class SoundBufferPool;
     };
@@ -87,6 +161,14 @@ namespace MWSound
         // Lookup for a sound by file name, and ensure it's ready for use.
         SoundBuffer* load(VFS::Path::NormalizedView fileName);
 
+        /// Start decoding the sound in background, so it's ready when needed. Does nothing if the sound
+        /// is already loaded or pending.
+        void preload(const ESM::RefId& soundId);
+
+        /// Load the sounds decoded in background into sound buffers, and put the sounds compressed in background
+        /// into the compressed cache. Should be called every frame.
+        void update();
+
         void use(SoundBuffer& sfx)
         {
             if (sfx.mUses++ == 0)
@@ -105,10 +187,20 @@ namespace MWSound
 
         void clear();
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
+        SoundBuffer* find(const ESM::RefId& soundId);
         SoundBuffer* loadSfx(SoundBuffer* sfx);
+        osg::ref_ptr<DecodeSoundItem> makeDecodeItem(SoundBuffer& sfx);
+        SoundBuffer* loadDecoded(SoundBuffer* sfx, DecodeSoundItem& item);
+        void addWorkItem(osg::ref_ptr<SceneUtil::WorkItem> item);
+        void insertCompressed(SoundBuffer& sfx, std::shared_ptr<const CompressedSound> compressed);
 
         SoundOutput* mOutput;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::vector<SoundBuffer*> mPendingBuffers;
+        std::vector<std::pair<SoundBuffer*, osg::ref_ptr<CompressSoundItem>>> mCompressingBuffers;
         std::deque<SoundBuffer> mSoundBuffers;
         std::unordered_map<ESM::RefId, SoundBuffer*> mBufferNameMap;
         std::unordered_map<VFS::Path::Normalized, SoundBuffer*, VFS::Path::Hash, std::equal_to<>> mBufferFileNameMap;
@@ -117,6 +209,14 @@ namespace MWSound
         std::size_t mBufferCacheSize = 0;
         // NOTE: unused buffers are stored in front-newest order.
         std::deque<SoundBuffer*> mUnusedBuffers;
+        std::size_t mCompressedCacheMax;
+        std::size_t mCompressedCacheSize = 0;
+        // NOTE: compressed buffers are stored in front-newest order.
+        std::deque<SoundBuffer*> mCompressedBuffers;
+        std::size_t mCompressedHits = 0;
+        std::size_t mCompressedMisses = 0;
+        std::chrono::steady_clock::duration mFrameDecodeTime{ 0 };
+        std::chrono::steady_clock::duration mLastFrameDecodeTime{ 0 };
 
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM::Sound& sound);
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM4::Sound& sound);
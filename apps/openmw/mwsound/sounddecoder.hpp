@@ -34,6 +34,15 @@ namespace MWSound
     size_t framesToBytes(size_t frames, ChannelConfig config, SampleType type);
     size_t bytesToFrames(size_t bytes, ChannelConfig config, SampleType type);
 
+    // Sound data decoded to PCM samples, ready to be loaded into a sound buffer.
+    struct DecodedSound
+    {
+        std::vector<char> mData;
+        ChannelConfig mChannelConfig = ChannelConfig_Mono;
+        SampleType mSampleType = SampleType_UInt8;
+        int mSampleRate = 0;
+    };
+
     struct SoundDecoder
     {
         const VFS::Manager* mResourceMgr;
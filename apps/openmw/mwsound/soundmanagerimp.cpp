@@ -1,6 +1,7 @@
 #include "soundmanagerimp.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <numeric>
 #include <sstream>
@@ -41,6 +42,24 @@ namespace MWSound
         constexpr float sSfxFadeInDuration = 1.0f;
         constexpr float sSfxFadeOutDuration = 1.0f;
         constexpr float sSoundCullDistance = 2000.f;
+        // Output sources not given to 3D sounds, they are left for 2D sounds and streams.
+        constexpr std::size_t sReservedSources = 32;
+        // Makes sounds that already have an output source a bit more audible when they are ranked, so sounds of
+        // similar audibility don't swap their sources every update.
+        constexpr float sRealVoiceBias = 1.25f;
+
+        float getPriority(Type type)
+        {
+            switch (type)
+            {
+                case Type::Voice:
+                    return 2.0f;
+                case Type::Foot:
+                    return 0.5f;
+                default:
+                    return 1.0f;
+            }
+        }
 
         WaterSoundUpdaterSettings makeWaterSoundUpdaterSettings()
         {
@@ -158,6 +177,10 @@ namespace MWSound
 
             Log(Debug::Info) << stream.str();
         }
+
+        const std::size_t sourceCount = mOutput->getSourceCount();
+        mMaxVoices = sourceCount - std::min(sourceCount / 4, sReservedSources);
+        mFreeVoices = mMaxVoices;
     }
 
     SoundManager::~SoundManager()
@@ -477,7 +500,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_2D;
             return params;
         }());
-        if (!mOutput->playSound(sound.get(), sfx->getHandle(), offset))
+        if (!startSound(*sound, *sfx, offset))
             return nullptr;
 
         Sound* result = sound.get();
@@ -539,7 +562,7 @@ namespace MWSound
                 params.mFlags = mode | type | Play_2D;
                 return params;
             }());
-            played = mOutput->playSound(sound.get(), sfx->getHandle(), offset);
+            played = startSound(*sound, *sfx, offset);
         }
         else
         {
@@ -555,7 +578,7 @@ namespace MWSound
                 params.mFlags = mode | type | Play_3D;
                 return params;
             }());
-            played = mOutput->playSound3D(sound.get(), sfx->getHandle(), offset);
+            played = startSound(*sound, *sfx, offset);
         }
         if (!played)
             return nullptr;
@@ -626,7 +649,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_3D;
             return params;
         }());
-        if (!mOutput->playSound3D(sound.get(), sfx->getHandle(), offset))
+        if (!startSound(*sound, *sfx, offset))
             return nullptr;
 
         Sound* result = sound.get();
@@ -638,7 +661,7 @@ namespace MWSound
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
-            mOutput->finishSound(sound);
+            finishSound(sound);
     }
 
     void SoundManager::stopSound(SoundBuffer* sfx, const MWWorld::ConstPtr& ptr)
@@ -649,7 +672,7 @@ namespace MWSound
             for (SoundBufferRefPair& snd : snditer->second.mList)
             {
                 if (snd.second == sfx)
-                    mOutput->finishSound(snd.first.get());
+                    finishSound(snd.first.get());
             }
         }
     }
@@ -684,7 +707,7 @@ namespace MWSound
         if (snditer != mActiveSounds.end())
         {
             for (SoundBufferRefPair& snd : snditer->second.mList)
-                mOutput->finishSound(snd.first.get());
+                finishSound(snd.first.get());
         }
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(ptr.mRef);
         if (sayiter != mSaySoundsQueue.end())
@@ -701,7 +724,7 @@ namespace MWSound
             if (ref != nullptr && ref != MWMechanics::getPlayer().mRef && sound.mCell == cell)
             {
                 for (SoundBufferRefPair& sndbuf : sound.mList)
-                    mOutput->finishSound(sndbuf.first.get());
+                    finishSound(sndbuf.first.get());
             }
         }
 
@@ -745,13 +768,21 @@ namespace MWSound
 
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
-                           return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get());
+                           return snd.second == sfx && isSoundPlaying(snd.first.get());
                        })
                 != snditer->second.mList.cend();
         }
         return false;
     }
 
+    void SoundManager::preloadSounds(std::span<const ESM::RefId> soundIds)
+    {
+        if (!mOutput->isInitialized())
+            return;
+        for (const ESM::RefId& soundId : soundIds)
+            mSoundBuffers.preload(soundId);
+    }
+
     bool SoundManager::getSoundPlaying(const MWWorld::ConstPtr& ptr, const ESM::RefId& soundId) const
     {
         SoundMap::const_iterator snditer = mActiveSounds.find(ptr.mRef);
@@ -763,7 +794,7 @@ namespace MWSound
 
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
-                           return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get());
+                           return snd.second == sfx && isSoundPlaying(snd.first.get());
                        })
                 != snditer->second.mList.cend();
         }
@@ -817,6 +848,101 @@ namespace MWSound
         mOutput->resumeActiveDevice();
     }
 
+    bool SoundManager::startSound(Sound& sound, const SoundBuffer& sfx, float offset)
+    {
+        sound.mData = sfx.getHandle();
+        sound.mVirtual = false;
+        if (!sound.getIs3D())
+            return mOutput->playSound(&sound, sound.mData, offset);
+
+        if (mFreeVoices > 0 && mOutput->playSound3D(&sound, sound.mData, offset))
+        {
+            --mFreeVoices;
+            return true;
+        }
+
+        // Keep the sound virtual until the next update decides if it's audible enough to get an output source.
+        sound.mVirtual = true;
+        sound.mVirtualOffset = offset;
+        sound.mDuration = mOutput->getSoundDuration(sound.mData);
+        return isSoundPlaying(&sound);
+    }
+
+    void SoundManager::finishSound(Sound* sound)
+    {
+        sound->mVirtual = false;
+        mOutput->finishSound(sound);
+    }
+
+    bool SoundManager::isSoundPlaying(Sound* sound) const
+    {
+        // A virtual sound of unknown duration is kept until it gets an output source again
+        if (sound->mVirtual)
+            return sound->getIsLooping() || sound->mDuration <= 0 || sound->mVirtualOffset < sound->mDuration;
+        return mOutput->isSoundPlaying(sound);
+    }
+
+    float SoundManager::getAudibility(const Sound& sound) const
+    {
+        const float distance = (sound.getPosition() - mListenerPos).length();
+        if (distance > sound.getMaxDistance())
+            return 0.0f;
+        // Same attenuation as AL_INVERSE_DISTANCE_CLAMPED with the rolloff factor 1
+        const float attenuation = sound.getMinDistance() / std::max(distance, sound.getMinDistance());
+        const float audibility = sound.getRealVolume() * attenuation * getPriority(sound.getPlayType());
+        return sound.getIsVirtual() ? audibility : audibility * sRealVoiceBias;
+    }
+
+    void SoundManager::updateVoices(float duration, std::size_t pinnedVoices)
+    {
+        const std::size_t maxVoices = mMaxVoices - std::min(mMaxVoices, pinnedVoices);
+        const auto realEnd = mVoices.begin() + static_cast<std::ptrdiff_t>(std::min(mVoices.size(), maxVoices));
+        std::nth_element(mVoices.begin(), realEnd, mVoices.end(),
+            [](const Voice& l, const Voice& r) { return l.mAudibility > r.mAudibility; });
+
+        // Free output sources first, so they can be given to the sounds that became more audible
+        for (auto it = realEnd; it != mVoices.end(); ++it)
+        {
+            Sound& sound = *it->mSound;
+            if (sound.mVirtual)
+                continue;
+            const float offset = mOutput->getSoundOffset(&sound);
+            mOutput->finishSound(&sound);
+            sound.mVirtual = true;
+            sound.mVirtualOffset = offset;
+            sound.mDuration = mOutput->getSoundDuration(sound.mData);
+        }
+
+        std::size_t realVoices = pinnedVoices;
+        for (auto it = mVoices.begin(); it != realEnd; ++it)
+        {
+            Sound& sound = *it->mSound;
+            if (!sound.mVirtual)
+                mOutput->updateSound(&sound);
+            else if (mOutput->playSound3D(&sound, sound.mData, sound.mVirtualOffset))
+                sound.mVirtual = false;
+            else
+                continue;
+            ++realVoices;
+        }
+
+        const float timeScale = getSimulationTimeScale();
+        for (const Voice& voice : mVoices)
+        {
+            Sound& sound = *voice.mSound;
+            // Without the duration the offset can't be kept in range, so the sound resumes where it stopped
+            if (!sound.mVirtual || sound.mDuration <= 0)
+                continue;
+            sound.mVirtualOffset += duration * sound.getPitch() * (sound.getTimeScaled() ? timeScale : 1.0f);
+            if (sound.getIsLooping())
+                sound.mVirtualOffset = std::fmod(sound.mVirtualOffset, sound.mDuration);
+        }
+
+        mFreeVoices = mMaxVoices - std::min(mMaxVoices, realVoices);
+        mRealVoices = realVoices;
+        mVirtualVoices = mVoices.size() + pinnedVoices - realVoices;
+    }
+
     void SoundManager::updateRegionSound(float duration)
     {
         MWBase::World* world = MWBase::Environment::get().getWorld();
@@ -825,7 +951,7 @@ namespace MWSound
 
         if (!cell->isExterior() && !cell->isQuasiExterior())
             return;
-        if (mCurrentRegionSound && mOutput->isSoundPlaying(mCurrentRegionSound))
+        if (mCurrentRegionSound && isSoundPlaying(mCurrentRegionSound))
             return;
 
         ESM::RefId next = mRegionSoundSelector.getNextRandom(duration, cell->getRegion());
@@ -858,7 +984,7 @@ namespace MWSound
                 break;
             case WaterSoundAction::PlaySound:
                 if (mNearWaterSound)
-                    mOutput->finishSound(mNearWaterSound);
+                    finishSound(mNearWaterSound);
                 mNearWaterSound = playSound(update.mId, update.mVolume, 1.0f, Type::Sfx, PlayMode::Loop);
                 break;
         }
@@ -951,7 +1077,7 @@ namespace MWSound
             env = Env_Underwater;
         else if (mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            finishSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -960,6 +1086,13 @@ namespace MWSound
 
         updateMusic(duration);
 
+        // 3D sounds of paused types keep their state, the rest are ranked to decide which of them get output sources
+        int pausedTypes = 0;
+        for (int types : mPausedSoundTypes)
+            pausedTypes |= types;
+        std::size_t pinnedVoices = 0;
+        mVoices.clear();
+
         // Check if any sounds are finished playing, and trash them
         SoundMap::iterator snditer = mActiveSounds.begin();
         while (snditer != mActiveSounds.end())
@@ -984,9 +1117,9 @@ namespace MWSound
                     cull3DSound(sound);
                 }
 
-                if (!sound->updateFade(duration) || !mOutput->isSoundPlaying(sound))
+                if (!sound->updateFade(duration) || !isSoundPlaying(sound))
                 {
-                    mOutput->finishSound(sound);
+                    finishSound(sound);
                     if (sound == mUnderwaterSound)
                         mUnderwaterSound = nullptr;
                     if (sound == mNearWaterSound)
@@ -996,7 +1129,12 @@ namespace MWSound
                 }
                 else
                 {
-                    mOutput->updateSound(sound);
+                    if (sound->getIs3D() && !(pausedTypes & static_cast<int>(sound->getPlayType())))
+                        mVoices.push_back(Voice{ sound, getAudibility(*sound) });
+                    else if (sound->getIs3D() && !sound->getIsVirtual())
+                        ++pinnedVoices;
+                    else
+                        mOutput->updateSound(sound);
                     ++sndidx;
                 }
             }
@@ -1006,6 +1144,8 @@ namespace MWSound
                 ++snditer;
         }
 
+        updateVoices(duration, pinnedVoices);
+
         SaySoundMap::iterator sayiter = mActiveSaySounds.begin();
         while (sayiter != mActiveSaySounds.end())
         {
@@ -1089,6 +1229,8 @@ namespace MWSound
         if (!mOutput->isInitialized() || mPlaybackPaused)
             return;
 
+        mSoundBuffers.update();
+
         MWBase::StateManager::State state = MWBase::Environment::get().getStateManager()->getState();
         bool isMainMenu = MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_MainMenu)
             && state == MWBase::StateManager::State_NoGame;
@@ -1273,7 +1415,7 @@ namespace MWSound
         {
             for (SoundBufferRefPair& sndbuf : snd.second.mList)
             {
-                mOutput->finishSound(sndbuf.first.get());
+                finishSound(sndbuf.first.get());
                 mSoundBuffers.release(*sndbuf.second);
             }
         }
@@ -1295,4 +1437,11 @@ namespace MWSound
         mPlaybackPaused = false;
         std::fill(std::begin(mPausedSoundTypes), std::end(mPausedSoundTypes), 0);
     }
+
+    void SoundManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Sound Voices Real", static_cast<double>(mRealVoices));
+        stats.setAttribute(frameNumber, "Sound Voices Virtual", static_cast<double>(mVirtualVoices));
+        mSoundBuffers.reportStats(frameNumber, stats);
+    }
 }
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <components/fallback/fallback.hpp>
 #include <components/misc/objectpool.hpp>
@@ -96,6 +97,19 @@ namespace MWSound
 
         int mPausedSoundTypes[BlockerType::MaxCount] = {};
 
+        // 3D sounds ranked by audibility, only the most audible ones are bound to output sources
+        struct Voice
+        {
+            Sound* mSound;
+            float mAudibility;
+        };
+
+        std::vector<Voice> mVoices;
+        std::size_t mMaxVoices = 0;
+        std::size_t mFreeVoices = 0;
+        std::size_t mRealVoices = 0;
+        std::size_t mVirtualVoices = 0;
+
         Sound* mUnderwaterSound;
         Sound* mNearWaterSound;
 
@@ -132,6 +146,12 @@ namespace MWSound
         Sound* playSound3D(const MWWorld::ConstPtr& ptr, SoundBuffer* sfx, float volume, float pitch, Type type,
             PlayMode mode, float offset);
 
+        bool startSound(Sound& sound, const SoundBuffer& sfx, float offset);
+        void finishSound(Sound* sound);
+        bool isSoundPlaying(Sound* sound) const;
+        float getAudibility(const Sound& sound) const;
+        void updateVoices(float duration, std::size_t pinnedVoices);
+
         void updateSounds(float duration);
         void updateRegionSound(float duration);
         void updateWaterSound();
@@ -270,6 +290,9 @@ namespace MWSound
         bool getSoundPlaying(const MWWorld::ConstPtr& reference, VFS::Path::NormalizedView fileName) const override;
         ///< Is the given sound currently playing on the given object?
 
+        void preloadSounds(std::span<const ESM::RefId> soundIds) override;
+        ///< Start decoding the given sounds in background, so they are ready before they are played.
+
         void pauseSounds(MWSound::BlockerType blocker, int types = int(Type::Mask)) override;
         ///< Pauses all currently playing sounds, including music.
 
@@ -289,6 +312,8 @@ namespace MWSound
         void updatePtr(const MWWorld::ConstPtr& old, const MWWorld::ConstPtr& updated) override;
 
         void clear() override;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
     };
 }
 
@@ -10,6 +10,8 @@
 
 #include "../mwbase/soundmanager.hpp"
 
+#include "sounddecoder.hpp"
+
 namespace MWSound
 {
     class SoundManager;
@@ -40,7 +42,9 @@ namespace MWSound
 
         virtual std::vector<std::string> enumerateHrtf() = 0;
 
-        virtual std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) = 0;
+        // Can be called from any thread, must not access the output device.
+        virtual DecodedSound decodeSound(VFS::Path::NormalizedView fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound* sound, Sound_Handle data, float offset) = 0;
@@ -48,6 +52,9 @@ namespace MWSound
         virtual void finishSound(Sound* sound) = 0;
         virtual bool isSoundPlaying(Sound* sound) = 0;
         virtual void updateSound(Sound* sound) = 0;
+        virtual float getSoundOffset(Sound* sound) = 0;
+        virtual float getSoundDuration(Sound_Handle data) = 0;
+        virtual std::size_t getSourceCount() const = 0;
 
         virtual bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false) = 0;
         virtual bool streamSound3D(DecoderPtr decoder, Stream* sound, bool getLoudnessData) = 0;
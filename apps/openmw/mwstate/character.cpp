@@ -10,9 +10,12 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm/defs.hpp>
 #include <components/esm3/esmreader.hpp>
+#include <components/files/compressedstream.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/utf8stream.hpp>
 
+#include "savewriter.hpp"
+
 bool MWState::operator<(const Slot& left, const Slot& right)
 {
     return left.mTimeStamp < right.mTimeStamp;
@@ -46,7 +49,7 @@ void MWState::Character::addSlot(const std::filesystem::path& path, const std::s
     slot.mTimeStamp = std::filesystem::last_write_time(path);
 
     ESM::ESMReader reader;
-    reader.open(slot.mPath);
+    reader.open(Files::openMaybeCompressedFileStream(slot.mPath, false), slot.mPath);
 
     if (reader.getRecName() != ESM::REC_SAVE)
         return; // invalid save file -> ignore
@@ -106,6 +109,10 @@ MWState::Character::Character(const std::filesystem::path& saves, const std::str
     {
         for (const auto& iter : std::filesystem::directory_iterator(mPath))
         {
+            // Left by an interrupted save
+            if (iter.path().extension() == temporarySaveExtension)
+                continue;
+
             try
             {
                 addSlot(iter, game);
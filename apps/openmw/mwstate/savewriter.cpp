@@ -0,0 +1,59 @@
+#include "savewriter.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <components/files/compressedstream.hpp>
+
+namespace MWState
+{
+    void writeSaveFile(const std::filesystem::path& path, std::string_view data, bool compress)
+    {
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += temporarySaveExtension;
+
+        try
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (compress)
+                Files::writeCompressedStream(stream, data);
+            else
+                stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            stream.close();
+
+            if (stream.fail())
+                throw std::runtime_error(
+                    "Write operation failed (file stream): " + std::generic_category().message(errno));
+
+            std::filesystem::rename(temporaryPath, path);
+        }
+        catch (...)
+        {
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            throw;
+        }
+    }
+
+    SaveWriteItem::SaveWriteItem(std::filesystem::path path, std::string&& data, bool compress)
+        : mPath(std::move(path))
+        , mData(std::move(data))
+        , mCompress(compress)
+    {
+    }
+
+    void SaveWriteItem::doWork()
+    {
+        try
+        {
+            writeSaveFile(mPath, mData, mCompress);
+        }
+        catch (const std::exception& e)
+        {
+            mError = e.what();
+        }
+        mData = std::string();
+    }
+}
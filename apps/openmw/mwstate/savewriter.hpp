@@ -0,0 +1,44 @@
+#ifndef GAME_STATE_SAVEWRITER_H
+#define GAME_STATE_SAVEWRITER_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <components/sceneutil/workqueue.hpp>
+
+namespace MWState
+{
+    /// Extension of the file a saved game is written to before it replaces the target file.
+    inline constexpr std::string_view temporarySaveExtension = ".tmp";
+
+    /// Writes \a data into a temporary file next to \a path and renames it to \a path when it's complete, so an
+    /// existing file stays intact if writing fails.
+    /// \param compress write the data in the format of Files::writeCompressedStream
+    /// \throw std::runtime_error or std::filesystem::filesystem_error on failure
+    void writeSaveFile(const std::filesystem::path& path, std::string_view data, bool compress);
+
+    /// Writes an already serialized saved game to the disk on a worker thread.
+    /// \note Serialization reads the live game state and stays on the main thread, only compression and the file
+    /// write are done here.
+    class SaveWriteItem final : public SceneUtil::WorkItem
+    {
+    public:
+        explicit SaveWriteItem(std::filesystem::path path, std::string&& data, bool compress);
+
+        void doWork() override;
+
+        const std::filesystem::path& getPath() const { return mPath; }
+
+        /// Empty if the file was successfully written. Should be called only when the item is done.
+        const std::string& getError() const { return mError; }
+
+    private:
+        const std::filesystem::path mPath;
+        std::string mData;
+        const bool mCompress;
+        std::string mError;
+    };
+}
+
+#endif
@@ -16,7 +16,9 @@
 
 #include <components/loadinglistener/loadinglistener.hpp>
 
+#include <components/files/compressedstream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/misc/algorithm.hpp>
 #include <components/settings/values.hpp>
 
@@ -52,6 +54,8 @@
 
 void MWState::StateManager::cleanup(bool force)
 {
+    completePendingSave(true);
+
     if (mState != State_NoGame || force)
     {
         MWBase::Environment::get().getSoundManager()->clear();
@@ -107,8 +111,21 @@ MWState::StateManager::StateManager(const std::filesystem::path& saves, const st
 {
 }
 
+MWState::StateManager::~StateManager()
+{
+    // Don't lose a saved game that is still being written. It should be already completed by requestQuit, so here
+    // the error can only be logged.
+    if (mPendingSave.has_value())
+    {
+        mPendingSave->mItem->waitTillDone();
+        if (!mPendingSave->mItem->getError().empty())
+            Log(Debug::Error) << "Failed to save game: " << mPendingSave->mItem->getError();
+    }
+}
+
 void MWState::StateManager::requestQuit()
 {
+    completePendingSave(true);
     mQuitRequest = true;
 }
 
@@ -208,8 +225,106 @@ void MWState::StateManager::resumeGame()
     MWBase::Environment::get().getLuaManager()->gameLoaded();
 }
 
+ESM::SavedGame MWState::StateManager::makeProfile(std::string_view description) const
+{
+    ESM::SavedGame profile;
+
+    MWBase::World& world = *MWBase::Environment::get().getWorld();
+
+    MWWorld::Ptr player = world.getPlayerPtr();
+
+    profile.mContentFiles = world.getContentFiles();
+
+    profile.mPlayerName = player.get<ESM::NPC>()->mBase->mName;
+    profile.mPlayerLevel = player.getClass().getNpcStats(player).getLevel();
+
+    const ESM::RefId& classId = player.get<ESM::NPC>()->mBase->mClass;
+    if (world.getStore().get<ESM::Class>().isDynamic(classId))
+        profile.mPlayerClassName = world.getStore().get<ESM::Class>().find(classId)->mName;
+    else
+        profile.mPlayerClassId = classId;
+
+    const MWMechanics::CreatureStats& stats = player.getClass().getCreatureStats(player);
+
+    profile.mPlayerCellName = world.getCellName();
+    profile.mInGameTime = world.getTimeManager()->getEpochTimeStamp();
+    profile.mTimePlayed = mTimePlayed;
+    profile.mDescription = description;
+    profile.mCurrentDay = world.getTimeManager()->getTimeStamp().getDay();
+    profile.mCurrentHealth = stats.getHealth().getCurrent();
+    profile.mMaximumHealth = stats.getHealth().getModified();
+
+    return profile;
+}
+
+void MWState::StateManager::writeGameState(
+    std::ostream& stream, const ESM::SavedGame& profile, Loading::Listener& listener) const
+{
+    // Make sure the animation state held by references is up to date before saving the game.
+    MWBase::Environment::get().getMechanicsManager()->persistAnimationStates();
+
+    ESM::ESMWriter writer;
+
+    for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
+        writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
+
+    writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+
+    // all unused
+    writer.setVersion(0);
+    writer.setType(0);
+    writer.setAuthor("");
+    writer.setDescription("");
+
+    size_t recordCount = 1 // saved game header
+        + MWBase::Environment::get().getJournal()->countSavedGameRecords()
+        + MWBase::Environment::get().getLuaManager()->countSavedGameRecords()
+        + MWBase::Environment::get().getWorld()->countSavedGameRecords()
+        + MWBase::Environment::get().getScriptManager()->getGlobalScripts().countSavedGameRecords()
+        + MWBase::Environment::get().getDialogueManager()->countSavedGameRecords()
+        + MWBase::Environment::get().getMechanicsManager()->countSavedGameRecords()
+        + MWBase::Environment::get().getInputManager()->countSavedGameRecords()
+        + MWBase::Environment::get().getWindowManager()->countSavedGameRecords();
+    writer.setRecordCount(static_cast<int>(recordCount));
+
+    writer.save(stream);
+
+    // Using only Cells for progress information, since they typically have the largest records by far
+    listener.setProgressRange(MWBase::Environment::get().getWorld()->countSavedGameCells());
+    listener.setLabel("#{OMWEngine:SavingInProgress}", true);
+
+    Loading::ScopedLoad load(&listener);
+
+    writer.startRecord(ESM::REC_SAVE);
+    profile.save(writer);
+    writer.endRecord(ESM::REC_SAVE);
+
+    MWBase::Environment::get().getJournal()->write(writer, listener);
+    MWBase::Environment::get().getDialogueManager()->write(writer, listener);
+    // LuaManager::write should be called before World::write because world also saves
+    // local scripts that depend on LuaManager.
+    MWBase::Environment::get().getLuaManager()->write(writer, listener);
+    MWBase::Environment::get().getWorld()->write(writer, listener);
+    MWBase::Environment::get().getScriptManager()->getGlobalScripts().write(writer, listener);
+    MWBase::Environment::get().getMechanicsManager()->write(writer, listener);
+    MWBase::Environment::get().getInputManager()->write(writer, listener);
+    MWBase::Environment::get().getWindowManager()->write(writer, listener);
+
+    // Ensure we have written the number of records that was estimated
+    if (static_cast<size_t>(writer.getRecordCount()) != recordCount + 1) // 1 extra for TES3 record
+        Log(Debug::Warning) << "Warning: number of written savegame records does not match. Estimated: "
+                            << recordCount + 1 << ", written: " << writer.getRecordCount();
+
+    writer.close();
+
+    if (stream.fail())
+        throw std::runtime_error("Write operation failed (memory stream): " + std::generic_category().message(errno));
+}
+
 void MWState::StateManager::saveGame(std::string_view description, const Slot* slot)
 {
+    completePendingSave(true);
+
     MWBase::Environment::get().getLuaManager()->applyDelayedActions();
 
     MWState::Character* character = getCurrentCharacter();
@@ -229,32 +344,7 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
             mCharacterManager.setCurrentCharacter(character);
         }
 
-        ESM::SavedGame profile;
-
-        MWBase::World& world = *MWBase::Environment::get().getWorld();
-
-        MWWorld::Ptr player = world.getPlayerPtr();
-
-        profile.mContentFiles = world.getContentFiles();
-
-        profile.mPlayerName = player.get<ESM::NPC>()->mBase->mName;
-        profile.mPlayerLevel = player.getClass().getNpcStats(player).getLevel();
-
-        const ESM::RefId& classId = player.get<ESM::NPC>()->mBase->mClass;
-        if (world.getStore().get<ESM::Class>().isDynamic(classId))
-            profile.mPlayerClassName = world.getStore().get<ESM::Class>().find(classId)->mName;
-        else
-            profile.mPlayerClassId = classId;
-
-        const MWMechanics::CreatureStats& stats = player.getClass().getCreatureStats(player);
-
-        profile.mPlayerCellName = world.getCellName();
-        profile.mInGameTime = world.getTimeManager()->getEpochTimeStamp();
-        profile.mTimePlayed = mTimePlayed;
-        profile.mDescription = description;
-        profile.mCurrentDay = world.getTimeManager()->getTimeStamp().getDay();
-        profile.mCurrentHealth = stats.getHealth().getCurrent();
-        profile.mMaximumHealth = stats.getHealth().getModified();
+        ESM::SavedGame profile = makeProfile(description);
 
         Log(Debug::Info) << "Making a screenshot for saved game '" << description << "'";
         writeScreenshot(profile.mScreenshot);
@@ -264,108 +354,99 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
         else
             slot = character->updateSlot(slot, profile);
 
-        // Make sure the animation state held by references is up to date before saving the game.
-        MWBase::Environment::get().getMechanicsManager()->persistAnimationStates();
-
         Log(Debug::Info) << "Writing saved game '" << description << "' for character '" << profile.mPlayerName << "'";
 
         // Write to a memory stream first. If there is an exception during the save process, we don't want to trash the
         // existing save file we are overwriting.
         std::stringstream stream;
 
-        ESM::ESMWriter writer;
-
-        for (const std::string& contentFile : MWBase::Environment::get().getWorld()->getContentFiles())
-            writer.addMaster(contentFile, 0); // not using the size information anyway -> use value of 0
-
-        writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
-
-        // all unused
-        writer.setVersion(0);
-        writer.setType(0);
-        writer.setAuthor("");
-        writer.setDescription("");
-
-        size_t recordCount = 1 // saved game header
-            + MWBase::Environment::get().getJournal()->countSavedGameRecords()
-            + MWBase::Environment::get().getLuaManager()->countSavedGameRecords()
-            + MWBase::Environment::get().getWorld()->countSavedGameRecords()
-            + MWBase::Environment::get().getScriptManager()->getGlobalScripts().countSavedGameRecords()
-            + MWBase::Environment::get().getDialogueManager()->countSavedGameRecords()
-            + MWBase::Environment::get().getMechanicsManager()->countSavedGameRecords()
-            + MWBase::Environment::get().getInputManager()->countSavedGameRecords()
-            + MWBase::Environment::get().getWindowManager()->countSavedGameRecords();
-        writer.setRecordCount(static_cast<int>(recordCount));
-
-        writer.save(stream);
-
-        Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
-        // Using only Cells for progress information, since they typically have the largest records by far
-        listener.setProgressRange(MWBase::Environment::get().getWorld()->countSavedGameCells());
-        listener.setLabel("#{OMWEngine:SavingInProgress}", true);
-
-        Loading::ScopedLoad load(&listener);
-
-        writer.startRecord(ESM::REC_SAVE);
-        slot->mProfile.save(writer);
-        writer.endRecord(ESM::REC_SAVE);
-
-        MWBase::Environment::get().getJournal()->write(writer, listener);
-        MWBase::Environment::get().getDialogueManager()->write(writer, listener);
-        // LuaManager::write should be called before World::write because world also saves
-        // local scripts that depend on LuaManager.
-        MWBase::Environment::get().getLuaManager()->write(writer, listener);
-        MWBase::Environment::get().getWorld()->write(writer, listener);
-        MWBase::Environment::get().getScriptManager()->getGlobalScripts().write(writer, listener);
-        MWBase::Environment::get().getMechanicsManager()->write(writer, listener);
-        MWBase::Environment::get().getInputManager()->write(writer, listener);
-        MWBase::Environment::get().getWindowManager()->write(writer, listener);
-
-        // Ensure we have written the number of records that was estimated
-        if (static_cast<size_t>(writer.getRecordCount()) != recordCount + 1) // 1 extra for TES3 record
-            Log(Debug::Warning) << "Warning: number of written savegame records does not match. Estimated: "
-                                << recordCount + 1 << ", written: " << writer.getRecordCount();
-
-        writer.close();
-
-        if (stream.fail())
-            throw std::runtime_error(
-                "Write operation failed (memory stream): " + std::generic_category().message(errno));
-
-        // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
+        writeGameState(stream, slot->mProfile, *MWBase::Environment::get().getWindowManager()->getLoadingScreen());
 
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream): " + std::generic_category().message(errno));
+        Log(Debug::Info) << '\'' << description << "' is serialized in "
+                         << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(
+                                std::chrono::steady_clock::now() - start)
+                                .count()
+                         << "ms";
 
-        Settings::saves().mCharacter.set(Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
-        mLastSavegame = slot->mPath;
+        // All good, write to file
+        if (Settings::saves().mAsyncWrite)
+        {
+            // The game state is already serialized, so compression and the file write don't stall the game
+            if (mSaveQueue == nullptr)
+                mSaveQueue = new SceneUtil::WorkQueue(1);
+            osg::ref_ptr<SaveWriteItem> item
+                = new SaveWriteItem(slot->mPath, std::move(stream).str(), Settings::saves().mCompression);
+            mSaveQueue->addWorkItem(item);
+            mPendingSave = PendingSave{ item, character, std::string(description), start };
+            return;
+        }
 
-        const auto finish = std::chrono::steady_clock::now();
+        writeSaveFile(slot->mPath, stream.view(), Settings::saves().mCompression);
 
-        Log(Debug::Info) << '\'' << description << "' is saved in "
-                         << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
-                         << "ms";
+        finishSave(slot->mPath, description, start);
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
+        reportSaveError(e.what(), character, slot);
+    }
+}
 
-        Log(Debug::Error) << error.str();
+void MWState::StateManager::finishSave(
+    const std::filesystem::path& path, std::string_view description, std::chrono::steady_clock::time_point start)
+{
+    Settings::saves().mCharacter.set(Files::pathToUnicodeString(path.parent_path().filename()));
+    mLastSavegame = path;
 
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{Interface:OK}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+    const auto finish = std::chrono::steady_clock::now();
 
-        // If no file was written, clean up the slot
-        if (character && slot && !std::filesystem::exists(slot->mPath))
-        {
-            character->deleteSlot(slot);
-            character->cleanup();
-        }
+    Log(Debug::Info) << '\'' << description << "' is saved in "
+                     << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
+                     << "ms";
+}
+
+void MWState::StateManager::reportSaveError(std::string_view message, Character* character, const Slot* slot)
+{
+    std::stringstream error;
+    error << "Failed to save game: " << message;
+
+    Log(Debug::Error) << error.str();
+
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{Interface:OK}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+    // If no file was written, clean up the slot
+    if (character && slot && !std::filesystem::exists(slot->mPath))
+    {
+        character->deleteSlot(slot);
+        character->cleanup();
+    }
+}
+
+void MWState::StateManager::completePendingSave(bool wait)
+{
+    if (!mPendingSave.has_value() || (!wait && !mPendingSave->mItem->isDone()))
+        return;
+
+    mPendingSave->mItem->waitTillDone();
+    const PendingSave save = std::move(*mPendingSave);
+    mPendingSave.reset();
+
+    const std::filesystem::path& path = save.mItem->getPath();
+    if (save.mItem->getError().empty())
+    {
+        finishSave(path, save.mDescription, save.mStart);
+        return;
+    }
+
+    const Slot* slot = nullptr;
+    if (save.mCharacter != nullptr)
+    {
+        for (const Slot& v : *save.mCharacter)
+            if (v.mPath == path)
+                slot = &v;
     }
+    reportSaveError(save.mItem->getError(), save.mCharacter, slot);
 }
 
 void MWState::StateManager::quickSave(std::string name)
@@ -448,218 +529,225 @@ struct SaveVersionTooNewError : SaveFormatVersionError
     }
 };
 
-void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
+void MWState::StateManager::loadGameState(ESM::ESMReader& reader, const Character* character,
+    const std::filesystem::path& savegame, Loading::Listener& listener)
 {
-    try
-    {
-        cleanup();
-
-        Log(Debug::Info) << "Reading save file " << filepath.filename();
-
-        ESM::ESMReader reader;
-        reader.open(filepath);
-
-        ESM::FormatVersion version = reader.getFormatVersion();
-        if (version > ESM::CurrentSaveGameFormatVersion)
-            throw SaveVersionTooNewError(version);
-        else if (version < ESM::MinSupportedSaveGameFormatVersion)
-            throw SaveVersionTooOldError(version);
+    ESM::FormatVersion version = reader.getFormatVersion();
+    if (version > ESM::CurrentSaveGameFormatVersion)
+        throw SaveVersionTooNewError(version);
+    else if (version < ESM::MinSupportedSaveGameFormatVersion)
+        throw SaveVersionTooOldError(version);
 
-        std::map<int, int> contentFileMap = buildContentFileIndexMap(reader);
-        reader.setContentFileMapping(&contentFileMap);
-        MWBase::Environment::get().getLuaManager()->setContentFileMapping(contentFileMap);
+    std::map<int, int> contentFileMap = buildContentFileIndexMap(reader);
+    reader.setContentFileMapping(&contentFileMap);
+    MWBase::Environment::get().getLuaManager()->setContentFileMapping(contentFileMap);
 
-        ESM::ActorIdConverter actorIdConverter;
-        if (version <= ESM::MaxActorIdSaveGameFormatVersion)
-            reader.mActorIdConverter = &actorIdConverter;
+    ESM::ActorIdConverter actorIdConverter;
+    if (version <= ESM::MaxActorIdSaveGameFormatVersion)
+        reader.mActorIdConverter = &actorIdConverter;
 
-        Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
+    listener.setProgressRange(100);
+    listener.setLabel("#{OMWEngine:LoadingInProgress}");
 
-        listener.setProgressRange(100);
-        listener.setLabel("#{OMWEngine:LoadingInProgress}");
+    Loading::ScopedLoad load(&listener);
 
-        Loading::ScopedLoad load(&listener);
+    bool firstPersonCam = false;
 
-        bool firstPersonCam = false;
+    size_t total = reader.getFileSize();
+    int currentPercent = 0;
+    while (reader.hasMoreRecs())
+    {
+        ESM::NAME n = reader.getRecName();
+        reader.getRecHeader();
 
-        size_t total = reader.getFileSize();
-        int currentPercent = 0;
-        while (reader.hasMoreRecs())
+        switch (n.toInt())
         {
-            ESM::NAME n = reader.getRecName();
-            reader.getRecHeader();
-
-            switch (n.toInt())
+            case ESM::REC_SAVE:
             {
-                case ESM::REC_SAVE:
+                ESM::SavedGame profile;
+                profile.load(reader);
+                const auto& selectedContentFiles = MWBase::Environment::get().getWorld()->getContentFiles();
+                auto missingFiles = profile.getMissingContentFiles(selectedContentFiles);
+                if (!missingFiles.empty() && !confirmLoading(missingFiles))
                 {
-                    ESM::SavedGame profile;
-                    profile.load(reader);
-                    const auto& selectedContentFiles = MWBase::Environment::get().getWorld()->getContentFiles();
-                    auto missingFiles = profile.getMissingContentFiles(selectedContentFiles);
-                    if (!missingFiles.empty() && !confirmLoading(missingFiles))
-                    {
-                        cleanup(true);
-                        MWBase::Environment::get().getWindowManager()->pushGuiMode(MWGui::GM_MainMenu);
-                        return;
-                    }
-                    mTimePlayed = profile.mTimePlayed;
-                    Log(Debug::Info) << "Loading saved game '" << profile.mDescription << "' for character '"
-                                     << profile.mPlayerName << "'";
+                    cleanup(true);
+                    MWBase::Environment::get().getWindowManager()->pushGuiMode(MWGui::GM_MainMenu);
+                    return;
                 }
+                mTimePlayed = profile.mTimePlayed;
+                Log(Debug::Info) << "Loading saved game '" << profile.mDescription << "' for character '"
+                                 << profile.mPlayerName << "'";
+            }
+            break;
+
+            case ESM::REC_JOUR:
+            case ESM::REC_QUES:
+
+                MWBase::Environment::get().getJournal()->readRecord(reader, n.toInt());
                 break;
 
-                case ESM::REC_JOUR:
-                case ESM::REC_QUES:
-
-                    MWBase::Environment::get().getJournal()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_DIAS:
-
-                    MWBase::Environment::get().getDialogueManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_ALCH:
-                case ESM::REC_MISC:
-                case ESM::REC_ACTI:
-                case ESM::REC_ARMO:
-                case ESM::REC_BOOK:
-                case ESM::REC_CLAS:
-                case ESM::REC_CLOT:
-                case ESM::REC_ENCH:
-                case ESM::REC_NPC_:
-                case ESM::REC_SPEL:
-                case ESM::REC_WEAP:
-                case ESM::REC_GLOB:
-                case ESM::REC_PLAY:
-                case ESM::REC_CSTA:
-                case ESM::REC_WTHR:
-                case ESM::REC_DYNA:
-                case ESM::REC_ACTC:
-                case ESM::REC_PROJ:
-                case ESM::REC_MPRJ:
-                case ESM::REC_ENAB:
-                case ESM::REC_LEVC:
-                case ESM::REC_LEVI:
-                case ESM::REC_LIGH:
-                case ESM::REC_CREA:
-                case ESM::REC_CONT:
-                case ESM::REC_RAND:
-                case ESM::REC_STAT:
-                case ESM::REC_DOOR:
-                case ESM::REC_PROB:
-                case ESM::REC_INGR:
-                    MWBase::Environment::get().getWorld()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_CAM_:
-                    reader.getHNT(firstPersonCam, "FIRS");
-                    break;
-
-                case ESM::REC_GSCR:
-
-                    MWBase::Environment::get().getScriptManager()->getGlobalScripts().readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_GMAP:
-                case ESM::REC_KEYS:
-                case ESM::REC_ASPL:
-                case ESM::REC_MARK:
-
-                    MWBase::Environment::get().getWindowManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_DCOU:
-                case ESM::REC_STLN:
-
-                    MWBase::Environment::get().getMechanicsManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_INPU:
-                    MWBase::Environment::get().getInputManager()->readRecord(reader, n.toInt());
-                    break;
-
-                case ESM::REC_LUAM:
-                    MWBase::Environment::get().getLuaManager()->readRecord(reader, n.toInt());
-                    break;
-
-                default:
-
-                    // ignore invalid records
-                    Log(Debug::Warning) << "Warning: Ignoring unknown record: " << n.toStringView();
-                    reader.skipRecord();
-            }
-            int progressPercent = static_cast<int>(float(reader.getFileOffset()) / total * 100);
-            if (progressPercent > currentPercent)
-            {
-                listener.increaseProgress(progressPercent - currentPercent);
-                currentPercent = progressPercent;
-            }
-        }
-        mCharacterManager.setCurrentCharacter(character);
+            case ESM::REC_DIAS:
 
-        mState = State_Running;
+                MWBase::Environment::get().getDialogueManager()->readRecord(reader, n.toInt());
+                break;
+
+            case ESM::REC_ALCH:
+            case ESM::REC_MISC:
+            case ESM::REC_ACTI:
+            case ESM::REC_ARMO:
+            case ESM::REC_BOOK:
+            case ESM::REC_CLAS:
+            case ESM::REC_CLOT:
+            case ESM::REC_ENCH:
+            case ESM::REC_NPC_:
+            case ESM::REC_SPEL:
+            case ESM::REC_WEAP:
+            case ESM::REC_GLOB:
+            case ESM::REC_PLAY:
+            case ESM::REC_CSTA:
+            case ESM::REC_WTHR:
+            case ESM::REC_DYNA:
+            case ESM::REC_ACTC:
+            case ESM::REC_PROJ:
+            case ESM::REC_MPRJ:
+            case ESM::REC_ENAB:
+            case ESM::REC_LEVC:
+            case ESM::REC_LEVI:
+            case ESM::REC_LIGH:
+            case ESM::REC_CREA:
+            case ESM::REC_CONT:
+            case ESM::REC_RAND:
+            case ESM::REC_STAT:
+            case ESM::REC_DOOR:
+            case ESM::REC_PROB:
+            case ESM::REC_INGR:
+                MWBase::Environment::get().getWorld()->readRecord(reader, n.toInt());
+                break;
+
+            case ESM::REC_CAM_:
+                reader.getHNT(firstPersonCam, "FIRS");
+                break;
 
-        if (character)
-            Settings::saves().mCharacter.set(Files::pathToUnicodeString(character->getPath().filename()));
-        mLastSavegame = filepath;
+            case ESM::REC_GSCR:
 
-        MWBase::Environment::get().getWindowManager()->setNewGame(false);
-        MWBase::Environment::get().getWorld()->saveLoaded(reader);
-        actorIdConverter.apply();
-        MWBase::Environment::get().getWorld()->setupPlayer();
-        MWBase::Environment::get().getWorld()->renderPlayer();
-        MWBase::Environment::get().getWindowManager()->updatePlayer();
-        MWBase::Environment::get().getMechanicsManager()->playerLoaded();
-        MWBase::Environment::get().getWorld()->toggleVanityMode(false);
+                MWBase::Environment::get().getScriptManager()->getGlobalScripts().readRecord(reader, n.toInt());
+                break;
 
-        if (firstPersonCam != MWBase::Environment::get().getWorld()->isFirstPerson())
-            MWBase::Environment::get().getWorld()->togglePOV();
+            case ESM::REC_GMAP:
+            case ESM::REC_KEYS:
+            case ESM::REC_ASPL:
+            case ESM::REC_MARK:
 
-        MWWorld::ConstPtr ptr = MWMechanics::getPlayer();
+                MWBase::Environment::get().getWindowManager()->readRecord(reader, n.toInt());
+                break;
 
-        if (ptr.isInCell())
-        {
-            const ESM::RefId cellId = ptr.getCell()->getCell()->getId();
+            case ESM::REC_DCOU:
+            case ESM::REC_STLN:
+
+                MWBase::Environment::get().getMechanicsManager()->readRecord(reader, n.toInt());
+                break;
+
+            case ESM::REC_INPU:
+                MWBase::Environment::get().getInputManager()->readRecord(reader, n.toInt());
+                break;
+
+            case ESM::REC_LUAM:
+                MWBase::Environment::get().getLuaManager()->readRecord(reader, n.toInt());
+                break;
 
-            // Use detectWorldSpaceChange=false, otherwise some of the data we just loaded would be cleared again
-            MWBase::Environment::get().getWorld()->changeToCell(cellId, ptr.getRefData().getPosition(), false, false);
+            default:
+
+                // ignore invalid records
+                Log(Debug::Warning) << "Warning: Ignoring unknown record: " << n.toStringView();
+                reader.skipRecord();
         }
-        else
+        int progressPercent = static_cast<int>(float(reader.getFileOffset()) / total * 100);
+        if (progressPercent > currentPercent)
         {
-            // Cell no longer exists (i.e. changed game files), choose a default cell
-            Log(Debug::Warning) << "Player character's cell no longer exists, changing to the default cell";
-            ESM::ExteriorCellLocation cellIndex(0, 0, ESM::Cell::sDefaultWorldspaceId);
-            MWWorld::CellStore& cell = MWBase::Environment::get().getWorldModel()->getExterior(cellIndex);
-            const osg::Vec2f posFromIndex = ESM::indexToPosition(cellIndex, false);
-            ESM::Position pos;
-            pos.pos[0] = posFromIndex.x();
-            pos.pos[1] = posFromIndex.y();
-            pos.pos[2] = 0; // should be adjusted automatically (adjustPlayerPos=true)
-            pos.rot[0] = 0;
-            pos.rot[1] = 0;
-            pos.rot[2] = 0;
-            MWBase::Environment::get().getWorld()->changeToCell(cell.getCell()->getId(), pos, true, false);
+            listener.increaseProgress(progressPercent - currentPercent);
+            currentPercent = progressPercent;
         }
+    }
+    mCharacterManager.setCurrentCharacter(character);
 
-        MWBase::Environment::get().getWorld()->updateProjectilesCasters();
+    mState = State_Running;
 
-        // Vanilla MW will restart startup scripts when a save game is loaded. This is unintuitive,
-        // but some mods may be using it as a reload detector.
-        MWBase::Environment::get().getScriptManager()->getGlobalScripts().addStartup();
+    if (character)
+        Settings::saves().mCharacter.set(Files::pathToUnicodeString(character->getPath().filename()));
+    mLastSavegame = savegame;
 
-        // Since we passed "changeEvent=false" to changeCell, we shouldn't have triggered the cell change flag.
-        // But make sure the flag is cleared anyway in case it was set from an earlier game.
-        MWBase::Environment::get().getWorldScene()->markCellAsUnchanged();
+    MWBase::Environment::get().getWindowManager()->setNewGame(false);
+    MWBase::Environment::get().getWorld()->saveLoaded(reader);
+    actorIdConverter.apply();
+    MWBase::Environment::get().getWorld()->setupPlayer();
+    MWBase::Environment::get().getWorld()->renderPlayer();
+    MWBase::Environment::get().getWindowManager()->updatePlayer();
+    MWBase::Environment::get().getMechanicsManager()->playerLoaded();
+    MWBase::Environment::get().getWorld()->toggleVanityMode(false);
 
-        MWBase::Environment::get().getLuaManager()->gameLoaded();
-        for (int actorId : actorIdConverter.mGraveyard)
-        {
-            auto mapped = actorIdConverter.mMappings.find(actorId);
-            if (mapped != actorIdConverter.mMappings.end())
-                MWBase::Environment::get().getMechanicsManager()->cleanupSummonedCreature(mapped->second);
-        }
+    if (firstPersonCam != MWBase::Environment::get().getWorld()->isFirstPerson())
+        MWBase::Environment::get().getWorld()->togglePOV();
+
+    MWWorld::ConstPtr ptr = MWMechanics::getPlayer();
+
+    if (ptr.isInCell())
+    {
+        const ESM::RefId cellId = ptr.getCell()->getCell()->getId();
+
+        // Use detectWorldSpaceChange=false, otherwise some of the data we just loaded would be cleared again
+        MWBase::Environment::get().getWorld()->changeToCell(cellId, ptr.getRefData().getPosition(), false, false);
+    }
+    else
+    {
+        // Cell no longer exists (i.e. changed game files), choose a default cell
+        Log(Debug::Warning) << "Player character's cell no longer exists, changing to the default cell";
+        ESM::ExteriorCellLocation cellIndex(0, 0, ESM::Cell::sDefaultWorldspaceId);
+        MWWorld::CellStore& cell = MWBase::Environment::get().getWorldModel()->getExterior(cellIndex);
+        const osg::Vec2f posFromIndex = ESM::indexToPosition(cellIndex, false);
+        ESM::Position pos;
+        pos.pos[0] = posFromIndex.x();
+        pos.pos[1] = posFromIndex.y();
+        pos.pos[2] = 0; // should be adjusted automatically (adjustPlayerPos=true)
+        pos.rot[0] = 0;
+        pos.rot[1] = 0;
+        pos.rot[2] = 0;
+        MWBase::Environment::get().getWorld()->changeToCell(cell.getCell()->getId(), pos, true, false);
+    }
+
+    MWBase::Environment::get().getWorld()->updateProjectilesCasters();
+
+    // Vanilla MW will restart startup scripts when a save game is loaded. This is unintuitive,
+    // but some mods may be using it as a reload detector.
+    MWBase::Environment::get().getScriptManager()->getGlobalScripts().addStartup();
+
+    // Since we passed "changeEvent=false" to changeCell, we shouldn't have triggered the cell change flag.
+    // But make sure the flag is cleared anyway in case it was set from an earlier game.
+    MWBase::Environment::get().getWorldScene()->markCellAsUnchanged();
+
+    MWBase::Environment::get().getLuaManager()->gameLoaded();
+    for (int actorId : actorIdConverter.mGraveyard)
+    {
+        auto mapped = actorIdConverter.mMappings.find(actorId);
+        if (mapped != actorIdConverter.mMappings.end())
+            MWBase::Environment::get().getMechanicsManager()->cleanupSummonedCreature(mapped->second);
+    }
+}
+
+void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
+{
+    completePendingSave(true);
+
+    try
+    {
+        cleanup();
+
+        Log(Debug::Info) << "Reading save file " << filepath.filename();
+
+        ESM::ESMReader reader;
+        // Compressed saved games are decompressed on a separate thread while the records are loaded
+        reader.open(Files::openMaybeCompressedFileStream(filepath, true), filepath);
+
+        loadGameState(reader, character, filepath, *MWBase::Environment::get().getWindowManager()->getLoadingScreen());
     }
     catch (const SaveVersionTooNewError& e)
     {
@@ -689,6 +777,91 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
     }
 }
 
+void MWState::StateManager::saveSnapshot(std::string_view name)
+{
+    if (mState != State_Running)
+        throw std::runtime_error("Can't save a snapshot without a running game");
+
+    MWBase::Environment::get().getLuaManager()->applyDelayedActions();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::ostringstream stream;
+    Loading::Listener listener;
+    writeGameState(stream, makeProfile(name), listener);
+    Snapshot snapshot;
+    snapshot.mGameState = std::move(stream).str();
+    MWBase::Environment::get().getLuaManager()->makeStorageSnapshot(
+        snapshot.mGlobalStorage, snapshot.mPlayerStorage);
+    mSnapshots.insert_or_assign(std::string(name), std::move(snapshot));
+
+    const auto finish = std::chrono::steady_clock::now();
+
+    Log(Debug::Info) << "Snapshot '" << name << "' is saved in "
+                        << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
+                        << "ms";
+}
+
+void MWState::StateManager::restoreSnapshot(std::string_view name)
+{
+    const auto it = mSnapshots.find(name);
+    if (it == mSnapshots.end())
+    {
+        Log(Debug::Error) << "Failed to restore snapshot '" << name << "': snapshot is not found";
+        return;
+    }
+
+    completePendingSave(true);
+
+    // Restoring a snapshot doesn't change the current character and the last saved game
+    const Character* const character = getCurrentCharacter();
+    const std::filesystem::path lastSavegame = mLastSavegame;
+
+    try
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        // The snapshot is loaded like a saved game, so the world is rebuilt from scratch
+        cleanup();
+
+        const Snapshot& snapshot = it->second;
+
+        // Restored before the game state, so the scripts see the storage of the snapshot in onLoad
+        MWBase::Environment::get().getLuaManager()->restoreStorageSnapshot(
+            snapshot.mGlobalStorage, snapshot.mPlayerStorage);
+
+        ESM::ESMReader reader;
+        reader.open(
+            std::make_unique<Files::IMemStream>(snapshot.mGameState.data(), snapshot.mGameState.size()), it->first);
+
+        Loading::Listener listener;
+        loadGameState(reader, character, lastSavegame, listener);
+
+        const auto finish = std::chrono::steady_clock::now();
+
+        Log(Debug::Info)
+            << "Snapshot '" << name << "' is restored in "
+            << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count() << "ms";
+    }
+    catch (const std::exception& e)
+    {
+        std::string error = "#{OMWEngine:LoadingFailed}: " + std::string(e.what());
+        printSavegameFormatError(e.what(), error);
+    }
+}
+
+bool MWState::StateManager::hasSnapshot(std::string_view name) const
+{
+    return mSnapshots.contains(name);
+}
+
+void MWState::StateManager::deleteSnapshot(std::string_view name)
+{
+    const auto it = mSnapshots.find(name);
+    if (it != mSnapshots.end())
+        mSnapshots.erase(it);
+}
+
 void MWState::StateManager::printSavegameFormatError(
     const std::string& exceptionText, const std::string& messageBoxText)
 {
@@ -717,6 +890,8 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    completePendingSave(true);
+
     const std::filesystem::path savePath = slot->mPath;
     mCharacterManager.deleteSlot(slot, character);
     if (mLastSavegame == savePath)
@@ -747,6 +922,8 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    completePendingSave(false);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
@@ -787,6 +964,12 @@ void MWState::StateManager::update(float duration)
         loadGame(character, mLoadRequest->second);
         mLoadRequest = std::nullopt;
     }
+
+    if (mRestoreSnapshotRequest.has_value())
+    {
+        restoreSnapshot(*mRestoreSnapshotRequest);
+        mRestoreSnapshotRequest = std::nullopt;
+    }
 }
 
 bool MWState::StateManager::confirmLoading(const std::vector<std::string_view>& missingFiles) const
@@ -1,13 +1,34 @@
 #ifndef GAME_STATE_STATEMANAGER_H
 #define GAME_STATE_STATEMANAGER_H
 
+#include <chrono>
 #include <filesystem>
+#include <iosfwd>
 #include <map>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 
+#include <osg/ref_ptr>
+
+#include <components/lua/storagesnapshot.hpp>
+
 #include "../mwbase/statemanager.hpp"
 
 #include "charactermanager.hpp"
+#include "savewriter.hpp"
+
+namespace ESM
+{
+    class ESMReader;
+    struct SavedGame;
+}
+
+namespace Loading
+{
+    class Listener;
+}
 
 namespace MWState
 {
@@ -19,17 +40,53 @@ namespace MWState
             bool mBypass;
         };
 
+        struct Snapshot
+        {
+            std::string mGameState;
+            LuaUtil::StorageSnapshot mGlobalStorage;
+            LuaUtil::StorageSnapshot mPlayerStorage;
+        };
+
+        struct PendingSave
+        {
+            osg::ref_ptr<SaveWriteItem> mItem;
+            Character* mCharacter;
+            std::string mDescription;
+            std::chrono::steady_clock::time_point mStart;
+        };
+
         bool mQuitRequest;
         bool mAskLoadRecent;
         std::optional<NewGameRequest> mNewGameRequest;
         std::optional<std::pair<const Character*, std::filesystem::path>> mLoadRequest;
+        std::optional<std::string> mRestoreSnapshotRequest;
         State mState;
         CharacterManager mCharacterManager;
         double mTimePlayed;
         std::filesystem::path mLastSavegame;
+        osg::ref_ptr<SceneUtil::WorkQueue> mSaveQueue;
+        std::optional<PendingSave> mPendingSave;
+        std::map<std::string, Snapshot, std::less<>> mSnapshots;
 
         void cleanup(bool force = false);
 
+        ESM::SavedGame makeProfile(std::string_view description) const;
+
+        /// Writes the state of the running game in the saved game format.
+        void writeGameState(std::ostream& stream, const ESM::SavedGame& profile, Loading::Listener& listener) const;
+
+        /// Reads the state of the game written by writeGameState, the game should be cleaned up before.
+        void loadGameState(ESM::ESMReader& reader, const Character* character, const std::filesystem::path& savegame,
+            Loading::Listener& listener);
+
+        void finishSave(const std::filesystem::path& path, std::string_view description,
+            std::chrono::steady_clock::time_point start);
+
+        void reportSaveError(std::string_view message, Character* character, const Slot* slot);
+
+        /// Handles the result of a saved game written in background, if \a wait is false only when it's complete.
+        void completePendingSave(bool wait);
+
         void printSavegameFormatError(const std::string& exceptionText, const std::string& messageBoxText);
 
         bool confirmLoading(const std::vector<std::string_view>& missingFiles) const;
@@ -41,6 +98,8 @@ namespace MWState
     public:
         StateManager(const std::filesystem::path& saves, const std::vector<std::string>& contentFiles);
 
+        ~StateManager() override;
+
         void requestQuit() override;
 
         bool hasQuitRequest() const override;
@@ -91,6 +150,18 @@ namespace MWState
         void loadGame(const Character* character, const std::filesystem::path& filepath) override;
         ///< Load a saved game file belonging to the given character.
 
+        void saveSnapshot(std::string_view name) override;
+        ///< Write the state of the running game into memory, replacing the snapshot with the same name.
+
+        void requestRestoreSnapshot(std::string_view name) override { mRestoreSnapshotRequest = std::string(name); }
+
+        void restoreSnapshot(std::string_view name) override;
+        ///< Replace the state of the game by the snapshot, doesn't change the current character.
+
+        bool hasSnapshot(std::string_view name) const override;
+
+        void deleteSnapshot(std::string_view name) override;
+
         Character* getCurrentCharacter() override;
         ///< @note May return null.
 
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <atomic>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <span>
 
 #include <osg/Stats>
@@ -21,12 +23,17 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/view.hpp>
 #include <components/terrain/world.hpp>
+#include <components/toutf8/toutf8.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/soundmanager.hpp"
+
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
 #include "class.hpp"
+#include "esmstore.hpp"
 
 namespace MWWorld
 {
@@ -62,6 +69,18 @@ namespace MWWorld
         std::vector<VFS::Path::NormalizedView>& mOut;
     };
 
+    struct ListSoundsVisitor
+    {
+        bool operator()(const MWWorld::ConstPtr& ptr)
+        {
+            ptr.getClass().getSoundsToPreload(ptr, mOut);
+
+            return true;
+        }
+
+        std::vector<ESM::RefId>& mOut;
+    };
+
     /// Worker thread item: preload models in a cell.
     class PreloadItem : public SceneUtil::WorkItem
     {
@@ -166,6 +185,41 @@ namespace MWWorld
         std::set<osg::ref_ptr<const osg::Object>> mPreloadedObjects;
     };
 
+    /// Worker thread item: read references of a cell from content files.
+    class ReadRefsItem : public SceneUtil::WorkItem
+    {
+    public:
+        /// Constructor to be called from the main thread.
+        explicit ReadRefsItem(const ESM::Cell& cell, const ESMStore& store, const ToUTF8::Utf8Encoder* encoder)
+            : mCell(cell)
+            , mStore(store)
+            , mAbort(false)
+        {
+            // The encoder has an internal buffer, so every item needs its own one.
+            if (encoder != nullptr)
+                mEncoder.emplace(*encoder);
+        }
+
+        void abort() override { mAbort = true; }
+
+        void doWork() override
+        {
+            if (mAbort)
+                return;
+            mRefs = CellStore::prepareRefs(mCell, mStore, mEncoder.has_value() ? &*mEncoder : nullptr);
+        }
+
+        /// To be called from the main thread once the item is done.
+        std::shared_ptr<CellStore::PreparedRefs> takeRefs() { return std::move(mRefs); }
+
+    private:
+        const ESM::Cell& mCell;
+        const ESMStore& mStore;
+        std::optional<ToUTF8::Utf8Encoder> mEncoder;
+        std::atomic<bool> mAbort;
+        std::shared_ptr<CellStore::PreparedRefs> mRefs;
+    };
+
     class TerrainPreloadItem : public SceneUtil::WorkItem
     {
     public:
@@ -243,7 +297,14 @@ namespace MWWorld
             Log(Debug::Error) << "Error: can't preload, no work queue set";
             return;
         }
-        if (cell.getState() == CellStore::State_Unloaded)
+        bool readRefs = mPreloadReferences && cell.getState() != CellStore::State_Loaded;
+        if (readRefs && cell.getCell()->isEsm4())
+        {
+            // References of ESM4 cells are read only by the main thread.
+            cell.load();
+            readRefs = false;
+        }
+        if (cell.getState() == CellStore::State_Unloaded && !readRefs)
         {
             Log(Debug::Error) << "Error: can't preload objects for unloaded cell";
             return;
@@ -282,12 +343,37 @@ namespace MWWorld
                 return;
         }
 
+        if (readRefs)
+        {
+            // The cell is loaded and its objects are preloaded by updateCache once the references are read.
+            osg::ref_ptr<ReadRefsItem> item(new ReadRefsItem(
+                cell.getCell()->getEsm3(), *MWBase::Environment::get().getESMStore(), mEncoder));
+            mWorkQueue->addWorkItem(item);
+
+            PreloadEntry entry(timestamp, item);
+            entry.mReadRefsItem = std::move(item);
+            mPreloadCells.emplace(&cell, std::move(entry));
+        }
+        else
+            mPreloadCells.emplace(&cell, PreloadEntry(timestamp, startPreloading(cell)));
+        ++mAdded;
+    }
+
+    osg::ref_ptr<SceneUtil::WorkItem> CellPreloader::startPreloading(CellStore& cell)
+    {
         osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
             mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
         mWorkQueue->addWorkItem(item);
 
-        mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
-        ++mAdded;
+        // Sounds are decoded by the sound manager's own background thread
+        std::vector<ESM::RefId> sounds;
+        ListSoundsVisitor visitor{ sounds };
+        cell.forEachConst(visitor);
+        std::sort(sounds.begin(), sounds.end());
+        sounds.erase(std::unique(sounds.begin(), sounds.end()), sounds.end());
+        MWBase::Environment::get().getSoundManager()->preloadSounds(sounds);
+
+        return item;
     }
 
     void CellPreloader::notifyLoaded(CellStore* cell)
@@ -322,6 +408,22 @@ namespace MWWorld
 
     void CellPreloader::updateCache(double timestamp)
     {
+        for (auto& [cell, entry] : mPreloadCells)
+        {
+            if (entry.mReadRefsItem == nullptr || !entry.mReadRefsItem->isDone())
+                continue;
+
+            // The cell could be loaded by something else in the meantime.
+            if (cell->getState() != CellStore::State_Loaded)
+            {
+                cell->setPreparedRefs(entry.mReadRefsItem->takeRefs());
+                cell->load();
+            }
+
+            entry.mReadRefsItem = nullptr;
+            entry.mWorkItem = startPreloading(*cell);
+        }
+
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
         {
             if (mPreloadCells.size() >= mMinCacheSize && it->second.mTimeStamp < timestamp - mExpiryDelay)
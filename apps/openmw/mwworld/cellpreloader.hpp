@@ -37,10 +37,16 @@ namespace Loading
     class Listener;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class CellStore;
     class TerrainPreloadItem;
+    class ReadRefsItem;
 
     class CellPreloader
     {
@@ -50,7 +56,8 @@ namespace MWWorld
         ~CellPreloader();
 
         /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
-        /// @note The cell itself must be in State_Loaded or State_Preloaded.
+        /// @note The cell itself must be in State_Loaded or State_Preloaded unless references preloading is enabled,
+        /// then the references are read by a background thread and the cell is loaded by updateCache.
         void preload(MWWorld::CellStore& cell, double timestamp);
 
         void notifyLoaded(MWWorld::CellStore* cell);
@@ -72,6 +79,12 @@ namespace MWWorld
         /// Enables the creation of instances in the preloading thread.
         void setPreloadInstances(bool preload);
 
+        /// Enables reading of cell references in the preloading thread.
+        void setPreloadReferences(bool preload) { mPreloadReferences = preload; }
+
+        /// Encoder of the content files, a copy is used by every background task.
+        void setEncoder(const ToUTF8::Utf8Encoder* encoder) { mEncoder = encoder; }
+
         std::size_t getMaxCacheSize() const { return mMaxCacheSize; }
 
         std::size_t getCacheSize() const { return mPreloadCells.size(); }
@@ -90,6 +103,8 @@ namespace MWWorld
     private:
         void clearAllTasks();
 
+        osg::ref_ptr<SceneUtil::WorkItem> startPreloading(MWWorld::CellStore& cell);
+
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
         Terrain::World* mTerrain;
@@ -99,6 +114,8 @@ namespace MWWorld
         std::size_t mMinCacheSize = 0;
         std::size_t mMaxCacheSize = 0;
         bool mPreloadInstances;
+        bool mPreloadReferences = false;
+        const ToUTF8::Utf8Encoder* mEncoder = nullptr;
 
         double mLastResourceCacheUpdate;
 
@@ -116,8 +133,10 @@ namespace MWWorld
 
             double mTimeStamp;
             osg::ref_ptr<SceneUtil::WorkItem> mWorkItem;
+            // Same as mWorkItem while the references of the cell are being read.
+            osg::ref_ptr<ReadRefsItem> mReadRefsItem;
         };
-        typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
+        typedef std::map<MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
         // Cells that are currently being preloaded, or have already finished preloading
         PreloadMap mPreloadCells;
@@ -62,12 +62,14 @@ namespace MWWorld
             }
             refNum = lastAssignedRefNum;
             mChanged = true;
+            mUnsavedChanges.mark();
         }
         return refNum;
     }
 
     void CellRef::setRefNum(ESM::RefNum refNum)
     {
+        mUnsavedChanges.mark();
         std::visit(ESM::VisitOverload{
                        [&](ESM4::Reference& ref) { ref.mId = refNum; },
                        [&](ESM4::ActorCharacter& ref) { ref.mId = refNum; },
@@ -123,6 +125,7 @@ namespace MWWorld
         if (scale != getScale())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit([scale](auto&& ref) { ref.mScale = scale; }, mCellRef.mVariant);
         }
     }
@@ -130,6 +133,7 @@ namespace MWWorld
     void CellRef::setPosition(const ESM::Position& position)
     {
         mChanged = true;
+        mUnsavedChanges.mark();
         std::visit([&position](auto&& ref) { ref.mPos = position; }, mCellRef.mVariant);
     }
 
@@ -165,6 +169,7 @@ namespace MWWorld
         if (charge != getEnchantmentCharge())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
 
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
@@ -177,6 +182,7 @@ namespace MWWorld
 
     void CellRef::setCharge(int charge)
     {
+        mUnsavedChanges.mark();
         std::visit(ESM::VisitOverload{
                        [&](ESM4::Reference& /*ref*/) {},
                        [&](ESM4::ActorCharacter&) {},
@@ -187,6 +193,7 @@ namespace MWWorld
 
     void CellRef::applyChargeRemainderToBeSubtracted(float chargeRemainder)
     {
+        mUnsavedChanges.mark();
         auto esm3Visit = [&](ESM::CellRef& cellRef3) {
             cellRef3.mChargeIntRemainder -= std::abs(chargeRemainder);
             if (cellRef3.mChargeIntRemainder <= -1.0f)
@@ -208,6 +215,7 @@ namespace MWWorld
 
     void CellRef::setChargeIntRemainder(float chargeRemainder)
     {
+        mUnsavedChanges.mark();
         std::visit(ESM::VisitOverload{
                        [&](ESM4::Reference& /*ref*/) {},
                        [&](ESM4::ActorCharacter&) {},
@@ -218,6 +226,7 @@ namespace MWWorld
 
     void CellRef::setChargeFloat(float charge)
     {
+        mUnsavedChanges.mark();
         std::visit(ESM::VisitOverload{
                        [&](ESM4::Reference& /*ref*/) {},
                        [&](ESM4::ActorCharacter&) {},
@@ -241,6 +250,7 @@ namespace MWWorld
         if (!getGlobalVariable().empty())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter& /*ref*/) {},
@@ -255,6 +265,7 @@ namespace MWWorld
         if (factionRank != getFactionRank())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::ActorCharacter&) {}, [&](auto&& ref) { ref.mFactionRank = factionRank; } },
                 mCellRef.mVariant);
@@ -265,6 +276,7 @@ namespace MWWorld
     {
         if (owner != getOwner())
         {
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
@@ -279,6 +291,7 @@ namespace MWWorld
         if (soul != getSoul())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
@@ -293,6 +306,7 @@ namespace MWWorld
         if (faction != getFaction())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
@@ -307,6 +321,7 @@ namespace MWWorld
         if (lockLevel != getLockLevel())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& ref) { ref.mLockLevel = static_cast<int8_t>(lockLevel); },
                            [&](ESM4::ActorCharacter&) {},
@@ -341,6 +356,7 @@ namespace MWWorld
 
     void CellRef::setLocked(bool locked)
     {
+        mUnsavedChanges.mark();
         std::visit(ESM::VisitOverload{
                        [&](ESM4::Reference& ref) { ref.mIsLocked = locked; },
                        [&](ESM4::ActorCharacter&) {},
@@ -354,6 +370,7 @@ namespace MWWorld
         if (trap != getTrap())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
@@ -368,6 +385,7 @@ namespace MWWorld
         if (key != getKey())
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& /*ref*/) {},
                            [&](ESM4::ActorCharacter&) {},
@@ -382,6 +400,7 @@ namespace MWWorld
         if (value != getCount(false))
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             std::visit(ESM::VisitOverload{
                            [&](ESM4::Reference& ref) { ref.mCount = value; },
                            [&](ESM4::ActorCharacter& ref) { ref.mCount = value; },
@@ -7,6 +7,8 @@
 #include <components/esm3/cellref.hpp>
 #include <components/esm4/loadrefr.hpp>
 
+#include "unsavedchanges.hpp"
+
 namespace ESM
 {
     struct Enchantment;
@@ -264,8 +266,14 @@ namespace MWWorld
         // Has this CellRef changed since it was originally loaded?
         bool hasChanged() const { return mChanged; }
 
+        // Could this CellRef have changed since the last call of markSaved()?
+        bool hasUnsavedChanges() const { return mUnsavedChanges.get(); }
+
+        void markSaved() { mUnsavedChanges.clear(); }
+
     private:
         bool mChanged = false;
+        UnsavedChanges mUnsavedChanges;
         ESM::ReferenceVariant mCellRef;
     };
 
@@ -1,7 +1,7 @@
 #ifndef GAME_MWWORLD_CELLREFLIST_H
 #define GAME_MWWORLD_CELLREFLIST_H
 
-#include <list>
+#include <components/misc/segmentedlist.hpp>
 
 #include "livecellref.hpp"
 
@@ -16,7 +16,7 @@ namespace MWWorld
     struct CellRefList : public CellRefListBase
     {
         typedef LiveCellRef<X> LiveRef;
-        typedef std::list<LiveRef> List;
+        typedef Misc::SegmentedList<LiveRef> List;
         List mList;
 
         /// Search for the given reference in the given reclist from
@@ -26,7 +26,8 @@ namespace MWWorld
         /// and the build will fail with an ugly three-way cyclic header dependence
         /// so we need to pass the instantiation of the method to the linker, when
         /// all methods are known.
-        void load(ESM::CellRef& ref, bool deleted, const MWWorld::ESMStore& esmStore);
+        /// \param staticOnly Use only records loaded from content files, allows to call it from a background thread.
+        void load(ESM::CellRef& ref, bool deleted, const MWWorld::ESMStore& esmStore, bool staticOnly = false);
 
         void load(const ESM4::Reference& ref, const MWWorld::ESMStore& esmStore);
         void load(const ESM4::ActorCharacter& ref, const MWWorld::ESMStore& esmStore);
@@ -43,7 +44,7 @@ namespace MWWorld
             for (typename List::iterator it = mList.begin(); it != mList.end();)
             {
                 if (*it == refNum)
-                    mList.erase(it++);
+                    it = mList.erase(it);
                 else
                     ++it;
             }
@@ -402,13 +402,13 @@ namespace MWWorld
     };
 
     template <typename X>
-    void CellRefList<X>::load(ESM::CellRef& ref, bool deleted, const MWWorld::ESMStore& esmStore)
+    void CellRefList<X>::load(ESM::CellRef& ref, bool deleted, const MWWorld::ESMStore& esmStore, bool staticOnly)
     {
         const MWWorld::Store<X>& store = esmStore.get<X>();
 
-        if (const X* ptr = store.search(ref.mRefID))
+        if (const X* ptr = staticOnly ? store.searchStatic(ref.mRefID) : store.search(ref.mRefID))
         {
-            typename std::list<LiveRef>::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
+            typename List::iterator iter = std::find(mList.begin(), mList.end(), ref.mRefNum);
 
             LiveRef liveCellRef(ref, ptr);
 
@@ -481,6 +481,7 @@ namespace MWWorld
             load();
 
         mHasState = true;
+        mHasUnsavedChanges = true;
         MovedRefTracker::iterator found = mMovedToAnotherCell.find(object.getBase());
         if (found != mMovedToAnotherCell.end())
         {
@@ -518,6 +519,8 @@ namespace MWWorld
 
             mMovedHere.erase(found);
 
+            mHasUnsavedChanges = true;
+
             // Now that object is back to its rightful owner, we can move it
             if (cellToMoveTo != originalCell)
             {
@@ -529,6 +532,7 @@ namespace MWWorld
         }
 
         cellToMoveTo->moveFrom(object, this);
+        mHasUnsavedChanges = true;
         mMovedToAnotherCell.insert(std::make_pair(object.getBase(), cellToMoveTo));
 
         requestMergedRefsUpdate();
@@ -599,6 +603,7 @@ namespace MWWorld
         , mCellVariant(std::move(cell))
         , mState(State_Unloaded)
         , mHasState(false)
+        , mHasUnsavedChanges(true)
         , mLastRespawn(0, 0)
         , mCellStoreImp(std::make_unique<CellStoreImp>())
         , mRechargingItemsUpToDate(false)
@@ -630,6 +635,34 @@ namespace MWWorld
         return mHasState;
     }
 
+    bool CellStore::hasUnsavedChanges() const
+    {
+        if (mHasUnsavedChanges)
+            return true;
+        bool result = false;
+        Misc::tupleForEach(mCellStoreImp->mRefLists, [&](const auto& refList) {
+            if (!result)
+                result = std::any_of(refList.mList.begin(), refList.mList.end(), [](const LiveCellRefBase& ref) {
+                    // Lua scripts may change their state without accessing the object.
+                    return ref.mRef.hasUnsavedChanges() || ref.mData.hasUnsavedChanges()
+                        || ref.mData.getLuaScripts() != nullptr;
+                });
+        });
+        return result;
+    }
+
+    void CellStore::markSaved()
+    {
+        mHasUnsavedChanges = false;
+        Misc::tupleForEach(mCellStoreImp->mRefLists, [](auto& refList) {
+            for (LiveCellRefBase& ref : refList.mList)
+            {
+                ref.mRef.markSaved();
+                ref.mData.markSaved();
+            }
+        });
+    }
+
     bool CellStore::hasId(const ESM::RefId& id) const
     {
         if (mState == State_Unloaded)
@@ -709,6 +742,7 @@ namespace MWWorld
     {
         mWaterLevel = level;
         mHasState = true;
+        mHasUnsavedChanges = true;
     }
 
     std::size_t CellStore::count() const
@@ -728,6 +762,7 @@ namespace MWWorld
             loadRefs();
 
             mState = State_Loaded;
+            mHasUnsavedChanges = true;
         }
     }
 
@@ -825,7 +860,10 @@ namespace MWWorld
         std::sort(mIds.begin(), mIds.end());
     }
 
-    void CellStore::loadRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    // Calls `invocable(ref, deleted)` for every reference of the cell that wasn't moved to a different cell,
+    // `getReader(context)` should return a reader for the content file of the context.
+    template <typename GetReader, typename ReferenceInvocable>
+    static void visitCell3References(const ESM::Cell& cell, GetReader&& getReader, ReferenceInvocable&& invocable)
     {
         if (cell.mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
@@ -836,8 +874,7 @@ namespace MWWorld
             try
             {
                 // Reopen the ESM reader and seek to the right position.
-                const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
+                auto&& reader = getReader(cell.mContextList[i]);
                 cell.restore(*reader, i);
 
                 ESM::CellRef ref;
@@ -859,13 +896,13 @@ namespace MWWorld
                         continue;
                     }
 
-                    loadRef(ref, deleted, refNumToID);
+                    invocable(ref, deleted);
                 }
             }
             catch (std::exception& e)
             {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription()
-                                  << ": " << e.what();
+                Log(Debug::Error) << "An error occurred loading references for cell " << cell.getDescription() << ": "
+                                  << e.what();
             }
         }
         // Load moved references, from separately tracked list.
@@ -874,8 +911,65 @@ namespace MWWorld
             ESM::CellRef& ref = const_cast<ESM::CellRef&>(leasedRef.first);
             bool deleted = leasedRef.second;
 
-            loadRef(ref, deleted, refNumToID);
+            invocable(ref, deleted);
+        }
+    }
+
+    // Make case-adjustments to `ref` and insert it into the respective list. Only base records loaded from content
+    // files are used with `staticOnly`, so it's safe to call from a background thread.
+    static void loadCell3Ref(CellStoreTuple& refLists, const ESMStore& store, bool staticOnly, ESM::CellRef& ref,
+        bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    {
+        const auto findType = [&](const ESM::RefId& id) { return staticOnly ? store.findStatic(id) : store.find(id); };
+
+        auto it = refNumToID.find(ref.mRefNum);
+        if (it != refNumToID.end())
+        {
+            if (it->second != ref.mRefID)
+            {
+                // refID was modified, make sure we don't end up with duplicated refs
+                ESM::RecNameInts foundType = static_cast<ESM::RecNameInts>(findType(it->second));
+                if (foundType != 0)
+                {
+                    Misc::tupleForEach(refLists, [&ref, foundType](auto& x) {
+                        recNameSwitcher(x, foundType, [&ref](auto& storeIn) { storeIn.remove(ref.mRefNum); });
+                    });
+                }
+            }
+        }
+
+        ESM::RecNameInts foundType = static_cast<ESM::RecNameInts>(findType(ref.mRefID));
+        bool handledType = false;
+        if (foundType != 0)
+        {
+            Misc::tupleForEach(refLists, [&ref, &deleted, &store, staticOnly, foundType, &handledType](auto& x) {
+                recNameSwitcher(x, foundType, [&ref, &deleted, &store, staticOnly, &handledType](auto& storeIn) {
+                    handledType = true;
+                    storeIn.load(ref, deleted, store, staticOnly);
+                });
+            });
+        }
+        else
+        {
+            Log(Debug::Error) << "Cell reference " << ref.mRefID << " is not found!";
+            return;
         }
+
+        if (!handledType)
+        {
+            Log(Debug::Error) << "Error: Ignoring reference " << ref.mRefID << " of unhandled type";
+            return;
+        }
+
+        refNumToID[ref.mRefNum] = ref.mRefID;
+    }
+
+    void CellStore::loadRefs(const ESM::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
+    {
+        const auto getReader
+            = [&](const ESM::ESM_Context& context) { return mReaders.get(static_cast<std::size_t>(context.index)); };
+        visitCell3References(
+            cell, getReader, [&](ESM::CellRef& ref, bool deleted) { loadRef(ref, deleted, refNumToID); });
     }
 
     void CellStore::loadRefs(const ESM4::Cell& cell, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
@@ -886,13 +980,86 @@ namespace MWWorld
 
     void CellStore::loadRefs()
     {
-        std::map<ESM::RefNum, ESM::RefId> refNumToID; // used to detect refID modifications
+        const std::shared_ptr<PreparedRefs> preparedRefs = std::move(mPreparedRefs);
 
-        ESM::visit([&](auto&& cell) { loadRefs(cell, refNumToID); }, mCellVariant);
+        if (preparedRefs == nullptr || !applyPreparedRefs(*preparedRefs))
+        {
+            std::map<ESM::RefNum, ESM::RefId> refNumToID; // used to detect refID modifications
+
+            ESM::visit([&](auto&& cell) { loadRefs(cell, refNumToID); }, mCellVariant);
+        }
 
         requestMergedRefsUpdate();
     }
 
+    struct CellStore::PreparedRefs
+    {
+        CellStoreTuple mRefLists;
+    };
+
+    std::shared_ptr<CellStore::PreparedRefs> CellStore::prepareRefs(
+        const ESM::Cell& cell, const ESMStore& store, ToUTF8::Utf8Encoder* encoder)
+    {
+        auto result = std::make_shared<PreparedRefs>();
+        ESM::ESMReader reader;
+        reader.setEncoder(encoder);
+        std::map<ESM::RefNum, ESM::RefId> refNumToID;
+        visitCell3References(
+            cell,
+            [&](const ESM::ESM_Context& context) {
+                if (reader.getName() != context.filename)
+                    reader.open(context.filename);
+                return &reader;
+            },
+            [&](ESM::CellRef& ref, bool deleted) {
+                loadCell3Ref(result->mRefLists, store, true, ref, deleted, refNumToID);
+            });
+        return result;
+    }
+
+    void CellStore::setPreparedRefs(std::shared_ptr<PreparedRefs> refs)
+    {
+        mPreparedRefs = std::move(refs);
+    }
+
+    template <class T>
+    static bool isPreparedRefListValid(
+        const CellRefList<T>& prepared, const CellRefList<T>& current, const ESMStore& store)
+    {
+        if (!current.mList.empty())
+            return false;
+        // Prepared references use only records from content files, the ones created or overridden later (e.g. by
+        // a saved game) take precedence.
+        for (const LiveCellRef<T>& ref : prepared.mList)
+        {
+            const ESM::RefId id = ref.mRef.getRefId();
+            if (store.find(id) != static_cast<int>(T::sRecordId) || store.get<T>().search(id) != ref.mBase)
+                return false;
+        }
+        return true;
+    }
+
+    bool CellStore::applyPreparedRefs(PreparedRefs& refs)
+    {
+        if (mCellVariant.isEsm4())
+            return false;
+
+        bool valid = true;
+        Misc::tupleForEach(refs.mRefLists, [&](const auto& prepared) {
+            using List = std::decay_t<decltype(prepared)>;
+            valid = valid && isPreparedRefListValid(prepared, std::get<List>(mCellStoreImp->mRefLists), mStore);
+        });
+        if (!valid)
+            return false;
+
+        // Moving the lists keeps addresses of the references.
+        Misc::tupleForEach(refs.mRefLists, [&](auto& prepared) {
+            using List = std::decay_t<decltype(prepared)>;
+            std::get<List>(mCellStoreImp->mRefLists).mList = std::move(prepared.mList);
+        });
+        return true;
+    }
+
     bool CellStore::isExterior() const
     {
         return mCellVariant.isExterior();
@@ -946,54 +1113,13 @@ namespace MWWorld
 
     void CellStore::loadRef(ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID)
     {
-        const MWWorld::ESMStore& store = mStore;
-
-        auto it = refNumToID.find(ref.mRefNum);
-        if (it != refNumToID.end())
-        {
-            if (it->second != ref.mRefID)
-            {
-                // refID was modified, make sure we don't end up with duplicated refs
-                ESM::RecNameInts foundType = static_cast<ESM::RecNameInts>(store.find(it->second));
-                if (foundType != 0)
-                {
-                    Misc::tupleForEach(this->mCellStoreImp->mRefLists, [&ref, foundType](auto& x) {
-                        recNameSwitcher(x, foundType, [&ref](auto& storeIn) { storeIn.remove(ref.mRefNum); });
-                    });
-                }
-            }
-        }
-
-        ESM::RecNameInts foundType = static_cast<ESM::RecNameInts>(store.find(ref.mRefID));
-        bool handledType = false;
-        if (foundType != 0)
-        {
-            Misc::tupleForEach(
-                this->mCellStoreImp->mRefLists, [&ref, &deleted, &store, foundType, &handledType](auto& x) {
-                    recNameSwitcher(x, foundType, [&ref, &deleted, &store, &handledType](auto& storeIn) {
-                        handledType = true;
-                        storeIn.load(ref, deleted, store);
-                    });
-                });
-        }
-        else
-        {
-            Log(Debug::Error) << "Cell reference " << ref.mRefID << " is not found!";
-            return;
-        }
-
-        if (!handledType)
-        {
-            Log(Debug::Error) << "Error: Ignoring reference " << ref.mRefID << " of unhandled type";
-            return;
-        }
-
-        refNumToID[ref.mRefNum] = ref.mRefID;
+        loadCell3Ref(mCellStoreImp->mRefLists, mStore, false, ref, deleted, refNumToID);
     }
 
     void CellStore::loadState(const ESM::CellState& state)
     {
         mHasState = true;
+        mHasUnsavedChanges = true;
 
         if (!mCellVariant.isExterior() && mCellVariant.hasWater())
             mWaterLevel = state.mWaterLevel;
@@ -1046,6 +1172,7 @@ namespace MWWorld
     void CellStore::readReferences(ESM::ESMReader& reader, GetCellStoreCallback* callback)
     {
         mHasState = true;
+        mHasUnsavedChanges = true;
 
         while (reader.isNextSub("OBJE"))
         {
@@ -1136,6 +1263,7 @@ namespace MWWorld
     void CellStore::setFog(std::unique_ptr<ESM::FogState>&& fog)
     {
         mFogState = std::move(fog);
+        mHasUnsavedChanges = true;
     }
 
     ESM::FogState* CellStore::getFog() const
@@ -1229,6 +1357,7 @@ namespace MWWorld
             if (MWBase::Environment::get().getWorld()->getTimeStamp() - mLastRespawn > 24 * 30 * iMonthsToRespawn)
             {
                 mLastRespawn = MWBase::Environment::get().getWorld()->getTimeStamp();
+                mHasUnsavedChanges = true;
                 for (CellRefList<ESM::Container>::List::iterator it(get<ESM::Container>().mList.begin());
                      it != get<ESM::Container>().mList.end(); ++it)
                 {
@@ -83,6 +83,11 @@ namespace ESM4
     struct Npc;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class ESMStore;
@@ -138,6 +143,7 @@ namespace MWWorld
         LiveCellRefBase* insert(const LiveCellRef<T>* ref)
         {
             mHasState = true;
+            mHasUnsavedChanges = true;
             CellRefList<T>& list = get<T>();
             LiveCellRefBase* ret = &list.insert(*ref);
             requestMergedRefsUpdate();
@@ -167,6 +173,13 @@ namespace MWWorld
         bool hasState() const;
         ///< Does this cell have state that needs to be stored in a saved game file?
 
+        bool hasUnsavedChanges() const;
+        ///< Could the state of this cell have changed since the last call of markSaved()?
+        /// @note Conservative: mutable access to the state of an object without a setter counts as a change.
+
+        void markSaved();
+        ///< Called after the state of this cell is written into a saved game file.
+
         bool hasId(const ESM::RefId& id) const;
         ///< May return true for deleted IDs when in preload state. Will return false, if cell is
         /// unloaded.
@@ -203,6 +216,17 @@ namespace MWWorld
         void preload();
         ///< Build ID list from content file.
 
+        /// References read ahead of time by prepareRefs.
+        struct PreparedRefs;
+
+        static std::shared_ptr<PreparedRefs> prepareRefs(
+            const ESM::Cell& cell, const ESMStore& store, ToUTF8::Utf8Encoder* encoder);
+        ///< Read references of the cell from content files using only records loaded from content files and
+        /// without touching any shared state, so it can be called from a background thread.
+
+        void setPreparedRefs(std::shared_ptr<PreparedRefs> refs);
+        ///< Use the prepared references on the next load() instead of reading them if they are still valid.
+
         /// Call visitor (MWWorld::Ptr) for each reference. visitor must return a bool. Returning
         /// false will abort the iteration.
         /// \note Prefer using forEachConst when possible.
@@ -351,6 +375,7 @@ namespace MWWorld
         MWWorld::Cell mCellVariant;
         State mState;
         bool mHasState;
+        bool mHasUnsavedChanges;
         std::vector<ESM::RefId> mIds;
         float mWaterLevel;
 
@@ -365,6 +390,7 @@ namespace MWWorld
 
         std::unique_ptr<CellStoreImp> mCellStoreImp;
         std::vector<CellRefListBase*> mCellRefLists;
+        std::shared_ptr<PreparedRefs> mPreparedRefs;
 
         template <class T>
         CellRefList<T>& get()
@@ -422,6 +448,8 @@ namespace MWWorld
 
         void loadRefs();
 
+        bool applyPreparedRefs(PreparedRefs& refs);
+
         void loadRef(const ESM4::Reference& ref);
         void loadRef(const ESM4::ActorCharacter& ref);
         void loadRef(ESM::CellRef& ref, bool deleted, std::map<ESM::RefNum, ESM::RefId>& refNumToID);
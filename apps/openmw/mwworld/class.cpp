@@ -331,6 +331,8 @@ namespace MWWorld
             models.push_back(model);
     }
 
+    void Class::getSoundsToPreload(const ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const {}
+
     const ESM::RefId& Class::applyEnchantment(
         const MWWorld::ConstPtr& ptr, const ESM::RefId& enchId, int enchCharge, const std::string& newName) const
     {
@@ -297,6 +297,9 @@ namespace MWWorld
         ///< Get a list of models to preload that this object may use (directly or indirectly). default implementation:
         ///< list getModel().
 
+        virtual void getSoundsToPreload(const MWWorld::ConstPtr& ptr, std::vector<ESM::RefId>& sounds) const;
+        ///< Get a list of sounds to preload that this object may play on its own. default implementation: none.
+
         virtual const ESM::RefId& applyEnchantment(
             const MWWorld::ConstPtr& ptr, const ESM::RefId& enchId, int enchCharge, const std::string& newName) const;
         ///< Creates a new record using \a ptr as template, with the given name and the given enchantment applied to it.
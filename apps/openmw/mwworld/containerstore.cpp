@@ -798,6 +798,10 @@ void MWWorld::ContainerStore::flagAsModified()
 {
     mWeightUpToDate = false;
     mRechargingItemsUpToDate = false;
+
+    // Items are saved as a part of their owner
+    if (const Ptr& owner = getPtr(); !owner.isEmpty())
+        owner.getRefData().markUnsavedChanges();
 }
 
 bool MWWorld::ContainerStore::isResolved() const
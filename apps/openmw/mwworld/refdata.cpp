@@ -29,6 +29,7 @@ namespace MWWorld
     void RefData::setLuaScripts(std::shared_ptr<MWLua::LocalScripts>&& scripts)
     {
         mChanged = true;
+        mUnsavedChanges.mark();
         mLuaScripts = std::move(scripts);
     }
 
@@ -47,6 +48,7 @@ namespace MWWorld
 
         mCustomData = refData.mCustomData ? refData.mCustomData->clone() : nullptr;
         mLuaScripts = refData.mLuaScripts;
+        mUnsavedChanges.mark();
     }
 
     void RefData::cleanup()
@@ -201,7 +203,10 @@ namespace MWWorld
     void RefData::setLocals(const ESM::Script& script)
     {
         if (mLocals.configure(script) && !mLocals.isEmpty())
+        {
             mChanged = true;
+            mUnsavedChanges.mark();
+        }
     }
 
     void RefData::setDeletedByContentFile(bool deleted)
@@ -216,6 +221,7 @@ namespace MWWorld
 
     MWScript::Locals& RefData::getLocals()
     {
+        mUnsavedChanges.mark();
         return mLocals;
     }
 
@@ -229,6 +235,7 @@ namespace MWWorld
         if (!mEnabled)
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             mEnabled = true;
         }
     }
@@ -238,6 +245,7 @@ namespace MWWorld
         if (mEnabled)
         {
             mChanged = true;
+            mUnsavedChanges.mark();
             mEnabled = false;
         }
     }
@@ -245,6 +253,7 @@ namespace MWWorld
     void RefData::setPosition(const ESM::Position& pos)
     {
         mChanged = true;
+        mUnsavedChanges.mark();
         mPosition = pos;
     }
 
@@ -256,11 +265,14 @@ namespace MWWorld
     void RefData::setCustomData(std::unique_ptr<CustomData>&& value) noexcept
     {
         mChanged = true; // We do not currently track CustomData, so assume anything with a CustomData is changed
+        mUnsavedChanges.mark();
         mCustomData = std::move(value);
     }
 
     CustomData* RefData::getCustomData()
     {
+        // Stats, inventories and the other state of CustomData are changed through the returned pointer
+        mUnsavedChanges.mark();
         return mCustomData.get();
     }
 
@@ -283,6 +295,7 @@ namespace MWWorld
     {
         bool ret = (mFlags & Flag_ActivationBuffered);
         mFlags &= ~(Flag_SuppressActivate | Flag_OnActivate);
+        mUnsavedChanges.mark();
         return ret;
     }
 
@@ -291,6 +304,7 @@ namespace MWWorld
         if (mFlags & Flag_SuppressActivate)
         {
             mFlags |= Flag_OnActivate | Flag_ActivationBuffered;
+            mUnsavedChanges.mark();
             return false;
         }
         else
@@ -304,6 +318,7 @@ namespace MWWorld
         bool ret = mFlags & Flag_OnActivate;
         mFlags |= Flag_SuppressActivate;
         mFlags &= (~Flag_OnActivate);
+        mUnsavedChanges.mark();
         return ret;
     }
 
@@ -314,12 +329,14 @@ namespace MWWorld
 
     ESM::AnimationState& RefData::getAnimationState()
     {
+        mUnsavedChanges.mark();
         return mAnimationState;
     }
 
     void RefData::setChanged(bool changed)
     {
         mChanged = changed;
+        mUnsavedChanges.mark();
     }
 
 }
@@ -7,6 +7,7 @@
 
 #include "../mwscript/locals.hpp"
 #include "../mwworld/customdata.hpp"
+#include "../mwworld/unsavedchanges.hpp"
 
 #include <osg/ref_ptr>
 
@@ -64,6 +65,9 @@ namespace MWWorld
     private:
         bool mChanged : 1;
 
+        // Mutable access to the parts without setters counts as a change.
+        UnsavedChanges mUnsavedChanges;
+
         void copy(const RefData& refData);
 
         void cleanup();
@@ -152,6 +156,13 @@ namespace MWWorld
 
         const ESM::AnimationState& getAnimationState() const;
         ESM::AnimationState& getAnimationState();
+
+        bool hasUnsavedChanges() const { return mUnsavedChanges.get(); }
+        ///< Could this RefData have changed since the last call of markSaved()?
+
+        void markUnsavedChanges() { mUnsavedChanges.mark(); }
+
+        void markSaved() { mUnsavedChanges.clear(); }
     };
 }
 
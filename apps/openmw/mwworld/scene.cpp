@@ -896,6 +896,7 @@ namespace MWWorld
         , mPreloadExteriorGrid(Settings::cells().mPreloadExteriorGrid)
         , mPreloadDoors(Settings::cells().mPreloadDoors)
         , mPreloadFastTravel(Settings::cells().mPreloadFastTravel)
+        , mPreloadReferences(Settings::cells().mPreloadReferences)
         , mPredictionTime(Settings::cells().mPredictionTime)
         , mLowestPoint(std::numeric_limits<float>::max())
     {
@@ -906,6 +907,7 @@ namespace MWWorld
         mPreloader->setMinCacheSize(Settings::cells().mPreloadCellCacheMin);
         mPreloader->setMaxCacheSize(Settings::cells().mPreloadCellCacheMax);
         mPreloader->setPreloadInstances(Settings::cells().mPreloadInstances);
+        mPreloader->setPreloadReferences(mPreloadReferences);
     }
 
     Scene::~Scene()
@@ -917,6 +919,11 @@ namespace MWWorld
             v->waitTillDone();
     }
 
+    void Scene::setEncoder(const ToUTF8::Utf8Encoder* encoder)
+    {
+        mPreloader->setEncoder(encoder);
+    }
+
     bool Scene::hasCellChanged() const
     {
         return mCellChanged;
@@ -1190,7 +1197,8 @@ namespace MWWorld
             {
                 try
                 {
-                    preloadCellWithSurroundings(mWorld.getWorldModel().getCell(door.getCellRef().getDestCell()));
+                    preloadCellWithSurroundings(
+                        mWorld.getWorldModel().getCell(door.getCellRef().getDestCell(), !mPreloadReferences));
                 }
                 catch (const std::exception& e)
                 {
@@ -1233,7 +1241,7 @@ namespace MWWorld
                 float loadDist = cellSize / 2 + cellSize - mCellLoadingThreshold + mPreloadDistance;
 
                 if (dist < loadDist)
-                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex));
+                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex, !mPreloadReferences));
             }
         }
     }
@@ -1271,7 +1279,8 @@ namespace MWWorld
 
         const ESM::RefId worldspace = cell.getCell()->getWorldSpace();
         for (const auto& [x, y] : cells)
-            mPreloader->preload(mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace)),
+            mPreloader->preload(
+                mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace), !mPreloadReferences),
                 mRendering.getReferenceTime());
     }
 
@@ -1349,13 +1358,13 @@ namespace MWWorld
         for (ESM::Transport::Dest& dest : listVisitor.mList)
         {
             if (!dest.mCellName.empty())
-                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName));
+                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName, !mPreloadReferences));
             else
             {
                 osg::Vec3f pos = dest.mPos.asVec3();
                 const ESM::ExteriorCellLocation cellIndex
                     = ESM::positionToExteriorCellLocation(pos.x(), pos.y(), extWorldspace);
-                preloadCellWithSurroundings(mWorld.getWorldModel().getExterior(cellIndex));
+                preloadCellWithSurroundings(mWorld.getWorldModel().getExterior(cellIndex, !mPreloadReferences));
                 exteriorPositions.push_back(PositionCellGrid{ pos, gridCenterToBounds(getNewGridCenter(pos)) });
             }
         }
@@ -59,6 +59,11 @@ namespace SceneUtil
     class WorkItem;
 }
 
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
 namespace MWWorld
 {
     class Player;
@@ -101,6 +106,7 @@ namespace MWWorld
         bool mPreloadExteriorGrid;
         bool mPreloadDoors;
         bool mPreloadFastTravel;
+        bool mPreloadReferences;
         float mPredictionTime;
         float mLowestPoint;
 
@@ -146,6 +152,8 @@ namespace MWWorld
 
         ~Scene();
 
+        void setEncoder(const ToUTF8::Utf8Encoder* encoder);
+
         void reloadTerrain();
 
         void playerMoved(const osg::Vec3f& pos);
@@ -118,6 +118,16 @@ namespace MWWorld
     TypedDynamicStore<T, Id>::TypedDynamicStore(const TypedDynamicStore<T, Id>& orig)
         : mStatic(orig.mStatic)
     {
+        for (const auto& [id, record] : mStatic)
+            indexStatic(id, &record);
+    }
+
+    template <class T, class Id>
+    void TypedDynamicStore<T, Id>::indexStatic(const Id& id, const T* record)
+    {
+        if constexpr (std::is_same_v<Id, ESM::RefId>)
+            if (const ESM::StringRefId* stringId = id.template getIf<ESM::StringRefId>())
+                mStaticIndex.set(*stringId, record);
     }
 
     template <class T, class Id>
@@ -132,19 +142,22 @@ namespace MWWorld
     template <class T, class Id>
     const T* TypedDynamicStore<T, Id>::search(const Id& id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
-        if (dit != mDynamic.end())
-            return &dit->second;
-
-        typename Static::const_iterator it = mStatic.find(id);
-        if (it != mStatic.end())
-            return &(it->second);
+        if (!mDynamic.empty())
+        {
+            typename Dynamic::const_iterator dit = mDynamic.find(id);
+            if (dit != mDynamic.end())
+                return &dit->second;
+        }
 
-        return nullptr;
+        return searchStatic(id);
     }
     template <class T, class Id>
     const T* TypedDynamicStore<T, Id>::searchStatic(const Id& id) const
     {
+        if constexpr (std::is_same_v<Id, ESM::RefId>)
+            if (const ESM::StringRefId* stringId = id.template getIf<ESM::StringRefId>())
+                return mStaticIndex.get(*stringId);
+
         typename Static::const_iterator it = mStatic.find(id);
         if (it != mStatic.end())
             return &(it->second);
@@ -212,7 +225,10 @@ namespace MWWorld
 
             std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
             if (inserted.second)
+            {
                 mShared.push_back(&inserted.first->second);
+                indexStatic(record.mId, &inserted.first->second);
+            }
 
             if constexpr (std::is_same_v<Id, ESM::RefId>)
                 return RecordId(record.mId, isDeleted);
@@ -289,7 +305,10 @@ namespace MWWorld
         std::pair<typename Static::iterator, bool> result = mStatic.insert_or_assign(item.mId, item);
         T* ptr = &result.first->second;
         if (result.second)
+        {
             mShared.push_back(ptr);
+            indexStatic(item.mId, ptr);
+        }
         return ptr;
     }
     template <class T, class Id>
@@ -312,6 +331,7 @@ namespace MWWorld
                 }
                 ++sharedIter;
             }
+            indexStatic(id, nullptr);
             mStatic.erase(it);
         }
 
@@ -11,6 +11,7 @@
 #include <components/esm/attr.hpp>
 #include <components/esm/path.hpp>
 #include <components/esm/refid.hpp>
+#include <components/esm/stringrefidtable.hpp>
 #include <components/esm/util.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/esm3/loaddial.hpp>
@@ -196,9 +197,14 @@ namespace MWWorld
         std::vector<T*> mShared;
         typedef std::unordered_map<Id, T> Dynamic;
         Dynamic mDynamic;
+        /// @par mStaticIndex duplicates mStatic for StringRefId keys to avoid hash map lookups in searchStatic,
+        /// must be updated with every insertion into or removal from mStatic.
+        ESM::StringRefIdTable<const T*> mStaticIndex;
 
         friend class ESMStore;
 
+        void indexStatic(const Id& id, const T* record);
+
     public:
         TypedDynamicStore();
         TypedDynamicStore(const TypedDynamicStore<T, Id>& orig);
@@ -0,0 +1,40 @@
+#ifndef GAME_MWWORLD_UNSAVEDCHANGES_H
+#define GAME_MWWORLD_UNSAVEDCHANGES_H
+
+#include <atomic>
+
+namespace MWWorld
+{
+    /// \brief Tells if a part of an object could have changed since it was written into the last saved game
+    /// @note Objects are accessed from the physics and Lua worker threads too, so the flag is atomic. No ordering is
+    /// needed since it's read only while saving the game. A copy is a new object, so it's always marked as changed.
+    class UnsavedChanges
+    {
+    public:
+        UnsavedChanges() = default;
+
+        UnsavedChanges(const UnsavedChanges& /*other*/) noexcept {}
+
+        UnsavedChanges& operator=(const UnsavedChanges& /*other*/) noexcept
+        {
+            mark();
+            return *this;
+        }
+
+        bool get() const { return mValue.load(std::memory_order_relaxed); }
+
+        void mark()
+        {
+            // Avoid writing into the cache line of an object accessed every frame
+            if (!get())
+                mValue.store(true, std::memory_order_relaxed);
+        }
+
+        void clear() { mValue.store(false, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<bool> mValue{ true };
+    };
+}
+
+#endif
@@ -112,6 +112,7 @@ namespace MWWorld
         bool mScriptsEnabled;
         bool mDiscardMovements;
         std::vector<std::string> mContentFiles;
+        ToUTF8::Utf8Encoder* mEncoder = nullptr;
 
         std::filesystem::path mUserDataPath;
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cassert>
 #include <optional>
+#include <sstream>
 #include <stdexcept>
 
 #include <components/debug/debuglog.hpp>
@@ -148,6 +149,7 @@ void MWWorld::WorldModel::clear()
     mInteriors.clear();
     mExteriors.clear();
     mCells.clear();
+    mSavedCells.clear();
     std::fill(mIdCache.begin(), mIdCache.end(), std::make_pair(ESM::RefId(), (MWWorld::CellStore*)nullptr));
     mIdCacheIndex = 0;
 }
@@ -185,6 +187,41 @@ void MWWorld::WorldModel::writeCell(ESM::ESMWriter& writer, CellStore& cell) con
     writer.endRecord(ESM::REC_CSTA);
 }
 
+void MWWorld::WorldModel::writeCellOrReuse(ESM::ESMWriter& writer, CellStore& cell) const
+{
+    const ESM::RefId id = cell.getCell()->getId();
+
+    if (!cell.hasUnsavedChanges())
+    {
+        const auto it = mSavedCells.find(id);
+        if (it != mSavedCells.end())
+        {
+            writer.writeRawRecord(it->second);
+            return;
+        }
+    }
+
+    std::ostringstream stream;
+    std::ostream& previous = writer.exchangeStream(stream);
+    try
+    {
+        writeCell(writer, cell);
+    }
+    catch (...)
+    {
+        writer.exchangeStream(previous);
+        throw;
+    }
+    writer.exchangeStream(previous);
+
+    std::string& record = mSavedCells[id];
+    record = std::move(stream).str();
+    writer.write(record.data(), record.size());
+
+    // Serialization accesses objects through mutable Ptrs, so the cell is marked only afterwards.
+    cell.markSaved();
+}
+
 MWWorld::WorldModel::WorldModel(MWWorld::ESMStore& store, ESM::ReadersCache& readers)
     : mStore(store)
     , mReaders(readers)
@@ -460,10 +497,17 @@ size_t MWWorld::WorldModel::countSavedGameRecords() const
 
 void MWWorld::WorldModel::write(ESM::ESMWriter& writer, Loading::Listener& progress) const
 {
+    const bool reuseUnchangedCells = Settings::saves().mReuseUnchangedCells;
+    if (!reuseUnchangedCells)
+        mSavedCells.clear();
+
     for (auto& [id, cellStore] : mCells)
         if (cellStore.hasState())
         {
-            writeCell(writer, cellStore);
+            if (reuseUnchangedCells)
+                writeCellOrReuse(writer, cellStore);
+            else
+                writeCell(writer, cellStore);
             progress.increaseProgress();
         }
 }
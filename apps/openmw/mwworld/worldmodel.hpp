@@ -116,6 +116,8 @@ namespace MWWorld
         ESM::Cell mDraftCell;
         std::vector<std::pair<ESM::RefId, CellStore*>> mIdCache;
         std::size_t mIdCacheIndex = 0;
+        // Saved state of cells written by the previous save, reused for cells that haven't changed since then.
+        mutable std::unordered_map<ESM::RefId, std::string> mSavedCells;
 
         CellStore& getOrInsertCellStore(const ESM::Cell& cell);
 
@@ -124,6 +126,8 @@ namespace MWWorld
         Ptr getPtrAndCache(const ESM::RefId& name, CellStore& cellStore);
 
         void writeCell(ESM::ESMWriter& writer, CellStore& cell) const;
+
+        void writeCellOrReuse(ESM::ESMWriter& writer, CellStore& cell) const;
     };
 }
 
@@ -0,0 +1,161 @@
+#include <components/files/configurationmanager.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/shadow.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/testing/util.hpp>
+#include <components/toutf8/toutf8.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Material>
+#include <osgDB/Registry>
+
+#include <gtest/gtest.h>
+
+#include "apps/openmw/mwrender/bakedchunkcache.hpp"
+
+namespace MWRender
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct MWRenderBakedChunkCacheTest : Test
+        {
+            const VFS::Manager mVfs;
+            const ToUTF8::Utf8Encoder mEncoder{ ToUTF8::WINDOWS_1252 };
+            Resource::ResourceSystem mResourceSystem{ &mVfs, 1.0, &mEncoder.getStatelessEncoder() };
+            Resource::SceneManager& mSceneManager = *mResourceSystem.getSceneManager();
+            const BakedChunkCache::Hash mHash{ 1, 2 };
+            osg::ref_ptr<osg::Vec3Array> mVertices = new osg::Vec3Array;
+            osg::ref_ptr<osg::Group> mChunk = new osg::Group;
+
+            MWRenderBakedChunkCacheTest()
+            {
+                const Files::ConfigurationManager configurationManager;
+                mSceneManager.setShaderPath(configurationManager.getLocalPath() / "resources/shaders");
+
+                Shader::ShaderManager::DefineMap defines = Shader::getDefaultDefines();
+                osg::ref_ptr<SceneUtil::LightManager> lightManager
+                    = new SceneUtil::LightManager(SceneUtil::LightSettings{}, &mResourceSystem);
+                for (const auto& [name, value] : SceneUtil::ShadowManager::getShadowsDisabledDefines())
+                    defines[name] = value;
+                for (const auto& [name, value] : lightManager->getLightDefines())
+                    defines[name] = value;
+                mSceneManager.getShaderManager().setGlobalDefines(defines);
+
+                mVertices->push_back(osg::Vec3f(0, 0, 0));
+                mVertices->push_back(osg::Vec3f(1, 0, 0));
+                mVertices->push_back(osg::Vec3f(0, 1, 0));
+
+                osg::ref_ptr<osg::Material> material = new osg::Material;
+                material->setDiffuse(osg::Material::FRONT_AND_BACK, osg::Vec4f(0.5f, 0.25f, 1, 1));
+
+                osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+                geometry->setVertexArray(mVertices);
+                geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, 3));
+                geometry->getOrCreateStateSet()->setAttribute(material);
+                // Replaced by the ShaderVisitor
+                geometry->getOrCreateStateSet()->setMode(GL_ALPHA_TEST, osg::StateAttribute::ON);
+
+                mChunk->addChild(geometry);
+                mSceneManager.recreateShaders(mChunk);
+            }
+
+            const osg::Geometry& getGeometry(const osg::Node& chunk) const
+            {
+                const osg::Geometry* geometry = chunk.asGroup()->getChild(0)->asGeometry();
+                EXPECT_NE(geometry, nullptr);
+                return *geometry;
+            }
+        };
+
+        TEST_F(MWRenderBakedChunkCacheTest, loadShouldReturnNullptrForMissingFile)
+        {
+            BakedChunkCache cache(&mSceneManager, TestingOpenMW::currentTestDirPath());
+            EXPECT_EQ(cache.load("chunk.osgb", mHash), nullptr);
+        }
+
+        TEST_F(MWRenderBakedChunkCacheTest, loadShouldReturnStoredChunk)
+        {
+            if (osgDB::Registry::instance()->getReaderWriterForExtension("osgb") == nullptr)
+                GTEST_SKIP() << "osgb plugin is not available";
+
+            BakedChunkCache cache(&mSceneManager, TestingOpenMW::currentTestDirPath());
+            ASSERT_TRUE(cache.store("chunk.osgb", mHash, *mChunk));
+            const osg::ref_ptr<osg::Node> loaded = cache.load("chunk.osgb", mHash);
+            ASSERT_NE(loaded, nullptr);
+            ASSERT_NE(loaded->asGroup(), nullptr);
+            ASSERT_EQ(loaded->asGroup()->getNumChildren(), 1u);
+
+            const osg::Geometry& geometry = getGeometry(*loaded);
+            const osg::Vec3Array* vertices = dynamic_cast<const osg::Vec3Array*>(geometry.getVertexArray());
+            ASSERT_NE(vertices, nullptr);
+            EXPECT_EQ(vertices->asVector(), mVertices->asVector());
+            ASSERT_EQ(geometry.getNumPrimitiveSets(), 1u);
+            EXPECT_EQ(geometry.getPrimitiveSet(0)->getMode(), static_cast<GLenum>(GL_TRIANGLES));
+            EXPECT_EQ(geometry.getPrimitiveSet(0)->getNumIndices(), 3u);
+
+            const osg::StateSet* stateSet = geometry.getStateSet();
+            const osg::StateSet* expectedStateSet = getGeometry(*mChunk).getStateSet();
+            ASSERT_NE(stateSet, nullptr);
+            const osg::StateAttribute* material = stateSet->getAttribute(osg::StateAttribute::MATERIAL);
+            ASSERT_NE(material, nullptr);
+            EXPECT_EQ(material->compare(*expectedStateSet->getAttribute(osg::StateAttribute::MATERIAL)), 0);
+            EXPECT_EQ(stateSet->getMode(GL_ALPHA_TEST), expectedStateSet->getMode(GL_ALPHA_TEST));
+            EXPECT_NE(stateSet->getUniform("colorMode"), nullptr);
+
+            ASSERT_NE(stateSet->getUserDataContainer(), nullptr);
+            const osg::StateSet* removedState
+                = dynamic_cast<const osg::StateSet*>(stateSet->getUserDataContainer()->getUserObject("removedState"));
+            ASSERT_NE(removedState, nullptr);
+            EXPECT_EQ(removedState->getMode(GL_ALPHA_TEST), osg::StateAttribute::ON);
+        }
+
+        TEST_F(MWRenderBakedChunkCacheTest, loadedChunkShouldUseProgramsOfShaderManager)
+        {
+            if (osgDB::Registry::instance()->getReaderWriterForExtension("osgb") == nullptr)
+                GTEST_SKIP() << "osgb plugin is not available";
+
+            BakedChunkCache cache(&mSceneManager, TestingOpenMW::currentTestDirPath());
+            ASSERT_TRUE(cache.store("chunk.osgb", mHash, *mChunk));
+            const osg::ref_ptr<osg::Node> loaded = cache.load("chunk.osgb", mHash);
+            ASSERT_NE(loaded, nullptr);
+
+            const osg::StateAttribute* program
+                = getGeometry(*loaded).getStateSet()->getAttribute(osg::StateAttribute::PROGRAM);
+            ASSERT_NE(program, nullptr);
+            EXPECT_EQ(program, getGeometry(*mChunk).getStateSet()->getAttribute(osg::StateAttribute::PROGRAM));
+        }
+
+        TEST_F(MWRenderBakedChunkCacheTest, storeShouldNotChangeChunk)
+        {
+            if (osgDB::Registry::instance()->getReaderWriterForExtension("osgb") == nullptr)
+                GTEST_SKIP() << "osgb plugin is not available";
+
+            const osg::ref_ptr<const osg::StateSet> stateSet = getGeometry(*mChunk).getStateSet();
+            const osg::ref_ptr<osg::StateSet> expectedStateSet = osg::clone(stateSet.get(), osg::CopyOp::SHALLOW_COPY);
+            const unsigned int numUserObjects = stateSet->getUserDataContainer()->getNumUserObjects();
+
+            BakedChunkCache cache(&mSceneManager, TestingOpenMW::currentTestDirPath());
+            ASSERT_TRUE(cache.store("chunk.osgb", mHash, *mChunk));
+
+            EXPECT_EQ(getGeometry(*mChunk).getStateSet(), stateSet.get());
+            EXPECT_EQ(stateSet->compare(*expectedStateSet, true), 0);
+            EXPECT_EQ(stateSet->getUserDataContainer()->getNumUserObjects(), numUserObjects);
+        }
+
+        TEST_F(MWRenderBakedChunkCacheTest, loadShouldReturnNullptrForOtherHash)
+        {
+            if (osgDB::Registry::instance()->getReaderWriterForExtension("osgb") == nullptr)
+                GTEST_SKIP() << "osgb plugin is not available";
+
+            BakedChunkCache cache(&mSceneManager, TestingOpenMW::currentTestDirPath());
+            ASSERT_TRUE(cache.store("chunk.osgb", mHash, *mChunk));
+            EXPECT_EQ(cache.load("chunk.osgb", BakedChunkCache::Hash{ 1, 3 }), nullptr);
+        }
+    }
+}
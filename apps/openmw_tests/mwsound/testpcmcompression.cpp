@@ -0,0 +1,76 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "apps/openmw/mwsound/pcmcompression.hpp"
+
+namespace MWSound
+{
+    namespace
+    {
+        using namespace testing;
+
+        DecodedSound makeSineWave(std::size_t frames, ChannelConfig config, SampleType type)
+        {
+            DecodedSound sound;
+            sound.mChannelConfig = config;
+            sound.mSampleType = type;
+            sound.mSampleRate = 22050;
+            const std::size_t channels = framesToBytes(1, config, SampleType_UInt8);
+            for (std::size_t i = 0; i < frames * channels; ++i)
+            {
+                const double value = std::sin(static_cast<double>(i / channels) * (0.01 + 0.002 * (i % channels)));
+                if (type == SampleType_UInt8)
+                    sound.mData.push_back(static_cast<char>(static_cast<std::uint8_t>(128 + value * 100)));
+                else if (type == SampleType_Int16)
+                {
+                    const auto sample = static_cast<std::int16_t>(value * 20000);
+                    sound.mData.insert(sound.mData.end(), reinterpret_cast<const char*>(&sample),
+                        reinterpret_cast<const char*>(&sample) + sizeof(sample));
+                }
+                else
+                {
+                    const auto sample = static_cast<float>(value);
+                    sound.mData.insert(sound.mData.end(), reinterpret_cast<const char*>(&sample),
+                        reinterpret_cast<const char*>(&sample) + sizeof(sample));
+                }
+            }
+            return sound;
+        }
+
+        struct MWSoundPcmCompressionTest : TestWithParam<std::tuple<ChannelConfig, SampleType>>
+        {
+        };
+
+        TEST_P(MWSoundPcmCompressionTest, decompressSoundIsInverseToCompressSound)
+        {
+            const auto [config, type] = GetParam();
+            const DecodedSound sound = makeSineWave(1000, config, type);
+            const DecodedSound result = decompressSound(compressSound(sound));
+            EXPECT_EQ(result.mData, sound.mData);
+            EXPECT_EQ(result.mChannelConfig, config);
+            EXPECT_EQ(result.mSampleType, type);
+            EXPECT_EQ(result.mSampleRate, sound.mSampleRate);
+        }
+
+        INSTANTIATE_TEST_SUITE_P(AllFormats, MWSoundPcmCompressionTest,
+            Combine(Values(ChannelConfig_Mono, ChannelConfig_Stereo, ChannelConfig_5point1),
+                Values(SampleType_UInt8, SampleType_Int16, SampleType_Float32)));
+
+        TEST(MWSoundPcmCompressionTest, shouldKeepIncompleteTrailingSample)
+        {
+            DecodedSound sound = makeSineWave(100, ChannelConfig_Stereo, SampleType_Int16);
+            sound.mData.push_back(42);
+            EXPECT_EQ(decompressSound(compressSound(sound)).mData, sound.mData);
+        }
+
+        TEST(MWSoundPcmCompressionTest, shouldSupportEmptySound)
+        {
+            const DecodedSound sound = makeSineWave(0, ChannelConfig_Mono, SampleType_Int16);
+            EXPECT_THAT(decompressSound(compressSound(sound)).mData, IsEmpty());
+        }
+    }
+}
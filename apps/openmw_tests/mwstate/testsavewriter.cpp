@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <components/testing/util.hpp>
+
+#include "apps/openmw/mwstate/savewriter.hpp"
+
+namespace MWState
+{
+    namespace
+    {
+        std::string readFile(const std::filesystem::path& path)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+
+        std::filesystem::path getTemporaryPath(std::filesystem::path path)
+        {
+            path += temporarySaveExtension;
+            return path;
+        }
+
+        TEST(MWStateSaveWriterTest, WriteSaveFileShouldReplaceExistingFile)
+        {
+            const std::filesystem::path path = TestingOpenMW::outputFilePath("save_writer_replace.omwsave");
+            writeSaveFile(path, "old", false);
+            writeSaveFile(path, std::string(1024, 'a'), false);
+            EXPECT_EQ(readFile(path), std::string(1024, 'a'));
+            EXPECT_FALSE(std::filesystem::exists(getTemporaryPath(path)));
+        }
+
+        TEST(MWStateSaveWriterTest, WriteSaveFileShouldKeepExistingFileOnFailure)
+        {
+            const std::filesystem::path path = TestingOpenMW::outputFilePath("save_writer_failure.omwsave");
+            writeSaveFile(path, "old", false);
+            // A directory in place of the temporary file makes it impossible to write
+            std::filesystem::create_directory(getTemporaryPath(path));
+            EXPECT_ANY_THROW(writeSaveFile(path, "new", false));
+            EXPECT_EQ(readFile(path), "old");
+            std::filesystem::remove(getTemporaryPath(path));
+        }
+
+        TEST(MWStateSaveWriterTest, SaveWriteItemShouldReportError)
+        {
+            const std::filesystem::path path
+                = TestingOpenMW::outputFilePath("save_writer_missing") / "directory" / "file.omwsave";
+            SaveWriteItem item(path, "data", false);
+            item.doWork();
+            EXPECT_FALSE(item.getError().empty());
+            EXPECT_FALSE(std::filesystem::exists(path));
+        }
+
+        TEST(MWStateSaveWriterTest, SaveWriteItemShouldWriteFile)
+        {
+            const std::filesystem::path path = TestingOpenMW::outputFilePath("save_writer_item.omwsave");
+            SaveWriteItem item(path, "data", false);
+            item.doWork();
+            EXPECT_EQ(item.getError(), "");
+            EXPECT_EQ(readFile(path), "data");
+        }
+    }
+}
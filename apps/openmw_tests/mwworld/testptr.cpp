@@ -79,5 +79,44 @@ namespace MWWorld
             }
             EXPECT_EQ(worldModel.getPtr(cellRef.mRefNum), Ptr());
         }
+
+        TEST(MWWorldPtrTest, readOnlyAccessShouldNotMarkObjectAsChanged)
+        {
+            MWClass::Npc::registerSelf();
+            ESM::NPC npc;
+            npc.blank();
+            npc.mId = ESM::RefId::stringRefId("Player");
+            ESM::CellRef cellRef;
+            cellRef.blank();
+            cellRef.mRefID = npc.mId;
+            LiveCellRef<ESM::NPC> liveCellRef(cellRef, &npc);
+            liveCellRef.mRef.markSaved();
+            liveCellRef.mData.markSaved();
+            Ptr ptr(&liveCellRef);
+            EXPECT_EQ(ptr.getCellRef().getRefId(), npc.mId);
+            EXPECT_TRUE(ptr.getRefData().isEnabled());
+            EXPECT_FALSE(liveCellRef.mRef.hasUnsavedChanges());
+            EXPECT_FALSE(liveCellRef.mData.hasUnsavedChanges());
+        }
+
+        TEST(MWWorldPtrTest, settersShouldMarkObjectAsChanged)
+        {
+            MWClass::Npc::registerSelf();
+            ESM::NPC npc;
+            npc.blank();
+            npc.mId = ESM::RefId::stringRefId("Player");
+            ESM::CellRef cellRef;
+            cellRef.blank();
+            cellRef.mRefID = npc.mId;
+            LiveCellRef<ESM::NPC> liveCellRef(cellRef, &npc);
+            liveCellRef.mRef.markSaved();
+            liveCellRef.mData.markSaved();
+            Ptr ptr(&liveCellRef);
+            ptr.getCellRef().setOwner(ESM::RefId::stringRefId("Owner"));
+            EXPECT_TRUE(liveCellRef.mRef.hasUnsavedChanges());
+            EXPECT_FALSE(liveCellRef.mData.hasUnsavedChanges());
+            ptr.getRefData().disable();
+            EXPECT_TRUE(liveCellRef.mData.hasUnsavedChanges());
+        }
     }
 }
@@ -4,7 +4,7 @@
 #include <charconv>
 #include <ostream>
 #include <system_error>
-#include <unordered_set>
+#include <unordered_map>
 
 #include "components/misc/guarded.hpp"
 #include "components/misc/strings/algorithm.hpp"
@@ -14,22 +14,23 @@ namespace ESM
 {
     namespace
     {
-        using StringsSet = std::unordered_set<std::string, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>;
+        using StringsMap
+            = std::unordered_map<std::string, std::uint32_t, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>;
 
-        const std::string emptyString;
+        const std::pair<const std::string, std::uint32_t> emptyString;
 
-        Misc::ScopeGuarded<StringsSet>& getRefIds()
+        Misc::ScopeGuarded<StringsMap>& getRefIds()
         {
-            static Misc::ScopeGuarded<StringsSet> refIds;
+            static Misc::ScopeGuarded<StringsMap> refIds;
             return refIds;
         }
 
-        Misc::NotNullPtr<const std::string> getOrInsertString(std::string_view id)
+        const std::pair<const std::string, std::uint32_t>* getOrInsertString(std::string_view id)
         {
             const auto locked = getRefIds().lock();
             auto it = locked->find(id);
             if (it == locked->end())
-                it = locked->emplace(id).first;
+                it = locked->emplace(id, static_cast<std::uint32_t>(locked->size() + 1)).first;
             return &*it;
         }
 
@@ -58,22 +59,22 @@ namespace ESM
 
     bool StringRefId::operator==(std::string_view rhs) const noexcept
     {
-        return Misc::StringUtils::ciEqual(*mValue, rhs);
+        return Misc::StringUtils::ciEqual(mValue->first, rhs);
     }
 
     bool StringRefId::operator<(StringRefId rhs) const noexcept
     {
-        return Misc::StringUtils::ciLess(*mValue, *rhs.mValue);
+        return Misc::StringUtils::ciLess(mValue->first, rhs.mValue->first);
     }
 
     bool operator<(StringRefId lhs, std::string_view rhs) noexcept
     {
-        return Misc::StringUtils::ciLess(*lhs.mValue, rhs);
+        return Misc::StringUtils::ciLess(lhs.mValue->first, rhs);
     }
 
     bool operator<(std::string_view lhs, StringRefId rhs) noexcept
     {
-        return Misc::StringUtils::ciLess(lhs, *rhs.mValue);
+        return Misc::StringUtils::ciLess(lhs, rhs.mValue->first);
     }
 
     std::ostream& operator<<(std::ostream& stream, StringRefId value)
@@ -83,11 +84,12 @@ namespace ESM
 
     std::string StringRefId::toDebugString() const
     {
+        const std::string& value = mValue->first;
         std::string result;
-        result.reserve(2 + mValue->size());
+        result.reserve(2 + value.size());
         result.push_back('"');
-        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(mValue->data());
-        const unsigned char* const end = reinterpret_cast<const unsigned char*>(mValue->data() + mValue->size());
+        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(value.data());
+        const unsigned char* const end = reinterpret_cast<const unsigned char*>(value.data() + value.size());
         while (ptr != end)
         {
             if (Utf8Stream::isAscii(*ptr))
@@ -119,17 +121,17 @@ namespace ESM
 
     bool StringRefId::startsWith(std::string_view prefix) const
     {
-        return Misc::StringUtils::ciStartsWith(*mValue, prefix);
+        return Misc::StringUtils::ciStartsWith(mValue->first, prefix);
     }
 
     bool StringRefId::endsWith(std::string_view suffix) const
     {
-        return Misc::StringUtils::ciEndsWith(*mValue, suffix);
+        return Misc::StringUtils::ciEndsWith(mValue->first, suffix);
     }
 
     bool StringRefId::contains(std::string_view subString) const
     {
-        return Misc::StringUtils::ciFind(*mValue, subString) != std::string_view::npos;
+        return Misc::StringUtils::ciFind(mValue->first, subString) != std::string_view::npos;
     }
 
     std::optional<StringRefId> StringRefId::deserializeExisting(std::string_view value)
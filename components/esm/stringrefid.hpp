@@ -1,11 +1,13 @@
 #ifndef OPENMW_COMPONENTS_ESM_STRINGREFID_HPP
 #define OPENMW_COMPONENTS_ESM_STRINGREFID_HPP
 
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include <components/misc/notnullptr.hpp>
 
@@ -19,9 +21,12 @@ namespace ESM
         // Constructs StringRefId from string using pointer to a static set of strings.
         explicit StringRefId(std::string_view value);
 
-        const std::string& getValue() const { return *mValue; }
+        const std::string& getValue() const { return mValue->first; }
 
-        std::string toString() const { return *mValue; }
+        // Dense number assigned on interning. Ids interned together get close numbers, 0 is the empty id.
+        std::uint32_t getIndex() const { return mValue->second; }
+
+        std::string toString() const { return mValue->first; }
 
         std::string toDebugString() const;
 
@@ -52,7 +57,9 @@ namespace ESM
         static std::size_t totalCount();
 
     private:
-        Misc::NotNullPtr<const std::string> mValue;
+        using Value = std::pair<const std::string, std::uint32_t>;
+
+        Misc::NotNullPtr<const Value> mValue;
     };
 }
 
@@ -63,7 +70,7 @@ namespace std
     {
         std::size_t operator()(ESM::StringRefId value) const noexcept
         {
-            return std::hash<const std::string*>{}(value.mValue);
+            return std::hash<const ESM::StringRefId::Value*>{}(value.mValue);
         }
     };
 }
@@ -0,0 +1,62 @@
+#ifndef OPENMW_COMPONENTS_ESM_STRINGREFIDTABLE_HPP
+#define OPENMW_COMPONENTS_ESM_STRINGREFIDTABLE_HPP
+
+#include "stringrefid.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ESM
+{
+    // Maps StringRefId to a value addressed by StringRefId::getIndex, so a lookup is two array accesses instead of
+    // hashing and comparing. Storage is split into pages allocated on demand, ids interned together (like records
+    // of one type from the same content file) share pages. A value-initialized T means there is no value.
+    template <class T>
+    class StringRefIdTable
+    {
+    public:
+        T get(StringRefId id) const
+        {
+            const std::uint32_t index = id.getIndex();
+            const std::size_t page = index / sPageSize;
+            if (page >= mPages.size() || mPages[page] == nullptr)
+                return T{};
+            return (*mPages[page])[index % sPageSize];
+        }
+
+        void set(StringRefId id, T value)
+        {
+            const std::uint32_t index = id.getIndex();
+            const std::size_t page = index / sPageSize;
+            if (page >= mPages.size())
+            {
+                if (value == T{})
+                    return;
+                mPages.resize(page + 1);
+            }
+            if (mPages[page] == nullptr)
+            {
+                if (value == T{})
+                    return;
+                mPages[page] = std::make_unique<Page>();
+            }
+            (*mPages[page])[index % sPageSize] = std::move(value);
+        }
+
+        void erase(StringRefId id) { set(id, T{}); }
+
+        void clear() { mPages.clear(); }
+
+    private:
+        static constexpr std::size_t sPageSize = 64;
+
+        using Page = std::array<T, sPageSize>;
+
+        std::vector<std::unique_ptr<Page>> mPages;
+    };
+}
+
+#endif
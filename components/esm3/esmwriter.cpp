@@ -3,6 +3,7 @@
 #include <cassert>
 #include <fstream>
 #include <stdexcept>
+#include <utility>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/cellid.hpp>
@@ -340,6 +341,21 @@ namespace ESM
         mStream->write(data, size);
     }
 
+    std::ostream& ESMWriter::exchangeStream(std::ostream& stream)
+    {
+        if (!mRecords.empty())
+            throw std::runtime_error("Can't change stream within a record");
+        return *std::exchange(mStream, &stream);
+    }
+
+    void ESMWriter::writeRawRecord(std::string_view data)
+    {
+        if (!mRecords.empty())
+            throw std::runtime_error("Can't write raw record within a record");
+        ++mRecordCount;
+        mStream->write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
     void ESMWriter::writeFormId(const FormId& formId, bool wide, NAME tag)
     {
         if (wide)
@@ -3,6 +3,7 @@
 
 #include <iosfwd>
 #include <list>
+#include <string_view>
 #include <type_traits>
 
 #include "components/esm/decompose.hpp"
@@ -197,6 +198,13 @@ namespace ESM
 
         void writeFormId(const ESM::FormId&, bool wide = false, NAME tag = "FRMR");
 
+        std::ostream& exchangeStream(std::ostream& stream);
+        ///< Redirect all following output to \a stream and return the previous stream.
+        /// \note Must not be called while a record is open.
+
+        void writeRawRecord(std::string_view data);
+        ///< Write a complete record that was previously written into another stream.
+
     private:
         std::list<RecordData> mRecords;
         std::ostream* mStream;
@@ -0,0 +1,86 @@
+#include "compressedstream.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <components/misc/compression.hpp>
+#include <components/misc/endianness.hpp>
+
+#include "compressedstreambuf.hpp"
+#include "conversion.hpp"
+#include "openfile.hpp"
+#include "streamwithbuffer.hpp"
+
+namespace Files
+{
+    namespace
+    {
+        constexpr std::array<char, 4> magic{ 'O', 'M', 'W', 'Z' };
+        constexpr std::uint32_t version = 1;
+
+        template <class T>
+        void writeValue(std::ostream& stream, T value)
+        {
+            value = Misc::toLittleEndian(value);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        T readValue(std::istream& stream)
+        {
+            T value{};
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+            if (stream.fail())
+                throw std::runtime_error("Unexpected end of compressed stream header");
+            return Misc::fromLittleEndian(value);
+        }
+    }
+
+    void writeCompressedStream(std::ostream& stream, std::string_view data)
+    {
+        stream.write(magic.data(), magic.size());
+        writeValue(stream, version);
+        writeValue(stream, static_cast<std::uint64_t>(data.size()));
+
+        for (std::size_t offset = 0; offset < data.size(); offset += compressedStreamChunkSize)
+        {
+            const std::string_view chunk = data.substr(offset, compressedStreamChunkSize);
+            const std::vector<std::byte> compressed = Misc::compress(std::as_bytes(std::span(chunk)));
+            writeValue(stream, static_cast<std::uint32_t>(compressed.size()));
+            stream.write(
+                reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+        }
+
+        // Empty chunk marks the end of the data
+        writeValue(stream, std::uint32_t{ 0 });
+    }
+
+    IStreamPtr openMaybeCompressedFileStream(const std::filesystem::path& path, bool background)
+    {
+        IStreamPtr stream = openBinaryInputFileStream(path);
+
+        std::array<char, magic.size()> header{};
+        stream->read(header.data(), header.size());
+        if (stream->fail() || header != magic)
+        {
+            stream->clear();
+            stream->seekg(0);
+            return stream;
+        }
+
+        const auto streamVersion = readValue<std::uint32_t>(*stream);
+        if (streamVersion != version)
+            throw std::runtime_error("Unsupported compressed stream version " + std::to_string(streamVersion) + " in "
+                + pathToUnicodeString(path));
+        const auto size = readValue<std::uint64_t>(*stream);
+
+        return std::make_unique<StreamWithBuffer<DecompressingStreamBuf>>(
+            std::make_unique<DecompressingStreamBuf>(std::move(stream), size, background));
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAM_H
+#define OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAM_H
+
+#include <filesystem>
+#include <iosfwd>
+#include <string_view>
+
+#include "istreamptr.hpp"
+
+namespace Files
+{
+    /// Writes \a data split into independently compressed chunks after a header identifying the format.
+    void writeCompressedStream(std::ostream& stream, std::string_view data);
+
+    /// Opens a file written by writeCompressedStream to read the original data, or any other file as is.
+    /// \param background decompress the data on a separate thread while it's being read
+    IStreamPtr openMaybeCompressedFileStream(const std::filesystem::path& path, bool background);
+}
+
+#endif
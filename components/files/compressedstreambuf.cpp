@@ -0,0 +1,201 @@
+#include "compressedstreambuf.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include <components/misc/compression.hpp>
+#include <components/misc/endianness.hpp>
+
+namespace Files
+{
+    namespace
+    {
+        constexpr std::size_t maxQueuedChunks = 4;
+    }
+
+    DecompressingStreamBuf::DecompressingStreamBuf(
+        std::unique_ptr<std::istream>&& source, std::uint64_t size, bool background)
+        : mSource(std::move(source))
+        , mSize(size)
+    {
+        setg(nullptr, nullptr, nullptr);
+        if (background)
+            mThread = std::thread([this] { run(); });
+    }
+
+    DecompressingStreamBuf::~DecompressingStreamBuf()
+    {
+        if (!mThread.joinable())
+            return;
+        {
+            const std::lock_guard lock(mMutex);
+            mStopped = true;
+        }
+        mHasSpace.notify_all();
+        mThread.join();
+    }
+
+    std::streambuf::int_type DecompressingStreamBuf::underflow()
+    {
+        while (gptr() == egptr())
+        {
+            if (!loadNextChunk())
+                return traits_type::eof();
+            char* const begin = reinterpret_cast<char*>(mChunk.data());
+            char* const end = begin + mChunk.size();
+            if (!mSkipTo.has_value())
+                setg(begin, begin, end);
+            else if (*mSkipTo < mChunkOffset + mChunk.size())
+            {
+                setg(begin, begin + (*mSkipTo - mChunkOffset), end);
+                mSkipTo.reset();
+            }
+            else
+                setg(begin, end, end);
+        }
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streambuf::pos_type DecompressingStreamBuf::seekoff(
+        off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        off_type newPos;
+        switch (whence)
+        {
+            case std::ios_base::beg:
+                newPos = offset;
+                break;
+            case std::ios_base::cur:
+                newPos = static_cast<off_type>(getPosition()) + offset;
+                break;
+            case std::ios_base::end:
+                newPos = static_cast<off_type>(mSize) + offset;
+                break;
+            default:
+                return traits_type::eof();
+        }
+
+        if (newPos < 0)
+            return traits_type::eof();
+
+        return seekTo(static_cast<std::uint64_t>(newPos));
+    }
+
+    std::streambuf::pos_type DecompressingStreamBuf::seekpos(pos_type pos, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in) || pos < 0)
+            return traits_type::eof();
+
+        return seekTo(static_cast<std::uint64_t>(static_cast<off_type>(pos)));
+    }
+
+    std::uint64_t DecompressingStreamBuf::getPosition() const
+    {
+        if (mSkipTo.has_value())
+            return *mSkipTo;
+        return mChunkOffset + static_cast<std::uint64_t>(gptr() - eback());
+    }
+
+    std::streambuf::pos_type DecompressingStreamBuf::seekTo(std::uint64_t position)
+    {
+        if (position > mSize)
+            return traits_type::eof();
+
+        if (position >= mChunkOffset && position <= mChunkOffset + mChunk.size())
+        {
+            // Within the current chunk, including the position right after it
+            char* const begin = reinterpret_cast<char*>(mChunk.data());
+            setg(begin, begin + (position - mChunkOffset), begin + mChunk.size());
+            mSkipTo.reset();
+        }
+        else if (position < mChunkOffset)
+            return traits_type::eof();
+        else
+        {
+            // Skipped chunks are still decompressed, but only when the data after them is read
+            mSkipTo = position;
+            setg(eback(), egptr(), egptr());
+        }
+
+        return static_cast<off_type>(position);
+    }
+
+    bool DecompressingStreamBuf::loadNextChunk()
+    {
+        std::optional<std::vector<std::byte>> chunk = mThread.joinable() ? takeChunk() : readChunk();
+        if (!chunk.has_value())
+            return false;
+        mChunkOffset += mChunk.size();
+        mChunk = std::move(*chunk);
+        if (mChunkOffset + mChunk.size() > mSize)
+            throw std::runtime_error("Compressed stream has more data than declared");
+        return true;
+    }
+
+    std::optional<std::vector<std::byte>> DecompressingStreamBuf::readChunk()
+    {
+        std::uint32_t size = 0;
+        mSource->read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (mSource->fail())
+            throw std::runtime_error("Unexpected end of compressed stream");
+        size = Misc::fromLittleEndian(size);
+        if (size == 0)
+            return std::nullopt;
+        if (size > Misc::getMaxCompressedSize(compressedStreamChunkSize))
+            throw std::runtime_error("Invalid compressed chunk size: " + std::to_string(size));
+        std::vector<std::byte> compressed(size);
+        mSource->read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(size));
+        if (mSource->fail())
+            throw std::runtime_error("Unexpected end of compressed stream");
+        return Misc::decompress(compressed, compressedStreamChunkSize);
+    }
+
+    std::optional<std::vector<std::byte>> DecompressingStreamBuf::takeChunk()
+    {
+        std::unique_lock lock(mMutex);
+        mHasChunk.wait(lock, [&] { return !mChunks.empty() || mFinished; });
+        if (mChunks.empty())
+        {
+            if (!mError.empty())
+                throw std::runtime_error(mError);
+            return std::nullopt;
+        }
+        std::vector<std::byte> chunk = std::move(mChunks.front());
+        mChunks.pop_front();
+        lock.unlock();
+        mHasSpace.notify_one();
+        return chunk;
+    }
+
+    void DecompressingStreamBuf::run()
+    {
+        std::string error;
+        try
+        {
+            while (std::optional<std::vector<std::byte>> chunk = readChunk())
+            {
+                std::unique_lock lock(mMutex);
+                mHasSpace.wait(lock, [&] { return mStopped || mChunks.size() < maxQueuedChunks; });
+                if (mStopped)
+                    return;
+                mChunks.push_back(std::move(*chunk));
+                lock.unlock();
+                mHasChunk.notify_one();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+        {
+            const std::lock_guard lock(mMutex);
+            mFinished = true;
+            mError = std::move(error);
+        }
+        mHasChunk.notify_one();
+    }
+}
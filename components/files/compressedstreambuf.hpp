@@ -0,0 +1,67 @@
+#ifndef OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAMBUF_H
+#define OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAMBUF_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Files
+{
+    /// Greatest size of the uncompressed data of a chunk in a compressed stream.
+    constexpr std::size_t compressedStreamChunkSize = 1 << 20;
+
+    /// Reads data written by writeCompressedStream from the source stream positioned after the header. With
+    /// \a background chunks are read and decompressed ahead on a separate thread while the previous ones are consumed.
+    /// Seeking is supported only forward and within the current chunk.
+    class DecompressingStreamBuf final : public std::streambuf
+    {
+    public:
+        explicit DecompressingStreamBuf(std::unique_ptr<std::istream>&& source, std::uint64_t size, bool background);
+
+        ~DecompressingStreamBuf() override;
+
+        int_type underflow() final;
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) final;
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) final;
+
+    private:
+        std::unique_ptr<std::istream> mSource;
+        const std::uint64_t mSize;
+        std::vector<std::byte> mChunk;
+        std::uint64_t mChunkOffset = 0;
+        std::optional<std::uint64_t> mSkipTo;
+        std::mutex mMutex;
+        std::condition_variable mHasChunk;
+        std::condition_variable mHasSpace;
+        std::deque<std::vector<std::byte>> mChunks;
+        bool mFinished = false;
+        bool mStopped = false;
+        std::string mError;
+        std::thread mThread;
+
+        std::optional<std::vector<std::byte>> readChunk();
+
+        std::optional<std::vector<std::byte>> takeChunk();
+
+        bool loadNextChunk();
+
+        std::uint64_t getPosition() const;
+
+        pos_type seekTo(std::uint64_t position);
+
+        void run();
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+#include "bytecodecache.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#include <components/debug/debuglog.hpp>
+
+namespace LuaUtil
+{
+    namespace
+    {
+        constexpr std::string_view sMagic = "OMWLUABC";
+        constexpr std::uint32_t sFormatVersion = 2;
+
+        template <class T>
+        void writeValue(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeValue(stream, static_cast<std::uint64_t>(value.size()));
+            stream.write(value.data(), value.size());
+        }
+
+        template <class T>
+        T readValue(std::istream& stream)
+        {
+            T value;
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        std::string readString(std::istream& stream, std::uintmax_t maxSize)
+        {
+            const auto size = readValue<std::uint64_t>(stream);
+            if (size > maxSize)
+                throw std::runtime_error("invalid string size: " + std::to_string(size));
+            std::string value(size, '\0');
+            if (!stream.read(value.data(), value.size()))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+    }
+
+    const std::string* BytecodeCache::find(VFS::Path::NormalizedView path, const SourceHash& sourceHash)
+    {
+        const auto it = mEntries.find(path);
+        if (it == mEntries.end() || it->second.mSourceHash != sourceHash)
+            return nullptr;
+        it->second.mUsed = true;
+        return &it->second.mBytecode;
+    }
+
+    void BytecodeCache::insert(VFS::Path::NormalizedView path, const SourceHash& sourceHash, std::string bytecode)
+    {
+        mEntries.insert_or_assign(VFS::Path::Normalized(path), Entry{ sourceHash, std::move(bytecode), 0, true });
+        mModified = true;
+    }
+
+    void BytecodeCache::erase(VFS::Path::NormalizedView path)
+    {
+        const auto it = mEntries.find(path);
+        if (it == mEntries.end())
+            return;
+        mEntries.erase(it);
+        mModified = true;
+    }
+
+    void BytecodeCache::clear()
+    {
+        mModified = mModified || !mEntries.empty();
+        mEntries.clear();
+    }
+
+    void BytecodeCache::load(const std::filesystem::path& path)
+    {
+        mEntries.clear();
+        mModified = false;
+        if (!std::filesystem::exists(path))
+            return;
+        try
+        {
+            const std::uintmax_t fileSize = std::filesystem::file_size(path);
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream)
+                throw std::runtime_error("failed to open file");
+
+            std::string magic(sMagic.size(), '\0');
+            stream.read(magic.data(), magic.size());
+            if (magic != sMagic || readValue<std::uint32_t>(stream) != sFormatVersion)
+            {
+                Log(Debug::Info) << "Ignoring Lua bytecode cache \"" << path << "\" with unsupported format";
+                mModified = true;
+                return;
+            }
+            if (readString(stream, fileSize) != mLuaVersion)
+            {
+                Log(Debug::Info) << "Ignoring Lua bytecode cache \"" << path << "\" created by another Lua version";
+                mModified = true;
+                return;
+            }
+
+            const auto count = readValue<std::uint64_t>(stream);
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                VFS::Path::Normalized scriptPath(readString(stream, fileSize));
+                Entry entry;
+                entry.mSourceHash[0] = readValue<std::uint64_t>(stream);
+                entry.mSourceHash[1] = readValue<std::uint64_t>(stream);
+                entry.mBytecode = readString(stream, fileSize);
+                entry.mUnusedSessions = readValue<std::uint32_t>(stream);
+                mEntries.insert_or_assign(std::move(scriptPath), std::move(entry));
+            }
+            Log(Debug::Info) << "Loaded Lua bytecode cache \"" << path << "\" (" << mEntries.size() << " scripts, "
+                             << fileSize << " bytes)";
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load Lua bytecode cache \"" << path << "\": " << e.what();
+            mEntries.clear();
+            mModified = true;
+        }
+    }
+
+    void BytecodeCache::updateUsage()
+    {
+        for (auto it = mEntries.begin(); it != mEntries.end();)
+        {
+            Entry& entry = it->second;
+            const std::uint32_t unusedSessions = entry.mUsed ? 0 : entry.mUnusedSessions + 1;
+            entry.mUsed = false;
+            if (unusedSessions != entry.mUnusedSessions)
+                mModified = true;
+            if (unusedSessions > sMaxUnusedSessions)
+            {
+                it = mEntries.erase(it);
+                continue;
+            }
+            entry.mUnusedSessions = unusedSessions;
+            ++it;
+        }
+    }
+
+    void BytecodeCache::save(const std::filesystem::path& path)
+    {
+        updateUsage();
+        if (!mModified)
+            return;
+        try
+        {
+            std::filesystem::create_directories(path.parent_path());
+            std::filesystem::path tmpPath = path;
+            tmpPath += ".tmp";
+            {
+                std::ofstream stream(tmpPath, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                stream.write(sMagic.data(), sMagic.size());
+                writeValue(stream, sFormatVersion);
+                writeString(stream, mLuaVersion);
+                writeValue(stream, static_cast<std::uint64_t>(mEntries.size()));
+                for (const auto& [scriptPath, entry] : mEntries)
+                {
+                    writeString(stream, scriptPath.value());
+                    writeValue(stream, entry.mSourceHash[0]);
+                    writeValue(stream, entry.mSourceHash[1]);
+                    writeString(stream, entry.mBytecode);
+                    writeValue(stream, entry.mUnusedSessions);
+                }
+            }
+            std::filesystem::rename(tmpPath, path);
+            mModified = false;
+            Log(Debug::Info) << "Saved Lua bytecode cache \"" << path << "\" (" << mEntries.size() << " scripts)";
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save Lua bytecode cache \"" << path << "\": " << e.what();
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef COMPONENTS_LUA_BYTECODECACHE_H
+#define COMPONENTS_LUA_BYTECODECACHE_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include <components/vfs/pathutil.hpp>
+
+namespace LuaUtil
+{
+    // Persistent storage for compiled Lua chunks. Entries are keyed by VFS path and validated by the hash
+    // of the script source, so a modified script is recompiled even if the cache file is not deleted.
+    // The whole cache is discarded on load if it was written by a different Lua version. Entries which were not
+    // used during several sessions in a row are dropped on save, so removed or renamed scripts don't stay forever.
+    class BytecodeCache
+    {
+    public:
+        using SourceHash = std::array<std::uint64_t, 2>;
+
+        // Number of sessions in a row an entry may stay unused before it is removed.
+        static constexpr std::uint32_t sMaxUnusedSessions = 4;
+
+        explicit BytecodeCache(std::string luaVersion)
+            : mLuaVersion(std::move(luaVersion))
+        {
+        }
+
+        // Returns nullptr if there is no entry for the path or if it was compiled from a different source.
+        // A found entry is marked as used during this session.
+        const std::string* find(VFS::Path::NormalizedView path, const SourceHash& sourceHash);
+
+        void insert(VFS::Path::NormalizedView path, const SourceHash& sourceHash, std::string bytecode);
+
+        void erase(VFS::Path::NormalizedView path);
+
+        void clear();
+
+        // Errors are logged and result in an empty cache, a broken cache file shouldn't prevent the game from
+        // starting.
+        void load(const std::filesystem::path& path);
+
+        // Removes entries unused for more than sMaxUnusedSessions sessions. Does nothing if no entry was added,
+        // removed or left unused since the last load or save.
+        void save(const std::filesystem::path& path);
+
+        std::size_t size() const { return mEntries.size(); }
+
+        bool isModified() const { return mModified; }
+
+    private:
+        struct Entry
+        {
+            SourceHash mSourceHash;
+            std::string mBytecode;
+            // Number of saves in a row this entry was not used before, stored in the file.
+            std::uint32_t mUnusedSessions = 0;
+            bool mUsed = false;
+        };
+
+        // Updates the unused session counters and removes stale entries.
+        void updateUsage();
+
+        std::string mLuaVersion;
+        std::map<VFS::Path::Normalized, Entry, std::less<>> mEntries;
+        bool mModified = false;
+    };
+}
+
+#endif // COMPONENTS_LUA_BYTECODECACHE_H
@@ -0,0 +1,73 @@
+#include "framebudget.hpp"
+
+#include <algorithm>
+
+namespace LuaUtil
+{
+    void FrameBudget::startFrame()
+    {
+        mLastFrameStats = mFrameStats;
+        mFrameStats = Stats{};
+        mFrameTime = Clock::duration(0);
+
+        const std::uint64_t budget = mSettings.mInstructionsPerScript;
+        if (budget == 0)
+            return;
+        const std::uint64_t maxThrottle = static_cast<std::uint64_t>(mSettings.mMaxDeferredFrames) + 1;
+        for (ScriptUsage& usage : mScripts)
+        {
+            ++usage.mFrames;
+            if (usage.mFrames < usage.mThrottle)
+                continue;
+            // Every window of `mThrottle` frames contains exactly one `onUpdate` call, so the instructions used
+            // during the window are what a single call costs (plus events and timers). Choose the window size that
+            // spreads this cost to fit the budget.
+            const auto instructions = static_cast<std::uint64_t>(std::max<std::int64_t>(usage.mInstructions, 0));
+            const std::uint64_t throttle = (instructions + budget - 1) / budget;
+            usage.mThrottle = static_cast<unsigned>(std::clamp<std::uint64_t>(throttle, 1, maxThrottle));
+            usage.mInstructions = 0;
+            usage.mFrames = 0;
+        }
+        mFrameStats.mThrottledScripts = static_cast<unsigned>(
+            std::count_if(mScripts.begin(), mScripts.end(), [](const ScriptUsage& v) { return v.mThrottle > 1; }));
+    }
+
+    void FrameBudget::addInstructions(int scriptId, std::int64_t count)
+    {
+        if (mSettings.mInstructionsPerScript == 0 || scriptId < 0)
+            return;
+        if (static_cast<std::size_t>(scriptId) >= mScripts.size())
+            mScripts.resize(scriptId + 1);
+        mScripts[scriptId].mInstructions += count;
+    }
+
+    bool FrameBudget::shouldUpdate(int scriptId, unsigned deferredFrames)
+    {
+        if (deferredFrames >= mSettings.mMaxDeferredFrames)
+            return true;
+        if (scriptId >= 0 && static_cast<std::size_t>(scriptId) < mScripts.size()
+            && mScripts[scriptId].mFrames != 0)
+            return false;
+        if (isTimeExhausted())
+        {
+            ++mFrameStats.mDeferredUpdates;
+            return false;
+        }
+        return true;
+    }
+
+    bool FrameBudget::shouldDeferTimers()
+    {
+        if (!isTimeExhausted())
+            return false;
+        ++mFrameStats.mDeferredTimerQueues;
+        return true;
+    }
+
+    unsigned FrameBudget::getThrottle(int scriptId) const
+    {
+        if (scriptId < 0 || static_cast<std::size_t>(scriptId) >= mScripts.size())
+            return 1;
+        return mScripts[scriptId].mThrottle;
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef COMPONENTS_LUA_FRAMEBUDGET_H
+#define COMPONENTS_LUA_FRAMEBUDGET_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace LuaUtil
+{
+    struct FrameBudgetSettings
+    {
+        // Instructions per frame a script can use before it is throttled, 0 is unlimited.
+        // Works only if the Lua profiler is enabled, otherwise instructions are not counted.
+        std::uint64_t mInstructionsPerScript = 0;
+        // Time per frame for `onUpdate` handlers and timers, 0 is unlimited.
+        std::chrono::steady_clock::duration mTime{ 0 };
+        // The maximal number of frames `onUpdate` of a script can be postponed.
+        unsigned mMaxDeferredFrames = 8;
+    };
+
+    // Keeps deferrable work of Lua scripts (`onUpdate` handlers and timers) within per frame budgets.
+    //   - When the time budget of a frame is spent, remaining `onUpdate` handlers and due timers are postponed
+    //     to the next frames. Postponed `onUpdate` handlers receive the accumulated time step.
+    //   - A script that uses more instructions per frame than allowed is throttled: its `onUpdate` is called only
+    //     every N-th frame, where N is chosen to bring the average usage within the budget.
+    class FrameBudget
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Stats
+        {
+            unsigned mDeferredUpdates = 0;
+            unsigned mDeferredTimerQueues = 0;
+            unsigned mThrottledScripts = 0;
+        };
+
+        explicit FrameBudget(const FrameBudgetSettings& settings = {})
+            : mSettings(settings)
+        {
+        }
+
+        const FrameBudgetSettings& getSettings() const { return mSettings; }
+
+        bool isTimeLimited() const { return mSettings.mTime.count() > 0; }
+
+        // Should be called once per frame before any deferrable work.
+        void startFrame();
+
+        void addInstructions(int scriptId, std::int64_t count);
+
+        void addTime(Clock::duration time) { mFrameTime += time; }
+
+        bool isTimeExhausted() const { return isTimeLimited() && mFrameTime >= mSettings.mTime; }
+
+        // Returns true if `onUpdate` of the script should be called in the current frame. `deferredFrames` is the
+        // number of frames `onUpdate` of this script was postponed in a row.
+        bool shouldUpdate(int scriptId, unsigned deferredFrames);
+
+        // Returns true if the remaining due timers of a queue should be postponed.
+        bool shouldDeferTimers();
+
+        // The interval in frames between `onUpdate` calls of the script. 1 if the script is not throttled.
+        unsigned getThrottle(int scriptId) const;
+
+        // Stats of the last finished frame.
+        const Stats& getStats() const { return mLastFrameStats; }
+
+    private:
+        struct ScriptUsage
+        {
+            std::int64_t mInstructions = 0;
+            unsigned mFrames = 0;
+            unsigned mThrottle = 1;
+        };
+
+        FrameBudgetSettings mSettings;
+        std::vector<ScriptUsage> mScripts;
+        Clock::duration mFrameTime{ 0 };
+        Stats mFrameStats;
+        Stats mLastFrameStats;
+    };
+}
+
+#endif // COMPONENTS_LUA_FRAMEBUDGET_H
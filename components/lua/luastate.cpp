@@ -9,6 +9,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "luastateptr.hpp"
@@ -71,6 +72,7 @@ namespace LuaUtil
             return;
         const ScriptId& activeScript = self->mActiveScriptIdStack.back();
         activeScript.mContainer->addInstructionCount(activeScript.mIndex, countHookStep);
+        self->mFrameBudget.addInstructions(activeScript.mIndex, countHookStep);
         self->mWatchdogInstructionCounter += countHookStep;
         if (self->mSettings.mInstructionLimit > 0
             && self->mWatchdogInstructionCounter > self->mSettings.mInstructionLimit)
@@ -176,6 +178,7 @@ namespace LuaUtil
 
     LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf, const LuaStateSettings& settings)
         : mSettings(settings)
+        , mFrameBudget(settings.mFrameBudget)
         , mLuaState([&] {
             LuaStatePtr state = createLuaRuntime(this);
             sol::set_default_state(state.get());
@@ -423,11 +426,46 @@ namespace LuaUtil
                 throw std::runtime_error("Lua error: " + res.get<std::string>());
             return res;
         }
-        sol::function res = loadFromVFS(path);
+        sol::function res = mBytecodeCache ? loadWithBytecodeCache(path) : loadFromVFS(path);
         mCompiledScripts[path] = res.dump();
         return res;
     }
 
+    sol::function LuaState::loadWithBytecodeCache(const VFS::Path::Normalized& path)
+    {
+        Files::IStreamPtr stream = mVFS->get(path);
+        const BytecodeCache::SourceHash hash = Files::getHash(path.value(), *stream);
+        if (const std::string* bytecode = mBytecodeCache->find(path, hash))
+        {
+            sol::load_result res = mSol.load(*bytecode, path.value(), sol::load_mode::binary);
+            if (res.valid())
+                return res;
+            Log(Debug::Warning) << "Failed to load cached bytecode of \"" << path << "\", recompiling";
+            mBytecodeCache->erase(path);
+        }
+        std::string fileContent(std::istreambuf_iterator<char>(*stream), {});
+        sol::load_result res = mSol.load(fileContent, path.value(), sol::load_mode::text);
+        if (!res.valid())
+            throw std::runtime_error(std::string("Lua error: ") += res.get<sol::error>().what());
+        sol::function fn = res;
+        const sol::bytecode bytecode = fn.dump();
+        mBytecodeCache->insert(path, hash, std::string(bytecode.as_string_view()));
+        return fn;
+    }
+
+    void LuaState::loadBytecodeCache(const std::filesystem::path& path)
+    {
+        mBytecodeCachePath = path;
+        mBytecodeCache.emplace(getLuaVersion());
+        mBytecodeCache->load(path);
+    }
+
+    void LuaState::saveBytecodeCache()
+    {
+        if (mBytecodeCache)
+            mBytecodeCache->save(mBytecodeCachePath);
+    }
+
     sol::function LuaState::loadFromVFS(const VFS::Path::Normalized& path)
     {
         std::string fileContent(std::istreambuf_iterator<char>(*mVFS->get(path)), {});
@@ -3,13 +3,16 @@
 
 #include <filesystem>
 #include <map>
+#include <optional>
 #include <typeinfo>
 
 #include <sol/sol.hpp>
 
 #include <components/vfs/pathutil.hpp>
 
+#include "bytecodecache.hpp"
 #include "configuration.hpp"
+#include "framebudget.hpp"
 #include "luastateptr.hpp"
 
 namespace VFS
@@ -35,6 +38,7 @@ namespace LuaUtil
         uint64_t mMemoryLimit = 0; // 0 is unlimited
         uint64_t mSmallAllocMaxSize = 1024 * 1024; // big default value efficiently disables memory tracking
         bool mLogMemoryUsage = false;
+        FrameBudgetSettings mFrameBudget;
     };
 
     class LuaState;
@@ -161,6 +165,11 @@ namespace LuaUtil
 
         void dropScriptCache() { mCompiledScripts.clear(); }
 
+        // Enables persistent caching of compiled scripts. Bytecode from the given file is reused for scripts
+        // whose source hasn't changed since the file was written.
+        void loadBytecodeCache(const std::filesystem::path& path);
+        void saveBytecodeCache();
+
         const ScriptsConfiguration& getConfiguration() const { return *mConf; }
 
         // Load internal Lua library. All libraries are loaded in one sandbox and shouldn't be exposed to scripts
@@ -179,6 +188,9 @@ namespace LuaUtil
 
         const LuaStateSettings& getSettings() const { return mSettings; }
 
+        FrameBudget& getFrameBudget() { return mFrameBudget; }
+        const FrameBudget& getFrameBudget() const { return mFrameBudget; }
+
         // Note: Lua profiler can not be re-enabled after disabling.
         static void disableProfiler() { sProfilerEnabled = false; }
         static bool isProfilerEnabled() { return sProfilerEnabled; }
@@ -193,6 +205,7 @@ namespace LuaUtil
             ScriptId scriptId, const sol::protected_function& fn, Args&&... args);
 
         sol::function loadScriptAndCache(const VFS::Path::Normalized& path);
+        sol::function loadWithBytecodeCache(const VFS::Path::Normalized& path);
         static void countHook(lua_State* state, lua_Debug* ar);
         static void* trackingAllocator(void* ud, void* ptr, size_t osize, size_t nsize);
 
@@ -213,6 +226,7 @@ namespace LuaUtil
         uint64_t mTotalMemoryUsage = 0;
         uint64_t mSmallAllocMemoryUsage = 0;
         std::vector<int64_t> mMemoryUsage;
+        FrameBudget mFrameBudget;
 
         // Must be declared before mSol and all sol-related objects. Then on exit it will be destructed the last.
         LuaStatePtr mLuaState;
@@ -221,6 +235,8 @@ namespace LuaUtil
         const ScriptsConfiguration* mConf;
         sol::table mSandboxEnv;
         std::map<VFS::Path::Normalized, sol::bytecode> mCompiledScripts;
+        std::optional<BytecodeCache> mBytecodeCache;
+        std::filesystem::path mBytecodeCachePath;
         std::map<std::string, sol::object> mCommonPackages;
         const VFS::Manager* mVFS;
         std::vector<std::filesystem::path> mLibSearchPaths;
@@ -347,6 +347,37 @@ namespace LuaUtil
             list.end());
     }
 
+    void ScriptsContainer::update(float dt)
+    {
+        ensureLoaded();
+        FrameBudget& budget = mLua.getFrameBudget();
+        for (Handler& handler : mUpdateHandlers.mList)
+        {
+            handler.mDeferredTime += dt;
+            if (!budget.shouldUpdate(handler.mScriptId, handler.mDeferredFrames))
+            {
+                handler.mDeferredFrames++;
+                continue;
+            }
+            const float time = handler.mDeferredTime;
+            handler.mDeferredTime = 0;
+            handler.mDeferredFrames = 0;
+            const bool measure = budget.isTimeLimited();
+            const auto start = measure ? FrameBudget::Clock::now() : FrameBudget::Clock::time_point();
+            try
+            {
+                LuaUtil::call({ this, handler.mScriptId }, handler.mFn, time);
+            }
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << mNamePrefix << "[" << scriptPath(handler.mScriptId) << "] "
+                                  << mUpdateHandlers.mName << " failed. " << e.what();
+            }
+            if (measure)
+                budget.addTime(FrameBudget::Clock::now() - start);
+        }
+    }
+
     void ScriptsContainer::receiveEvent(std::string_view eventName, std::string_view eventData)
     {
         LoadedData& data = ensureLoaded();
@@ -364,23 +395,37 @@ namespace LuaUtil
                 Log(Debug::Error) << mNamePrefix << " can not parse eventData for '" << eventName << "': " << e.what();
                 return;
             }
-            EventHandlerList& list = it->second;
-            for (size_t i = list.size(); i > 0; --i)
+            callEventHandlers(it->second, eventName, object);
+        });
+    }
+
+    void ScriptsContainer::receiveEventValue(std::string_view eventName, const sol::object& eventValue)
+    {
+        LoadedData& data = ensureLoaded();
+        auto it = data.mEventHandlers.find(eventName);
+        if (it == data.mEventHandlers.end())
+            return;
+        mLua.protectedCall([&](LuaView&) { callEventHandlers(it->second, eventName, eventValue); });
+    }
+
+    void ScriptsContainer::callEventHandlers(
+        const EventHandlerList& list, std::string_view eventName, const sol::object& eventData)
+    {
+        for (size_t i = list.size(); i > 0; --i)
+        {
+            const Handler& h = list[i - 1];
+            try
             {
-                const Handler& h = list[i - 1];
-                try
-                {
-                    sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, object);
-                    if (res.is<bool>() && !res.as<bool>())
-                        break; // Skip other handlers if 'false' was returned.
-                }
-                catch (std::exception& e)
-                {
-                    Log(Debug::Error) << mNamePrefix << "[" << scriptPath(h.mScriptId) << "] eventHandler[" << eventName
-                                      << "] failed. " << e.what();
-                }
+                sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, eventData);
+                if (res.is<bool>() && !res.as<bool>())
+                    break; // Skip other handlers if 'false' was returned.
             }
-        });
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << mNamePrefix << "[" << scriptPath(h.mScriptId) << "] eventHandler[" << eventName
+                                  << "] failed. " << e.what();
+            }
+        }
     }
 
     void ScriptsContainer::registerEngineHandlers(std::initializer_list<EngineHandlerList*> handlers)
@@ -420,20 +465,20 @@ namespace LuaUtil
         }
         const auto& loadedData = std::get<LoadedData>(mData);
         std::map<int, std::vector<ESM::LuaTimer>> timers;
-        auto saveTimerFn = [&](const Timer& timer, TimerType timerType) {
+        auto saveTimerFn = [&](double time, const Timer& timer, TimerType timerType) {
             if (!timer.mSerializable)
                 return;
             ESM::LuaTimer savedTimer;
-            savedTimer.mTime = timer.mTime;
+            savedTimer.mTime = time;
             savedTimer.mType = timerType;
-            savedTimer.mCallbackName = std::get<std::string>(timer.mCallback);
+            savedTimer.mCallbackName = mCallbackNames[timer.mCallback];
             savedTimer.mCallbackArgument = timer.mSerializedArg;
             timers[timer.mScriptId].push_back(std::move(savedTimer));
         };
-        for (const Timer& timer : loadedData.mSimulationTimersQueue)
-            saveTimerFn(timer, TimerType::SIMULATION_TIME);
-        for (const Timer& timer : loadedData.mGameTimersQueue)
-            saveTimerFn(timer, TimerType::GAME_TIME);
+        loadedData.mSimulationTimersQueue.forEach(
+            [&](double time, const Timer& timer) { saveTimerFn(time, timer, TimerType::SIMULATION_TIME); });
+        loadedData.mGameTimersQueue.forEach(
+            [&](double time, const Timer& timer) { saveTimerFn(time, timer, TimerType::GAME_TIME); });
         data.mScripts.clear();
         for (auto& [scriptId, script] : loadedData.mScripts)
         {
@@ -581,10 +626,9 @@ namespace LuaUtil
                 for (const ESM::LuaTimer& savedTimer : scriptInfo.mSavedData->mTimers)
                 {
                     Timer timer;
-                    timer.mCallback = savedTimer.mCallbackName;
+                    timer.mCallback = internCallbackName(savedTimer.mCallbackName);
                     timer.mSerializable = true;
                     timer.mScriptId = scriptId;
-                    timer.mTime = savedTimer.mTime;
 
                     try
                     {
@@ -596,9 +640,9 @@ namespace LuaUtil
                         timer.mSerializedArg = serialize(timer.mArg, mSerializer);
 
                         if (savedTimer.mType == TimerType::GAME_TIME)
-                            data.mGameTimersQueue.push_back(std::move(timer));
+                            data.mGameTimersQueue.insert(savedTimer.mTime, std::move(timer));
                         else
-                            data.mSimulationTimersQueue.push_back(std::move(timer));
+                            data.mSimulationTimersQueue.insert(savedTimer.mTime, std::move(timer));
                     }
                     catch (std::exception& e)
                     {
@@ -608,9 +652,6 @@ namespace LuaUtil
             }
         });
 
-        std::make_heap(data.mSimulationTimersQueue.begin(), data.mSimulationTimersQueue.end());
-        std::make_heap(data.mGameTimersQueue.begin(), data.mGameTimersQueue.end());
-
         if (mTracker)
             mTracker->onLoad(*this);
 
@@ -675,30 +716,39 @@ namespace LuaUtil
         return it->second;
     }
 
-    void ScriptsContainer::registerTimerCallback(
-        int scriptId, std::string_view callbackName, sol::main_protected_function callback)
+    int64_t ScriptsContainer::internCallbackName(std::string_view name)
     {
-        getScript(scriptId).mRegisteredCallbacks.emplace(std::string(callbackName), std::move(callback));
+        auto it = mCallbackNameIds.find(name);
+        if (it != mCallbackNameIds.end())
+            return it->second;
+        const auto id = static_cast<int64_t>(mCallbackNames.size());
+        mCallbackNames.emplace_back(name);
+        mCallbackNameIds.emplace(std::string(name), id);
+        return id;
     }
 
-    void ScriptsContainer::insertTimer(std::vector<Timer>& timerQueue, Timer&& t)
+    void ScriptsContainer::registerTimerCallback(
+        int scriptId, std::string_view callbackName, sol::main_protected_function callback)
     {
-        timerQueue.push_back(std::move(t));
-        std::push_heap(timerQueue.begin(), timerQueue.end());
+        std::vector<sol::main_protected_function>& callbacks = getScript(scriptId).mRegisteredCallbacks;
+        const auto id = static_cast<size_t>(internCallbackName(callbackName));
+        if (id >= callbacks.size())
+            callbacks.resize(id + 1);
+        if (!callbacks[id].valid())
+            callbacks[id] = std::move(callback);
     }
 
     void ScriptsContainer::setupSerializableTimer(
         TimerType type, double time, int scriptId, std::string_view callbackName, sol::main_object callbackArg)
     {
         Timer t;
-        t.mCallback = std::string(callbackName);
+        t.mCallback = internCallbackName(callbackName);
         t.mScriptId = scriptId;
         t.mSerializable = true;
-        t.mTime = time;
         t.mArg = std::move(callbackArg);
         t.mSerializedArg = serialize(t.mArg, mSerializer);
         LoadedData& data = ensureLoaded();
-        insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
+        (type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue).insert(time, std::move(t));
     }
 
     void ScriptsContainer::setupUnsavableTimer(
@@ -707,13 +757,12 @@ namespace LuaUtil
         Timer t;
         t.mScriptId = scriptId;
         t.mSerializable = false;
-        t.mTime = time;
 
         t.mCallback = mTemporaryCallbackCounter;
         getScript(t.mScriptId).mTemporaryCallbacks.emplace(mTemporaryCallbackCounter, std::move(callback));
         mTemporaryCallbackCounter++;
         LoadedData& data = ensureLoaded();
-        insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
+        (type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue).insert(time, std::move(t));
     }
 
     void ScriptsContainer::callTimer(const Timer& t)
@@ -723,17 +772,21 @@ namespace LuaUtil
             Script& script = getScript(t.mScriptId);
             if (t.mSerializable)
             {
-                const std::string& callbackName = std::get<std::string>(t.mCallback);
-                auto it = script.mRegisteredCallbacks.find(callbackName);
-                if (it == script.mRegisteredCallbacks.end())
-                    throw std::logic_error("Callback '" + callbackName + "' doesn't exist");
-                LuaUtil::call({ this, t.mScriptId }, it->second, t.mArg);
+                const auto id = static_cast<size_t>(t.mCallback);
+                if (id >= script.mRegisteredCallbacks.size() || !script.mRegisteredCallbacks[id].valid())
+                    throw std::logic_error("Callback '" + mCallbackNames[id] + "' doesn't exist");
+                // A copy, since the callback can register new callbacks and reallocate the vector.
+                const sol::main_protected_function callback = script.mRegisteredCallbacks[id];
+                LuaUtil::call({ this, t.mScriptId }, callback, t.mArg);
             }
             else
             {
-                int64_t id = std::get<int64_t>(t.mCallback);
-                LuaUtil::call({ this, t.mScriptId }, script.mTemporaryCallbacks.at(id));
-                script.mTemporaryCallbacks.erase(id);
+                auto it = script.mTemporaryCallbacks.find(t.mCallback);
+                if (it == script.mTemporaryCallbacks.end())
+                    throw std::logic_error("Temporary callback doesn't exist");
+                const sol::main_protected_function callback = std::move(it->second);
+                script.mTemporaryCallbacks.erase(it);
+                LuaUtil::call({ this, t.mScriptId }, callback);
             }
         }
         catch (std::exception& e)
@@ -742,13 +795,27 @@ namespace LuaUtil
         }
     }
 
-    void ScriptsContainer::updateTimerQueue(std::vector<Timer>& timerQueue, double time)
+    void ScriptsContainer::updateTimerQueue(TimerQueue& timerQueue, double time)
     {
-        while (!timerQueue.empty() && timerQueue.front().mTime <= time)
+        FrameBudget& budget = mLua.getFrameBudget();
+        timerQueue.advance(time);
+        bool first = true;
+        while (timerQueue.hasDue(time))
         {
-            callTimer(timerQueue.front());
-            std::pop_heap(timerQueue.begin(), timerQueue.end());
-            timerQueue.pop_back();
+            // At least one due timer per queue is called every frame, so timers can not be postponed forever.
+            if (!first && budget.shouldDeferTimers())
+                break;
+            first = false;
+            // Removed from the queue before the call because the callback can add new timers.
+            const Timer timer = timerQueue.popDue();
+            if (budget.isTimeLimited())
+            {
+                const FrameBudget::Clock::time_point start = FrameBudget::Clock::now();
+                callTimer(timer);
+                budget.addTime(FrameBudget::Clock::now() - start);
+            }
+            else
+                callTimer(timer);
         }
     }
 
@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <variant>
 
 #include <components/debug/debuglog.hpp>
@@ -11,6 +12,7 @@
 
 #include "luastate.hpp"
 #include "serialization.hpp"
+#include "timerwheel.hpp"
 
 namespace LuaUtil
 {
@@ -140,7 +142,9 @@ namespace LuaUtil
 
         // Calls `onUpdate` (if present) for every script in the container.
         // Handlers are called in the same order as scripts were added.
-        void update(float dt) { callEngineHandlers(mUpdateHandlers, dt); }
+        // A handler can be postponed by LuaUtil::FrameBudget; in this case it receives the sum of the time steps
+        // of all postponed frames on the next call.
+        void update(float dt);
 
         // Calls event handlers `eventName` (if present) for every script.
         // If several scripts register handlers for `eventName`, they are called in reverse order.
@@ -148,6 +152,10 @@ namespace LuaUtil
         // (including `nil`) has no effect.
         void receiveEvent(std::string_view eventName, std::string_view eventData);
 
+        // Same as `receiveEvent`, but takes event data that is already a Lua value (see LuaUtil::copy). The value is
+        // passed to the handlers as is, without copying.
+        void receiveEventValue(std::string_view eventName, const sol::object& eventValue);
+
         // Serializer defines how to serialize/deserialize userdata. If serializer is not provided,
         // only built-in types and types from util package can be serialized.
         void setSerializer(const UserdataSerializer* serializer) { mSerializer = serializer; }
@@ -229,6 +237,9 @@ namespace LuaUtil
         {
             int mScriptId;
             sol::main_function mFn;
+            // Used only by `onUpdate` handlers postponed by LuaUtil::FrameBudget.
+            float mDeferredTime = 0;
+            unsigned mDeferredFrames = 0;
         };
 
         struct EngineHandlerList
@@ -263,7 +274,8 @@ namespace LuaUtil
         }
 
         // To add a new engine handler a derived class should register the corresponding EngineHandlerList and define
-        // a public function (see how ScriptsContainer::update is implemented) that calls `callEngineHandlers`.
+        // a public function (see how MWLua::GlobalScripts::newGameStarted is implemented) that calls
+        // `callEngineHandlers`.
         void registerEngineHandlers(std::initializer_list<EngineHandlerList*> handlers);
 
         const std::string mNamePrefix;
@@ -277,8 +289,9 @@ namespace LuaUtil
             std::optional<sol::main_table> mInterface;
             std::string mInterfaceName;
             sol::main_table mHiddenData;
-            std::map<std::string, sol::main_protected_function> mRegisteredCallbacks;
-            std::map<int64_t, sol::main_protected_function> mTemporaryCallbacks;
+            // Indexed by interned callback name, see ScriptsContainer::internCallbackName.
+            std::vector<sol::main_protected_function> mRegisteredCallbacks;
+            std::unordered_map<int64_t, sol::main_protected_function> mTemporaryCallbacks;
             VFS::Path::Normalized mPath;
             ScriptStats mStats;
 
@@ -286,17 +299,19 @@ namespace LuaUtil
         };
         struct Timer
         {
-            double mTime;
             bool mSerializable;
             int mScriptId;
-            std::variant<std::string, int64_t> mCallback; // string if serializable, integer otherwise
+            // Interned callback name if serializable, key in Script::mTemporaryCallbacks otherwise.
+            int64_t mCallback;
             sol::main_object mArg;
             std::string mSerializedArg;
-
-            bool operator<(const Timer& t) const { return mTime > t.mTime; }
         };
+        using TimerQueue = TimerWheel<Timer>;
         using EventHandlerList = std::vector<Handler>;
 
+        // Resolution of timer queues. Both simulation and game time are measured in seconds.
+        static constexpr double sTimerTicksPerSecond = 16;
+
         friend class LuaState;
         void addInstructionCount(int scriptId, int64_t instructionCount);
         void addMemoryUsage(int scriptId, int64_t memoryDelta);
@@ -317,8 +332,9 @@ namespace LuaUtil
 
         void callOnInit(LuaView& view, int scriptId, const sol::function& onInit, std::string_view data);
         void callTimer(const Timer& t);
-        void updateTimerQueue(std::vector<Timer>& timerQueue, double time);
-        static void insertTimer(std::vector<Timer>& timerQueue, Timer&& t);
+        void callEventHandlers(const EventHandlerList& list, std::string_view eventName, const sol::object& eventData);
+        void updateTimerQueue(TimerQueue& timerQueue, double time);
+        int64_t internCallbackName(std::string_view name);
         static void insertHandler(std::vector<Handler>& list, int scriptId, sol::function fn);
         static void removeHandler(std::vector<Handler>& list, int scriptId);
         void insertInterface(int scriptId, const Script& script);
@@ -337,8 +353,8 @@ namespace LuaUtil
 
             std::map<std::string, EventHandlerList, std::less<>> mEventHandlers;
 
-            std::vector<Timer> mSimulationTimersQueue;
-            std::vector<Timer> mGameTimersQueue;
+            TimerQueue mSimulationTimersQueue{ sTimerTicksPerSecond };
+            TimerQueue mGameTimersQueue{ sTimerTicksPerSecond };
         };
         using UnloadedData = ESM::LuaScripts;
 
@@ -353,6 +369,8 @@ namespace LuaUtil
         std::map<std::string_view, EngineHandlerList*> mEngineHandlers;
         std::variant<UnloadedData, LoadedData> mData;
         int64_t mTemporaryCallbackCounter = 0;
+        std::vector<std::string> mCallbackNames;
+        std::map<std::string, int64_t, std::less<>> mCallbackNameIds;
 
         std::map<int, int64_t> mRemovedScriptsMemoryUsage;
         ScriptsContainerLifetime mThis; // used by LuaState to track ownership of memory allocations
@@ -356,6 +356,73 @@ namespace LuaUtil
         throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
     }
 
+    static void copyUserdata(lua_State* lua, const sol::userdata& data, const UserdataSerializer* customSerializer)
+    {
+        // These types are immutable from Lua, so the copy can share the same userdata.
+        if (data.is<osg::Vec2f>() || data.is<osg::Vec3f>() || data.is<osg::Vec4f>() || data.is<TransformM>()
+            || data.is<TransformQ>() || data.is<Misc::Color>())
+        {
+            sol::stack::push(lua, data);
+            return;
+        }
+        if (customSerializer && customSerializer->copy(data, lua))
+            return;
+        else
+            throw std::runtime_error("Value is not serializable.");
+    }
+
+    // Pushes on stack a copy of the value at the given stack index.
+    static void copyImpl(lua_State* lua, int index, const UserdataSerializer* customSerializer, int recursionCounter)
+    {
+        if (index < 0)
+            index = lua_gettop(lua) + index + 1;
+        const int type = lua_type(lua, index);
+        if (type == LUA_TTABLE || type == LUA_TUSERDATA)
+        {
+            if (luaL_getmetafield(lua, index, "__call"))
+            {
+                lua_pop(lua, 1);
+                throw std::runtime_error("Functions are not allowed to be serialized.");
+            }
+        }
+        switch (type)
+        {
+            case LUA_TNUMBER:
+            case LUA_TBOOLEAN:
+            case LUA_TSTRING: // strings are immutable and interned by Lua, no need to copy them
+                lua_pushvalue(lua, index);
+                return;
+            case LUA_TLIGHTUSERDATA:
+                throw std::runtime_error("Light userdata is not allowed to be serialized.");
+            case LUA_TFUNCTION:
+                throw std::runtime_error("Functions are not allowed to be serialized.");
+            case LUA_TUSERDATA:
+                copyUserdata(lua, sol::userdata(lua, index), customSerializer);
+                return;
+            case LUA_TTABLE:
+            {
+                if (recursionCounter >= 32)
+                    throw std::runtime_error(
+                        "Can not serialize more than 32 nested tables. Likely the table contains itself.");
+                if (!lua_checkstack(lua, 5))
+                    throw std::runtime_error("Lua error: out of memory");
+                lua_createtable(lua, 0, 0);
+                lua_pushnil(lua);
+                while (lua_next(lua, index) != 0)
+                {
+                    // Stack: copy, key, value
+                    copyImpl(lua, -2, customSerializer, recursionCounter + 1);
+                    copyImpl(lua, -2, customSerializer, recursionCounter + 1);
+                    lua_rawset(lua, -5);
+                    lua_pop(lua, 1);
+                }
+                return;
+            }
+            default:
+                throw std::runtime_error("Unknown Lua type.");
+        }
+    }
+
     BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
     {
         if (obj == sol::nil)
@@ -381,4 +448,23 @@ namespace LuaUtil
         return sol::stack::pop<sol::object>(lua);
     }
 
+    sol::object copy(lua_State* lua, const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
+        if (obj == sol::nil)
+            return sol::nil;
+        const int top = lua_gettop(lua);
+        try
+        {
+            sol::stack::push(lua, obj);
+            copyImpl(lua, -1, customSerializer, 0);
+        }
+        catch (...)
+        {
+            lua_settop(lua, top);
+            throw;
+        }
+        lua_remove(lua, -2);
+        return sol::stack::pop<sol::object>(lua);
+    }
+
 }
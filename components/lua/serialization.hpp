@@ -24,6 +24,10 @@ namespace LuaUtil
         // sol::stack::push. Returns false if this type is not supported by this serializer.
         virtual bool deserialize(std::string_view typeName, std::string_view binaryData, lua_State*) const = 0;
 
+        // Pushes on stack a copy of sol::userdata in the form that `deserialize` would produce. Is used by
+        // LuaUtil::copy. Returns false if this type of userdata is not supported by this serializer.
+        virtual bool copy(const sol::userdata&, lua_State*) const { return false; }
+
     protected:
         static void append(BinaryData&, std::string_view typeName, const void* data, size_t dataSize);
 
@@ -54,6 +58,10 @@ namespace LuaUtil
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
+    // Equivalent of `deserialize(lua, serialize(obj), customSerializer)`, but doesn't create the intermediate
+    // binary representation. Tables are copied, immutable values (strings, vectors, etc.) are shared.
+    sol::object copy(lua_State* lua, const sol::object& obj, const UserdataSerializer* customSerializer = nullptr);
+
 }
 
 #endif // COMPONENTS_LUA_SERIALIZATION_H
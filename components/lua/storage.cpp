@@ -1,9 +1,13 @@
 #include "storage.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <vector>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/endianness.hpp>
 
 #include "luastate.hpp"
 
@@ -17,6 +21,61 @@ namespace sol
 
 namespace LuaUtil
 {
+    namespace
+    {
+        constexpr std::string_view sLogMagic = "OMWLUAST";
+        constexpr std::uint32_t sLogFormatVersion = 1;
+
+        // The log is rewritten when it becomes this many times bigger than the data it contains.
+        constexpr std::uintmax_t sLogCompactionRatio = 2;
+        constexpr std::uintmax_t sLogMinCompactionSize = 64 * 1024;
+
+        enum class LogRecord : char
+        {
+            Set = 1,
+            Remove = 2,
+            ClearSection = 3,
+        };
+
+        void appendLogString(std::string& out, std::string_view str)
+        {
+            const std::uint32_t size = Misc::toLittleEndian(static_cast<std::uint32_t>(str.size()));
+            out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+            out.append(str);
+        }
+
+        std::string_view readLogString(std::string_view& data)
+        {
+            std::uint32_t size;
+            if (data.size() < sizeof(size))
+                throw std::runtime_error("Unexpected end of storage log");
+            std::memcpy(&size, data.data(), sizeof(size));
+            size = Misc::fromLittleEndian(size);
+            data.remove_prefix(sizeof(size));
+            if (data.size() < size)
+                throw std::runtime_error("Unexpected end of storage log");
+            std::string_view res = data.substr(0, size);
+            data.remove_prefix(size);
+            return res;
+        }
+
+        void appendLogRecord(std::string& out, LogRecord type, std::string_view section, std::string_view key = {},
+            std::string_view value = {})
+        {
+            out.push_back(static_cast<char>(type));
+            appendLogString(out, section);
+            if (type != LogRecord::ClearSection)
+                appendLogString(out, key);
+            if (type == LogRecord::Set)
+                appendLogString(out, value);
+        }
+
+        std::uintmax_t getSetRecordSize(std::string_view section, std::string_view key, std::string_view value)
+        {
+            return 1 + 3 * sizeof(std::uint32_t) + section.size() + key.size() + value.size();
+        }
+    }
+
     LuaStorage::Value LuaStorage::Section::sEmpty;
 
     void LuaStorage::registerLifeTime(LuaUtil::LuaView& view, sol::table& res)
@@ -95,6 +154,8 @@ namespace LuaUtil
             if (it != mValues.end())
                 mValues.erase(it);
         }
+        if (mLifeTime == Persistent)
+            mStorage->markDirty(*this, key);
         if (mStorage->mListener)
             mStorage->mListener->valueChanged(mSectionName, key, value);
         runCallbacks(key);
@@ -110,11 +171,23 @@ namespace LuaUtil
             for (const auto& [k, v] : *values)
                 mValues[cast<std::string>(k)] = Value(v);
         }
+        if (mLifeTime == Persistent)
+            mStorage->markDirty(*this, sol::nullopt);
         if (mStorage->mListener)
             mStorage->mListener->sectionReplaced(mSectionName, values);
         runCallbacks(sol::nullopt);
     }
 
+    void LuaStorage::Section::setLifeTime(LifeTime lifeTime)
+    {
+        if (lifeTime == mLifeTime)
+            return;
+        // The section should be either written to or removed from the storage file.
+        if (lifeTime == Persistent || mLifeTime == Persistent)
+            mStorage->markDirty(*this, sol::nullopt);
+        mLifeTime = lifeTime;
+    }
+
     sol::table LuaStorage::Section::asTable(lua_State* state)
     {
         checkIfActive();
@@ -154,12 +227,12 @@ namespace LuaUtil
         sview["removeOnExit"] = [](const SectionView& section) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = Section::Temporary;
+            section.mSection->setLifeTime(Section::Temporary);
         };
         sview["setLifeTime"] = [](const SectionView& section, Section::LifeTime lifeTime) {
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
-            section.mSection->mLifeTime = lifeTime;
+            section.mSection->setLifeTime(lifeTime);
         };
         sview["set"] = [](const SectionView& section, std::string_view key, const sol::object& value) {
             if (section.mReadOnly)
@@ -264,33 +337,236 @@ namespace LuaUtil
 
             std::ifstream fin(path, std::fstream::binary);
             std::string serializedData((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
-            sol::table data = deserialize(state, serializedData);
-            for (const auto& [sectionName, sectionTable] : data)
+            if (serializedData.starts_with(sLogMagic))
             {
-                const std::shared_ptr<Section>& section = getSection(cast<std::string_view>(sectionName));
-                for (const auto& [key, value] : cast<sol::table>(sectionTable))
-                    section->set(cast<std::string_view>(key), value);
+                mLogPath = path;
+                mLogSize = serializedData.size();
+                loadLog(serializedData);
+            }
+            else
+            {
+                // Storage files of older versions contain a single serialized table. Such a file is rewritten
+                // as a log on the next save.
+                sol::table data = deserialize(state, serializedData);
+                for (const auto& [sectionName, sectionTable] : data)
+                {
+                    const std::shared_ptr<Section>& section = getSection(cast<std::string_view>(sectionName));
+                    for (const auto& [key, value] : cast<sol::table>(sectionTable))
+                        section->set(cast<std::string_view>(key), value);
+                }
             }
         }
         catch (std::exception& e)
         {
             Log(Debug::Error) << "Cannot read \"" << path << "\": " << e.what();
+            mLogPath.clear();
+        }
+        mDirtySections.clear();
+        mLiveDataSize = sLogMagic.size() + sizeof(sLogFormatVersion);
+        for (const auto& [sectionName, section] : mData)
+        {
+            for (const auto& [key, value] : section->mValues)
+                mLiveDataSize += getSetRecordSize(sectionName, key, value.getSerialized());
+        }
+    }
+
+    void LuaStorage::loadLog(std::string_view data)
+    {
+        data.remove_prefix(sLogMagic.size());
+        std::uint32_t version;
+        if (data.size() < sizeof(version))
+            throw std::runtime_error("Unexpected end of storage log");
+        std::memcpy(&version, data.data(), sizeof(version));
+        if (Misc::fromLittleEndian(version) != sLogFormatVersion)
+            throw std::runtime_error("Unsupported storage log version " + std::to_string(version));
+        data.remove_prefix(sizeof(version));
+
+        while (!data.empty())
+        {
+            // Records are parsed before applying, so an incomplete record at the end (e.g. if the game crashed
+            // while saving) is ignored.
+            std::string_view record = data;
+            const auto type = static_cast<LogRecord>(record.front());
+            record.remove_prefix(1);
+            std::string_view sectionName, key, value;
+            try
+            {
+                sectionName = readLogString(record);
+                if (type != LogRecord::ClearSection)
+                    key = readLogString(record);
+                if (type == LogRecord::Set)
+                    value = readLogString(record);
+            }
+            catch (std::exception& e)
+            {
+                Log(Debug::Warning) << "Ignoring incomplete record at the end of Lua storage: " << e.what();
+                mLogPath.clear();
+                return;
+            }
+            data = record;
+            Section& section = *getSection(sectionName);
+            switch (type)
+            {
+                case LogRecord::Set:
+                    section.mValues.insert_or_assign(std::string(key), Value::fromSerialized(std::string(value)));
+                    break;
+                case LogRecord::Remove:
+                    if (auto it = section.mValues.find(key); it != section.mValues.end())
+                        section.mValues.erase(it);
+                    break;
+                case LogRecord::ClearSection:
+                    section.mValues.clear();
+                    break;
+                default:
+                    throw std::runtime_error("Invalid storage log record type " + std::to_string(int(type)));
+            }
+        }
+    }
+
+    void LuaStorage::save(lua_State* /*state*/, const std::filesystem::path& path)
+    {
+        try
+        {
+            if (path != mLogPath || mLogSize > sLogCompactionRatio * std::max(mLiveDataSize, sLogMinCompactionSize))
+                writeLog(path);
+            else
+                appendToLog();
+            mDirtySections.clear();
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Cannot save Lua storage \"" << path << "\": " << e.what();
+            mLogPath.clear();
         }
     }
 
-    void LuaStorage::save(lua_State* state, const std::filesystem::path& path) const
+    StorageSnapshot LuaStorage::makeSnapshot() const
     {
-        sol::table data(state, sol::create);
+        StorageSnapshot snapshot;
         for (const auto& [sectionName, section] : mData)
         {
-            if (section->mLifeTime == Section::Persistent && !section->mValues.empty())
-                data[sectionName] = section->asTable(state);
+            if (section->mLifeTime != Section::GameSession)
+                continue;
+            StorageSnapshot::Values& values = snapshot.mSections[std::string(sectionName)];
+            for (const auto& [key, value] : section->mValues)
+                values.emplace(key, value.getSerialized());
         }
-        std::string serializedData = serialize(data);
-        Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
-        std::ofstream fout(path, std::fstream::binary);
-        fout.write(serializedData.data(), serializedData.size());
+        return snapshot;
+    }
+
+    void LuaStorage::restoreSnapshot(const StorageSnapshot& snapshot)
+    {
+        checkIfActive();
+        std::vector<std::shared_ptr<Section>> changedSections;
+        for (const auto& [sectionName, section] : mData)
+        {
+            if (section->mLifeTime != Section::GameSession || snapshot.mSections.contains(sectionName)
+                || section->mValues.empty())
+                continue;
+            section->mValues.clear();
+            changedSections.push_back(section);
+        }
+        for (const auto& [sectionName, values] : snapshot.mSections)
+        {
+            // Sections which were made persistent or temporary since the snapshot are left as they are
+            const auto it = mData.find(sectionName);
+            if (it != mData.end() && it->second->mLifeTime != Section::GameSession)
+                continue;
+            const std::shared_ptr<Section>& section = getSection(sectionName);
+            section->setLifeTime(Section::GameSession);
+            const auto equal = [](const auto& l, const auto& r) {
+                return l.first == r.first && l.second.getSerialized() == r.second;
+            };
+            const bool unchanged
+                = std::equal(section->mValues.begin(), section->mValues.end(), values.begin(), values.end(), equal);
+            if (unchanged)
+                continue;
+            section->mValues.clear();
+            for (const auto& [key, value] : values)
+                section->mValues.emplace(key, Value::fromSerialized(value));
+            changedSections.push_back(section);
+        }
+        for (const std::shared_ptr<Section>& section : changedSections)
+            section->runCallbacks(sol::nullopt);
+    }
+
+    void LuaStorage::writeLog(const std::filesystem::path& path)
+    {
+        std::string data(sLogMagic);
+        const std::uint32_t version = Misc::toLittleEndian(sLogFormatVersion);
+        data.append(reinterpret_cast<const char*>(&version), sizeof(version));
+        for (const auto& [sectionName, section] : mData)
+        {
+            if (section->mLifeTime != Section::Persistent)
+                continue;
+            for (const auto& [key, value] : section->mValues)
+                appendLogRecord(data, LogRecord::Set, sectionName, key, value.getSerialized());
+        }
+        Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << data.size() << " bytes)";
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream fout(tmpPath, std::fstream::binary);
+            fout.exceptions(std::ios::failbit | std::ios::badbit);
+            fout.write(data.data(), data.size());
+        }
+        std::filesystem::rename(tmpPath, path);
+        mLogPath = path;
+        mLogSize = data.size();
+        mLiveDataSize = data.size();
+    }
+
+    void LuaStorage::appendToLog()
+    {
+        std::string data;
+        for (const auto& [sectionName, dirty] : mDirtySections)
+        {
+            auto it = mData.find(sectionName);
+            const Section* section = it != mData.end() ? it->second.get() : nullptr;
+            if (section == nullptr || section->mLifeTime != Section::Persistent)
+            {
+                appendLogRecord(data, LogRecord::ClearSection, sectionName);
+                continue;
+            }
+            if (dirty.mReplaced)
+            {
+                appendLogRecord(data, LogRecord::ClearSection, sectionName);
+                for (const auto& [key, value] : section->mValues)
+                    appendLogRecord(data, LogRecord::Set, sectionName, key, value.getSerialized());
+                continue;
+            }
+            for (const std::string& key : dirty.mKeys)
+            {
+                auto valueIt = section->mValues.find(key);
+                if (valueIt != section->mValues.end())
+                    appendLogRecord(data, LogRecord::Set, sectionName, key, valueIt->second.getSerialized());
+                else
+                    appendLogRecord(data, LogRecord::Remove, sectionName, key);
+            }
+        }
+        if (data.empty())
+            return;
+        Log(Debug::Verbose) << "Appending " << data.size() << " bytes to Lua storage \"" << mLogPath << "\"";
+        std::ofstream fout(mLogPath, std::fstream::binary | std::fstream::app);
+        fout.exceptions(std::ios::failbit | std::ios::badbit);
+        fout.write(data.data(), data.size());
         fout.close();
+        mLogSize += data.size();
+    }
+
+    void LuaStorage::markDirty(const Section& section, sol::optional<std::string_view> key)
+    {
+        auto it = mDirtySections.find(section.mSectionName);
+        if (it == mDirtySections.end())
+            it = mDirtySections.emplace(section.mSectionName, DirtySection()).first;
+        DirtySection& dirty = it->second;
+        if (!key)
+        {
+            dirty.mReplaced = true;
+            dirty.mKeys.clear();
+        }
+        else if (!dirty.mReplaced)
+            dirty.mKeys.emplace(*key);
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
@@ -1,12 +1,15 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <filesystem>
 #include <map>
+#include <set>
 #include <sol/sol.hpp>
 #include <stdexcept>
 
 #include "asyncpackage.hpp"
 #include "serialization.hpp"
+#include "storagesnapshot.hpp"
 
 namespace LuaUtil
 {
@@ -27,7 +30,17 @@ namespace LuaUtil
 
         void clearTemporaryAndRemoveCallbacks();
         void load(lua_State* state, const std::filesystem::path& path);
-        void save(lua_State* state, const std::filesystem::path& path) const;
+
+        // The storage file is an append-only log of changes. If `path` is the file the storage was loaded from or
+        // saved to the last time, only changes since then are appended. The file is rewritten if the log became
+        // much bigger than the data it contains.
+        void save(lua_State* state, const std::filesystem::path& path);
+
+        // Snapshots include only the sections with the GameSession life time, persistent sections survive restoring
+        // a snapshot like they survive loading a saved game. Restoring a snapshot replaces the values of the
+        // GameSession sections and runs the callbacks of the changed sections.
+        StorageSnapshot makeSnapshot() const;
+        void restoreSnapshot(const StorageSnapshot& snapshot);
 
         sol::object getSection(
             lua_State* state, std::string_view sectionName, bool readOnly, bool forMenuScripts = false);
@@ -71,8 +84,15 @@ namespace LuaUtil
                 : mSerializedValue(serialize(value))
             {
             }
+            static Value fromSerialized(std::string serializedValue)
+            {
+                Value res;
+                res.mSerializedValue = std::move(serializedValue);
+                return res;
+            }
             sol::object getCopy(lua_State* state) const;
             sol::object getReadOnly(lua_State* state) const;
+            const std::string& getSerialized() const { return mSerializedValue; }
 
         private:
             std::string mSerializedValue;
@@ -96,6 +116,7 @@ namespace LuaUtil
             const Value& get(std::string_view key) const;
             void set(std::string_view key, const sol::object& value);
             void setAll(const sol::optional<sol::table>& values);
+            void setLifeTime(LifeTime lifeTime);
             sol::table asTable(lua_State* state);
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
@@ -118,9 +139,25 @@ namespace LuaUtil
             bool mForMenuScripts = false;
         };
 
+        // Changes that are not yet written to the storage file.
+        struct DirtySection
+        {
+            bool mReplaced = false; // if true, the whole section should be rewritten
+            std::set<std::string, std::less<>> mKeys;
+        };
+
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
 
+        void markDirty(const Section& section, sol::optional<std::string_view> key);
+        void loadLog(std::string_view data);
+        void writeLog(const std::filesystem::path& path);
+        void appendToLog();
+
         std::map<std::string_view, std::shared_ptr<Section>> mData;
+        std::map<std::string, DirtySection, std::less<>> mDirtySections;
+        std::filesystem::path mLogPath; // the file that is in sync with mData except for mDirtySections
+        std::uintmax_t mLogSize = 0;
+        std::uintmax_t mLiveDataSize = 0; // size of the log after the last rewrite
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
         bool mActive = false;
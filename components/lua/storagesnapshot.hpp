@@ -0,0 +1,19 @@
+#ifndef COMPONENTS_LUA_STORAGESNAPSHOT_H
+#define COMPONENTS_LUA_STORAGESNAPSHOT_H
+
+#include <functional>
+#include <map>
+#include <string>
+
+namespace LuaUtil
+{
+    // Serialized values of the LuaStorage sections with the GameSession life time.
+    struct StorageSnapshot
+    {
+        using Values = std::map<std::string, std::string, std::less<>>;
+
+        std::map<std::string, Values, std::less<>> mSections;
+    };
+}
+
+#endif // COMPONENTS_LUA_STORAGESNAPSHOT_H
@@ -0,0 +1,195 @@
+#ifndef COMPONENTS_LUA_TIMERWHEEL_H
+#define COMPONENTS_LUA_TIMERWHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace LuaUtil
+{
+    // Hierarchical timer wheel. Time is split into ticks of size `1 / ticksPerUnit`, a timer is stored in a slot
+    // of the level that corresponds to the distance to its tick, so inserting a timer is O(1). While the wheel
+    // advances, slots of the upper levels are redistributed to the lower ones and each timer is moved at most
+    // `sLevels` times, empty slots are skipped using occupancy bitmasks.
+    // Timers of the current tick are kept in a small binary heap, so due timers are returned in the order of
+    // their time (timers with equal time in the order of insertion).
+    template <class T>
+    class TimerWheel
+    {
+    public:
+        explicit TimerWheel(double ticksPerUnit)
+            : mTicksPerUnit(ticksPerUnit)
+        {
+        }
+
+        void insert(double time, T value)
+        {
+            place(Entry{ time, toTick(time), mNextSequence++, std::move(value) });
+            ++mSize;
+        }
+
+        // Prepares all timers with time <= `time` to be returned by `popDue`.
+        void advance(double time)
+        {
+            const std::int64_t target = toTick(time);
+            while (mCurrentTick < target)
+            {
+                mCurrentTick = findNextTick(target);
+                if (!mOverflow.empty() && (mCurrentTick & levelMask(sLevels)) == 0)
+                    replace(mOverflow);
+                for (std::size_t level = sLevels; level-- > 0;)
+                {
+                    if ((mCurrentTick & levelMask(level)) != 0)
+                        continue;
+                    const std::size_t slot = digit(mCurrentTick, level);
+                    if ((mOccupied[level] & (std::uint64_t(1) << slot)) == 0)
+                        continue;
+                    mOccupied[level] &= ~(std::uint64_t(1) << slot);
+                    replace(mSlots[level * sSlots + slot]);
+                }
+            }
+        }
+
+        bool hasDue(double time) const { return !mCurrent.empty() && mCurrent.front().mTime <= time; }
+
+        // Should be called only if `hasDue` returns true.
+        T popDue()
+        {
+            std::pop_heap(mCurrent.begin(), mCurrent.end(), isLater);
+            T value = std::move(mCurrent.back().mValue);
+            mCurrent.pop_back();
+            --mSize;
+            return value;
+        }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        void clear()
+        {
+            mCurrent.clear();
+            mSlots.clear();
+            mOccupied.fill(0);
+            mOverflow.clear();
+            mSize = 0;
+        }
+
+        // Calls `f(time, value)` for every timer in unspecified order.
+        template <class F>
+        void forEach(F&& f) const
+        {
+            auto visit = [&](const std::vector<Entry>& entries) {
+                for (const Entry& entry : entries)
+                    f(entry.mTime, entry.mValue);
+            };
+            visit(mCurrent);
+            for (const std::vector<Entry>& slot : mSlots)
+                visit(slot);
+            visit(mOverflow);
+        }
+
+    private:
+        static constexpr std::size_t sBits = 6;
+        static constexpr std::size_t sSlots = 1 << sBits;
+        static constexpr std::size_t sLevels = 5;
+        static constexpr std::int64_t sMaxTick = std::int64_t(1) << 62;
+
+        struct Entry
+        {
+            double mTime;
+            std::int64_t mTick;
+            std::uint64_t mSequence;
+            T mValue;
+        };
+
+        static bool isLater(const Entry& l, const Entry& r)
+        {
+            if (l.mTime != r.mTime)
+                return l.mTime > r.mTime;
+            return l.mSequence > r.mSequence;
+        }
+
+        static std::int64_t levelMask(std::size_t level) { return (std::int64_t(1) << (level * sBits)) - 1; }
+
+        static std::size_t digit(std::int64_t tick, std::size_t level)
+        {
+            return static_cast<std::size_t>(tick >> (level * sBits)) & (sSlots - 1);
+        }
+
+        std::int64_t toTick(double time) const
+        {
+            const double tick = std::floor(time * mTicksPerUnit);
+            if (!(tick < static_cast<double>(sMaxTick)))
+                return sMaxTick;
+            return static_cast<std::int64_t>(std::max(tick, -static_cast<double>(sMaxTick)));
+        }
+
+        void place(Entry&& entry)
+        {
+            if (entry.mTick <= mCurrentTick)
+            {
+                mCurrent.push_back(std::move(entry));
+                std::push_heap(mCurrent.begin(), mCurrent.end(), isLater);
+                return;
+            }
+            const auto diff = static_cast<std::uint64_t>(entry.mTick ^ mCurrentTick);
+            const std::size_t level = (std::bit_width(diff) - 1) / sBits;
+            if (level >= sLevels)
+            {
+                mOverflow.push_back(std::move(entry));
+                return;
+            }
+            const std::size_t slot = digit(entry.mTick, level);
+            // Allocated on demand, many script containers never use timers.
+            if (mSlots.empty())
+                mSlots.resize(sLevels * sSlots);
+            mSlots[level * sSlots + slot].push_back(std::move(entry));
+            mOccupied[level] |= std::uint64_t(1) << slot;
+        }
+
+        void replace(std::vector<Entry>& entries)
+        {
+            std::vector<Entry> moved = std::move(entries);
+            entries.clear();
+            for (Entry& entry : moved)
+                place(std::move(entry));
+        }
+
+        // Returns the first tick in (mCurrentTick, target] when a slot has to be processed, or `target` if none.
+        std::int64_t findNextTick(std::int64_t target) const
+        {
+            std::int64_t next = target;
+            for (std::size_t level = 0; level < sLevels; ++level)
+            {
+                const std::size_t current = digit(mCurrentTick, level);
+                if (current == sSlots - 1)
+                    continue;
+                const std::uint64_t occupied = mOccupied[level] & (~std::uint64_t(0) << (current + 1));
+                if (occupied == 0)
+                    continue;
+                const std::int64_t base = mCurrentTick & ~levelMask(level + 1);
+                const auto slot = static_cast<std::int64_t>(std::countr_zero(occupied));
+                next = std::min(next, base | (slot << (level * sBits)));
+            }
+            if (!mOverflow.empty())
+                next = std::min(next, (mCurrentTick & ~levelMask(sLevels)) + levelMask(sLevels) + 1);
+            return next;
+        }
+
+        double mTicksPerUnit;
+        std::int64_t mCurrentTick = 0;
+        std::uint64_t mNextSequence = 0;
+        std::size_t mSize = 0;
+        std::vector<Entry> mCurrent;
+        std::vector<std::vector<Entry>> mSlots;
+        std::array<std::uint64_t, sLevels> mOccupied{};
+        std::vector<Entry> mOverflow;
+    };
+}
+
+#endif // COMPONENTS_LUA_TIMERWHEEL_H
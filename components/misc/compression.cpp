@@ -2,19 +2,34 @@
 
 #include <lz4.h>
 
+#include <components/misc/endianness.hpp>
+
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <limits>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace Misc
 {
-    std::vector<std::byte> compress(const std::vector<std::byte>& data)
+    namespace
+    {
+        // Each byte of LZ4 input extends a match by at most 255 bytes
+        constexpr std::uint64_t maxExpansion = 255;
+    }
+
+    std::size_t getMaxCompressedSize(std::size_t size)
+    {
+        return static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(size))) + sizeof(std::uint64_t);
+    }
+
+    std::vector<std::byte> compress(std::span<const std::byte> data)
     {
-        const std::size_t originalSize = data.size();
-        std::vector<std::byte> result(
-            static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(originalSize)) + sizeof(originalSize)));
+        const std::uint64_t originalSize = toLittleEndian(static_cast<std::uint64_t>(data.size()));
+        std::vector<std::byte> result(getMaxCompressedSize(data.size()));
         const int size = LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
             reinterpret_cast<char*>(result.data()) + sizeof(originalSize), static_cast<int>(data.size()),
             static_cast<int>(result.size() - sizeof(originalSize)));
@@ -25,17 +40,23 @@ namespace Misc
         return result;
     }
 
-    std::vector<std::byte> decompress(const std::vector<std::byte>& data)
+    std::vector<std::byte> decompress(std::span<const std::byte> data, std::size_t maxSize)
     {
-        std::size_t originalSize;
+        std::uint64_t originalSize;
+        if (data.size() < sizeof(originalSize))
+            throw std::runtime_error("Compressed data is too short");
         std::memcpy(&originalSize, data.data(), sizeof(originalSize));
-        std::vector<std::byte> result(originalSize);
+        originalSize = fromLittleEndian(originalSize);
+        const std::uint64_t compressedSize = data.size() - sizeof(originalSize);
+        if (originalSize > maxSize || originalSize > (compressedSize + 1) * maxExpansion
+            || originalSize > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+            throw std::runtime_error("Invalid size of decompressed data: " + std::to_string(originalSize));
+        std::vector<std::byte> result(static_cast<std::size_t>(originalSize));
         const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(data.data()) + sizeof(originalSize),
-            reinterpret_cast<char*>(result.data()), static_cast<int>(data.size() - sizeof(originalSize)),
-            static_cast<int>(result.size()));
+            reinterpret_cast<char*>(result.data()), static_cast<int>(compressedSize), static_cast<int>(result.size()));
         if (size < 0)
             throw std::runtime_error("Failed to decompress");
-        if (originalSize != static_cast<std::size_t>(size))
+        if (originalSize != static_cast<std::uint64_t>(size))
             throw std::runtime_error("Size of decompressed data (" + std::to_string(size) + ") doesn't match stored ("
                 + std::to_string(originalSize) + ")");
         return result;
@@ -2,13 +2,22 @@
 #define OPENMW_COMPONENTS_MISC_COMPRESSION_H
 
 #include <cstddef>
+#include <limits>
+#include <span>
 #include <vector>
 
 namespace Misc
 {
-    std::vector<std::byte> compress(const std::vector<std::byte>& data);
+    /// Compresses the data with LZ4, the result is prefixed with the original size as a little-endian 64-bit integer.
+    std::vector<std::byte> compress(std::span<const std::byte> data);
 
-    std::vector<std::byte> decompress(const std::vector<std::byte>& data);
+    /// @return The greatest size of the result of compress for the data of \a size bytes.
+    std::size_t getMaxCompressedSize(std::size_t size);
+
+    /// Decompresses the data written by compress. Throws if the stored original size is greater than \a maxSize or
+    /// than LZ4 could produce from the input, so corrupted data can't cause a huge allocation.
+    std::vector<std::byte> decompress(
+        std::span<const std::byte> data, std::size_t maxSize = std::numeric_limits<std::size_t>::max());
 }
 
 #endif
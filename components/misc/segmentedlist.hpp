@@ -0,0 +1,319 @@
+#ifndef OPENMW_COMPONENTS_MISC_SEGMENTEDLIST_H
+#define OPENMW_COMPONENTS_MISC_SEGMENTEDLIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Misc
+{
+    // Sequence container storing elements in chunks of contiguous memory. Elements are never relocated, so like for
+    // std::list pointers and iterators stay valid until the element is erased, but iterating doesn't have to follow
+    // a pointer per element and inserting doesn't allocate per element. Erased elements leave holes skipped by
+    // iterators, the holes are reused only when they are at the end. A chunk is freed once all of its elements are
+    // erased, so memory and iteration cost stay proportional to the number of elements when they are replaced.
+    template <class T>
+    class SegmentedList
+    {
+        struct Chunk
+        {
+            explicit Chunk(std::size_t capacity)
+                : mCapacity(capacity)
+                , mData(std::allocator<T>().allocate(capacity))
+                , mAlive(std::make_unique<bool[]>(capacity))
+            {
+            }
+
+            ~Chunk() { std::allocator<T>().deallocate(mData, mCapacity); }
+
+            Chunk(const Chunk&) = delete;
+            Chunk& operator=(const Chunk&) = delete;
+
+            const std::size_t mCapacity;
+            T* const mData;
+            const std::unique_ptr<bool[]> mAlive;
+            std::size_t mUsed = 0;
+            std::size_t mAliveCount = 0;
+            Chunk* mPrev = nullptr;
+            Chunk* mNext = nullptr;
+        };
+
+        template <bool isConst>
+        class IteratorBase
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<isConst, const T*, T*>;
+            using reference = std::conditional_t<isConst, const T&, T&>;
+
+            IteratorBase() = default;
+
+            template <bool otherConst, class = std::enable_if_t<isConst && !otherConst>>
+            IteratorBase(const IteratorBase<otherConst>& other)
+                : mList(other.mList)
+                , mChunk(other.mChunk)
+                , mIndex(other.mIndex)
+            {
+            }
+
+            reference operator*() const { return mChunk->mData[mIndex]; }
+
+            pointer operator->() const { return mChunk->mData + mIndex; }
+
+            IteratorBase& operator++()
+            {
+                ++mIndex;
+                skipErased();
+                return *this;
+            }
+
+            IteratorBase operator++(int)
+            {
+                IteratorBase result = *this;
+                ++*this;
+                return result;
+            }
+
+            IteratorBase& operator--()
+            {
+                if (mChunk == nullptr)
+                {
+                    mChunk = mList->mLast;
+                    mIndex = mChunk->mUsed;
+                }
+                while (true)
+                {
+                    if (mIndex == 0)
+                    {
+                        mChunk = mChunk->mPrev;
+                        mIndex = mChunk->mUsed;
+                        continue;
+                    }
+                    --mIndex;
+                    if (mChunk->mAlive[mIndex])
+                        return *this;
+                }
+            }
+
+            IteratorBase operator--(int)
+            {
+                IteratorBase result = *this;
+                --*this;
+                return result;
+            }
+
+            // The list is not compared, so an end iterator stays equal to end() after the list is moved.
+            template <bool otherConst>
+            bool operator==(const IteratorBase<otherConst>& other) const
+            {
+                return mChunk == other.mChunk && mIndex == other.mIndex;
+            }
+
+        private:
+            friend class SegmentedList;
+            friend class IteratorBase<!isConst>;
+
+            const SegmentedList* mList = nullptr;
+            Chunk* mChunk = nullptr;
+            std::size_t mIndex = 0;
+
+            IteratorBase(const SegmentedList* list, Chunk* chunk, std::size_t index)
+                : mList(list)
+                , mChunk(chunk)
+                , mIndex(index)
+            {
+                skipErased();
+            }
+
+            void skipErased()
+            {
+                while (mChunk != nullptr)
+                {
+                    if (mIndex >= mChunk->mUsed || mChunk->mAliveCount == 0)
+                    {
+                        mChunk = mChunk->mNext;
+                        mIndex = 0;
+                        continue;
+                    }
+                    if (mChunk->mAlive[mIndex])
+                        return;
+                    ++mIndex;
+                }
+                mIndex = 0;
+            }
+        };
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = IteratorBase<false>;
+        using const_iterator = IteratorBase<true>;
+
+        SegmentedList() = default;
+
+        SegmentedList(const SegmentedList& other)
+        {
+            for (const T& value : other)
+                push_back(value);
+        }
+
+        SegmentedList(SegmentedList&& other) noexcept
+            : mFirst(std::exchange(other.mFirst, nullptr))
+            , mLast(std::exchange(other.mLast, nullptr))
+            , mSize(std::exchange(other.mSize, 0))
+            , mCapacity(std::exchange(other.mCapacity, 0))
+        {
+        }
+
+        ~SegmentedList() { clear(); }
+
+        SegmentedList& operator=(const SegmentedList& other)
+        {
+            if (this == &other)
+                return *this;
+            clear();
+            for (const T& value : other)
+                push_back(value);
+            return *this;
+        }
+
+        SegmentedList& operator=(SegmentedList&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+            clear();
+            mFirst = std::exchange(other.mFirst, nullptr);
+            mLast = std::exchange(other.mLast, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+            mCapacity = std::exchange(other.mCapacity, 0);
+            return *this;
+        }
+
+        iterator begin() { return iterator(this, mFirst, 0); }
+
+        iterator end() { return iterator(this, nullptr, 0); }
+
+        const_iterator begin() const { return const_iterator(this, mFirst, 0); }
+
+        const_iterator end() const { return const_iterator(this, nullptr, 0); }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        // Number of elements the allocated chunks can hold, including the holes left by erased elements.
+        std::size_t capacity() const { return mCapacity; }
+
+        T& front() { return *begin(); }
+
+        const T& front() const { return *begin(); }
+
+        T& back() { return *--end(); }
+
+        const T& back() const { return *--end(); }
+
+        void push_back(const T& value) { emplace_back(value); }
+
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (mLast == nullptr || mLast->mUsed == mLast->mCapacity)
+                addChunk();
+            T* const result = new (mLast->mData + mLast->mUsed) T(std::forward<Args>(args)...);
+            mLast->mAlive[mLast->mUsed] = true;
+            ++mLast->mUsed;
+            ++mLast->mAliveCount;
+            ++mSize;
+            return *result;
+        }
+
+        iterator erase(const_iterator position)
+        {
+            Chunk* const chunk = position.mChunk;
+            const std::size_t index = position.mIndex;
+            chunk->mData[index].~T();
+            chunk->mAlive[index] = false;
+            --chunk->mAliveCount;
+            --mSize;
+            if (chunk->mAliveCount == 0)
+            {
+                Chunk* const next = chunk->mNext;
+                removeChunk(chunk);
+                return iterator(this, next, 0);
+            }
+            if (chunk == mLast)
+                while (mLast->mUsed > 0 && !mLast->mAlive[mLast->mUsed - 1])
+                    --mLast->mUsed;
+            return iterator(this, chunk, index + 1);
+        }
+
+        void clear()
+        {
+            while (mFirst != nullptr)
+            {
+                Chunk* const chunk = std::exchange(mFirst, mFirst->mNext);
+                for (std::size_t i = 0; i < chunk->mUsed; ++i)
+                    if (chunk->mAlive[i])
+                        chunk->mData[i].~T();
+                delete chunk;
+            }
+            mLast = nullptr;
+            mSize = 0;
+            mCapacity = 0;
+        }
+
+    private:
+        static constexpr std::size_t sMinChunkSize = 4;
+        static constexpr std::size_t sMaxChunkSize = std::max<std::size_t>(sMinChunkSize, 16384 / sizeof(T));
+
+        Chunk* mFirst = nullptr;
+        Chunk* mLast = nullptr;
+        std::size_t mSize = 0;
+        std::size_t mCapacity = 0;
+
+        void addChunk()
+        {
+            // Chunks grow geometrically with the number of elements, so small lists don't waste memory, big ones need
+            // few allocations and replacing elements of a small list doesn't allocate ever bigger chunks.
+            const std::size_t capacity = std::clamp(mSize, sMinChunkSize, sMaxChunkSize);
+            Chunk* const chunk = new Chunk(capacity);
+            chunk->mPrev = mLast;
+            if (mLast != nullptr)
+                mLast->mNext = chunk;
+            else
+                mFirst = chunk;
+            mLast = chunk;
+            mCapacity += capacity;
+        }
+
+        // The chunk should have no alive elements.
+        void removeChunk(Chunk* chunk)
+        {
+            if (chunk->mPrev != nullptr)
+                chunk->mPrev->mNext = chunk->mNext;
+            else
+                mFirst = chunk->mNext;
+            if (chunk->mNext != nullptr)
+                chunk->mNext->mPrev = chunk->mPrev;
+            else
+                mLast = chunk->mPrev;
+            mCapacity -= chunk->mCapacity;
+            delete chunk;
+        }
+    };
+}
+
+#endif
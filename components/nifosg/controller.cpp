@@ -88,6 +88,8 @@ namespace NifOsg
         , mTranslations(copy.mTranslations)
         , mScales(copy.mScales)
         , mAxisOrder(copy.mAxisOrder)
+        , mBaked(copy.mBaked)
+        , mBakedTrack(copy.mBakedTrack)
     {
     }
 
@@ -199,29 +201,41 @@ namespace NifOsg
         traverse(node, nv);
     }
 
-    KeyframeController::KfTransform KeyframeController::getCurrentTransformation(osg::NodeVisitor* nv)
+    KeyframeController::KfTransform KeyframeController::getTransformation(float time) const
     {
         KfTransform out;
 
-        if (hasInput())
-        {
-            float time = getInputValue(nv);
-
-            if (!mRotations.empty())
-                out.mRotation = mRotations.interpKey(time);
-            else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
-                out.mRotation = getXYZRotation(time);
+        if (!mRotations.empty())
+            out.mRotation = mRotations.interpKey(time);
+        else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
+            out.mRotation = getXYZRotation(time);
 
-            if (!mTranslations.empty())
-                out.mTranslation = mTranslations.interpKey(time);
+        if (!mTranslations.empty())
+            out.mTranslation = mTranslations.interpKey(time);
 
-            if (!mScales.empty())
-                out.mScale = mScales.interpKey(time);
-        }
+        if (!mScales.empty())
+            out.mScale = mScales.interpKey(time);
 
         return out;
     }
 
+    KeyframeController::KfTransform KeyframeController::getCurrentTransformation(osg::NodeVisitor* nv)
+    {
+        if (!hasInput())
+            return KfTransform();
+
+        const float time = getInputValue(nv);
+        if (mBaked != nullptr && mBaked->contains(time))
+            return mBaked->sample(mBakedTrack, time);
+        return getTransformation(time);
+    }
+
+    void KeyframeController::setBakedTrack(osg::ref_ptr<const SceneUtil::BakedKeyframes> baked, std::size_t track)
+    {
+        mBaked = std::move(baked);
+        mBakedTrack = track;
+    }
+
     GeomMorpherController::GeomMorpherController() {}
 
     GeomMorpherController::GeomMorpherController(const GeomMorpherController& copy, const osg::CopyOp& copyop)
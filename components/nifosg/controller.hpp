@@ -10,6 +10,7 @@
 #include <components/nif/controller.hpp>
 #include <components/nif/data.hpp>
 #include <components/nif/nifkey.hpp>
+#include <components/sceneutil/bakedkeyframes.hpp>
 #include <components/sceneutil/keyframe.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
@@ -246,8 +247,14 @@ namespace NifOsg
         osg::Vec3f getTranslation(float time) const override;
         osg::Callback* getAsCallback() override { return this; }
 
+        KfTransform getTransformation(float time) const override;
+
         KfTransform getCurrentTransformation(osg::NodeVisitor* nv) override;
 
+        /// Sample the transformation from the track of baked keyframes instead of the keys where the baked ones cover
+        /// the time. getTranslation still uses the keys, so the accumulated movement stays exact.
+        void setBakedTrack(osg::ref_ptr<const SceneUtil::BakedKeyframes> baked, std::size_t track);
+
         void operator()(NifOsg::MatrixTransform*, osg::NodeVisitor*);
 
     private:
@@ -262,6 +269,9 @@ namespace NifOsg
 
         Nif::NiKeyframeData::AxisOrder mAxisOrder{ Nif::NiKeyframeData::AxisOrder::Order_XYZ };
 
+        osg::ref_ptr<const SceneUtil::BakedKeyframes> mBaked;
+        std::size_t mBakedTrack{ 0 };
+
         osg::Quat getXYZRotation(float time) const;
     };
 #ifdef _MSC_VER
@@ -50,10 +50,12 @@
 #include <components/nif/particle.hpp>
 #include <components/nif/property.hpp>
 #include <components/nif/texture.hpp>
+#include <components/sceneutil/bakedkeyframes.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/extradata.hpp>
 #include <components/sceneutil/fog.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
+#include <components/sceneutil/occlusionbuffer.hpp>
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/texmat.hpp>
@@ -326,6 +328,8 @@ namespace NifOsg
         bool mHasHerbalismLabel = false;
         bool mHasStencilProperty = false;
 
+        std::vector<osg::ref_ptr<SceneUtil::Occluder>> mOccluders;
+
         const Nif::NiSortAdjustNode* mPushedSorter = nullptr;
         const Nif::NiSortAdjustNode* mLastAppliedNoInheritSorter = nullptr;
 
@@ -335,7 +339,7 @@ namespace NifOsg
         // This is used to queue look-at controllers whose target nodes may not have been created yet.
         mutable std::vector<std::pair<unsigned int, osg::ref_ptr<LookAtController>>> mLookAtQueue;
 
-        void loadKf(Nif::FileView nif, SceneUtil::KeyframeHolder& target) const
+        void loadKf(Nif::FileView nif, SceneUtil::KeyframeHolder& target, float bakingRate) const
         {
             const Nif::NiSequenceStreamHelper* seq = nullptr;
             const size_t numRoots = nif.numRoots();
@@ -374,6 +378,7 @@ namespace NifOsg
             auto textKeyExtraData = static_cast<const Nif::NiTextKeyExtraData*>(extraList[0].getPtr());
             extractTextKeys(textKeyExtraData, target.mTextKeys);
 
+            std::vector<NifOsg::KeyframeController*> controllers;
             Nif::NiTimeControllerPtr ctrl = seq->mController;
             for (size_t i = 1; i < extraList.size() && !ctrl.empty(); i++, (ctrl = ctrl->mNext))
             {
@@ -405,13 +410,25 @@ namespace NifOsg
                     continue;
                 }
 
-                osg::ref_ptr<SceneUtil::KeyframeController> callback = new NifOsg::KeyframeController(key);
+                osg::ref_ptr<NifOsg::KeyframeController> callback = new NifOsg::KeyframeController(key);
                 setupController(key, callback, /*animflags*/ 0);
 
-                if (!target.mKeyframeControllers.emplace(strdata->mData, callback).second)
+                if (target.mKeyframeControllers.emplace(strdata->mData, callback).second)
+                    controllers.push_back(callback);
+                else
                     Log(Debug::Verbose) << "Controller " << strdata->mData << " present more than once in "
                                         << nif.getFilename() << ", ignoring later version";
             }
+
+            if (bakingRate > 0 && !controllers.empty() && !target.mTextKeys.empty())
+            {
+                const std::vector<const SceneUtil::KeyframeController*> tracks(controllers.begin(), controllers.end());
+                osg::ref_ptr<const SceneUtil::BakedKeyframes> baked = new SceneUtil::BakedKeyframes(
+                    tracks, target.mTextKeys.begin()->first, target.mTextKeys.rbegin()->first, bakingRate);
+                for (std::size_t i = 0; i < controllers.size(); ++i)
+                    controllers[i]->setBakedTrack(baked, i);
+                target.mBakedMemorySize = baked->getMemorySize();
+            }
         }
 
         struct HandleNodeArgs
@@ -421,6 +438,7 @@ namespace NifOsg
             std::vector<unsigned int> mBoundTextures = {};
             int mAnimFlags = 0;
             bool mSkipMeshes = false;
+            bool mInCollisionNode = false;
             bool mHasMarkers = false;
             bool mHasAnimatedParents = false;
             osg::Node* mRootNode = nullptr;
@@ -457,6 +475,8 @@ namespace NifOsg
                 created->getOrCreateUserDataContainer()->addDescription(Constants::NightDayLabel);
             if (mHasHerbalismLabel)
                 created->getOrCreateUserDataContainer()->addDescription(Constants::HerbalismLabel);
+            for (const osg::ref_ptr<SceneUtil::Occluder>& occluder : mOccluders)
+                created->getOrCreateUserDataContainer()->addUserObject(occluder);
 
             // Attach particle emitters to their nodes which should all be loaded by now.
             handleQueuedParticleEmitters(created, nif);
@@ -809,6 +829,7 @@ namespace NifOsg
             if (nifNode == args.mCollisionNode)
             {
                 args.mSkipMeshes = true;
+                args.mInCollisionNode = true;
                 node->setNodeMask(Loader::getHiddenNodeMask());
             }
 
@@ -849,7 +870,10 @@ namespace NifOsg
             const bool isBSGeometry = isTypeBSGeometry(nifNode->mRecordType);
             const bool isGeometry = isNiGeometry || isBSGeometry;
 
-            if (isGeometry && !args.mSkipMeshes)
+            // Occluders are never rendered, so they may be hidden to keep other engines from rendering them too
+            if (isNiGeometry && !args.mInCollisionNode && Misc::StringUtils::ciStartsWith(nifNode->mName, "occluder"))
+                handleOccluder(nifNode, parent);
+            else if (isGeometry && !args.mSkipMeshes)
             {
                 bool skip = false;
                 if (args.mNifVersion <= Nif::NIFFile::NIFVersion::VER_MW)
@@ -1671,6 +1695,37 @@ namespace NifOsg
             applyDrawableProperties(parentNode, drawableProps, composite, !niGeometryData->mColors.empty(), animflags);
         }
 
+        // The triangles of the occluder are transformed into the space of the parent of the root nodes, where they
+        // stay valid no matter how the optimizer changes the transformations below.
+        void handleOccluder(const Nif::NiAVObject* nifNode, const Nif::Parent* parent)
+        {
+            if (nifNode->mRecordType != Nif::RC_NiTriShape)
+            {
+                Log(Debug::Warning) << "Occluder \"" << nifNode->mName << "\" in " << mFilename
+                                    << " is not a NiTriShape, ignoring it";
+                return;
+            }
+
+            const Nif::NiGeometry* niGeometry = static_cast<const Nif::NiGeometry*>(nifNode);
+            if (niGeometry->mData.empty() || !niGeometry->mSkin.empty())
+                return;
+
+            const auto data = static_cast<const Nif::NiTriShapeData*>(niGeometry->mData.getPtr());
+            if (data->mVertices.empty() || data->mTriangles.empty())
+                return;
+
+            osg::Matrixf transform = nifNode->mTransform.toMatrix();
+            for (; parent != nullptr; parent = parent->mParent)
+                transform *= parent->mNiNode.mTransform.toMatrix();
+
+            osg::ref_ptr<SceneUtil::Occluder> occluder = new SceneUtil::Occluder;
+            occluder->mVertices.reserve(data->mVertices.size());
+            for (const osg::Vec3f& vertex : data->mVertices)
+                occluder->mVertices.push_back(vertex * transform);
+            occluder->mIndices = data->mTriangles;
+            mOccluders.push_back(std::move(occluder));
+        }
+
         void handleNiGeometry(const Nif::NiAVObject* nifNode, const Nif::Parent* parent, osg::Group* parentNode,
             SceneUtil::CompositeStateSetUpdater* composite, const std::vector<unsigned int>& boundTextures,
             int animflags)
@@ -3003,10 +3058,10 @@ namespace NifOsg
         return impl.load(file);
     }
 
-    void Loader::loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target)
+    void Loader::loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target, float bakingRate)
     {
         LoaderImpl impl(kf.getFilename(), kf.getVersion(), kf.getUserVersion(), kf.getBethVersion());
-        impl.loadKf(kf, target);
+        impl.loadKf(kf, target, bakingRate);
     }
 
 }
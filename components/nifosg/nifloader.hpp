@@ -35,7 +35,8 @@ namespace NifOsg
             Nif::FileView file, Resource::ImageManager* imageManager, Resource::BgsmFileManager* materialManager);
 
         /// Load keyframe controllers from the given kf file.
-        static void loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target);
+        /// @param bakingRate Samples per second of the BakedKeyframes the controllers sample, 0 to use the keys.
+        static void loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target, float bakingRate = 0);
 
         /// Set whether or not nodes marked as "MRK" should be shown.
         /// These should be hidden ingame, but visible in the editor.
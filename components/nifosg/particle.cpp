@@ -12,6 +12,7 @@
 #include <components/nif/data.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/updatestage.hpp>
 
 namespace
 {
@@ -95,6 +96,22 @@ namespace
         std::optional<osg::Matrix> mLastMatrix;
         osg::Transform* mLastAppliedTransform = nullptr;
     };
+
+    // Replaces osgParticle::Operator::operateParticles: the operator's own operate() is called directly, so it can be
+    // inlined into the loop instead of being dispatched virtually for every particle.
+    template <class T>
+    void operateAliveParticles(T& op, osgParticle::ParticleSystem& ps, double dt)
+    {
+        if (!op.isEnabled())
+            return;
+        const int count = ps.numParticles();
+        for (int i = 0; i < count; ++i)
+        {
+            osgParticle::Particle* const particle = ps.getParticle(i);
+            if (particle->isAlive())
+                op.T::operate(particle, dt);
+        }
+    }
 }
 
 namespace NifOsg
@@ -134,6 +151,36 @@ namespace NifOsg
         return nullptr;
     }
 
+    void ParticleSystem::update(double dt, osg::NodeVisitor& nv)
+    {
+        // Shader uniforms and sorting need the scene graph or the visitor, such systems are updated right away.
+        if (!_useShaders && getSortMode() == NO_SORT)
+        {
+            if (SceneUtil::UpdateStage* stage = SceneUtil::UpdateStage::get(nv))
+            {
+                stage->add(*this, dt, &updateParticles);
+                return;
+            }
+        }
+        osgParticle::ParticleSystem::update(dt, nv);
+    }
+
+    void ParticleSystem::updateParticles(osgParticle::ParticleSystem& system, double dt)
+    {
+        ParticleSystem& self = static_cast<ParticleSystem&>(system);
+        self._reset_bounds_flag = true;
+        for (int i = 0, n = self.numParticles(); i < n; ++i)
+        {
+            osgParticle::Particle& particle = self._particles[i];
+            if (!particle.isAlive())
+                continue;
+            if (particle.update(dt, false))
+                self.update_bounds(particle.getPosition(), particle.getCurrentSize());
+            else
+                self.reuseParticle(i);
+        }
+    }
+
     void ParticleSystem::drawImplementation(osg::RenderInfo& renderInfo) const
     {
         osg::State& state = *renderInfo.getState();
@@ -253,6 +300,11 @@ namespace NifOsg
         particle->setSizeRange(osgParticle::rangef(size, size));
     }
 
+    void GrowFadeAffector::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        operateAliveParticles(*this, *ps, dt);
+    }
+
     ParticleColorAffector::ParticleColorAffector(const Nif::NiColorData* clrdata)
         : mData(clrdata->mKeyMap, osg::Vec4f(1, 1, 1, 1))
     {
@@ -278,6 +330,11 @@ namespace NifOsg
         particle->setAlphaRange(osgParticle::rangef(alpha, alpha));
     }
 
+    void ParticleColorAffector::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        operateAliveParticles(*this, *ps, dt);
+    }
+
     GravityAffector::GravityAffector(const Nif::NiGravity* gravity)
         : mForce(gravity->mForce)
         , mType(gravity->mType)
@@ -346,6 +403,27 @@ namespace NifOsg
         }
     }
 
+    void GravityAffector::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        if (mType != Nif::ForceType::Wind || mDecay != 0.f)
+        {
+            operateAliveParticles(*this, *ps, dt);
+            return;
+        }
+        if (!isEnabled())
+            return;
+        // Wind without decay accelerates every particle the same way.
+        const float magic = 1.6f;
+        const osg::Vec3f velocity = mCachedWorldDirection * mForce * static_cast<float>(dt) * magic;
+        const int count = ps->numParticles();
+        for (int i = 0; i < count; ++i)
+        {
+            osgParticle::Particle* const particle = ps->getParticle(i);
+            if (particle->isAlive())
+                particle->addVelocity(velocity);
+        }
+    }
+
     ParticleBomb::ParticleBomb(const Nif::NiParticleBomb* bomb)
         : mRange(bomb->mRange)
         , mStrength(bomb->mStrength)
@@ -424,6 +502,11 @@ namespace NifOsg
         particle->addVelocity(explosionDir * mStrength * decay * static_cast<float>(dt));
     }
 
+    void ParticleBomb::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        operateAliveParticles(*this, *ps, dt);
+    }
+
     Emitter::Emitter()
         : osgParticle::Emitter()
         , mFlags(0)
@@ -674,6 +757,11 @@ namespace NifOsg
         particle->setVelocity(reflectedVelocity);
     }
 
+    void PlanarCollider::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        operateAliveParticles(*this, *ps, dt);
+    }
+
     SphericalCollider::SphericalCollider(const Nif::NiSphericalCollider* collider)
         : mBounceFactor(collider->mBounceFactor)
         , mSphere(collider->mCenter, collider->mRadius)
@@ -742,4 +830,9 @@ namespace NifOsg
         }
     }
 
+    void SphericalCollider::operateParticles(osgParticle::ParticleSystem* ps, double dt)
+    {
+        operateAliveParticles(*this, *ps, dt);
+    }
+
 }
@@ -24,7 +24,8 @@ namespace Nif
 namespace NifOsg
 {
 
-    // Subclass ParticleSystem to support a limit on the number of active particles.
+    // Subclass ParticleSystem to support a limit on the number of active particles and to update the particles on
+    // SceneUtil::UpdateStage worker threads.
     class ParticleSystem : public osgParticle::ParticleSystem
     {
     public:
@@ -37,9 +38,14 @@ namespace NifOsg
 
         void setQuota(int quota);
 
+        void update(double dt, osg::NodeVisitor& nv) override;
+
         void drawImplementation(osg::RenderInfo& renderInfo) const override;
 
     private:
+        /// osgParticle::ParticleSystem::update without the parts touching the scene graph, run by the update stage.
+        static void updateParticles(osgParticle::ParticleSystem& system, double dt);
+
         int mQuota;
         osg::ref_ptr<osg::Vec3Array> mNormalArray;
     };
@@ -109,6 +115,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) override;
 
     private:
         float mBounceFactor{ 0.f };
@@ -130,6 +137,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) override;
 
     private:
         float mBounceFactor;
@@ -150,6 +158,7 @@ namespace NifOsg
 
         void beginOperate(osgParticle::Program* program) override;
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) override;
 
     private:
         float mGrowTime;
@@ -170,6 +179,7 @@ namespace NifOsg
         META_Object(NifOsg, ParticleColorAffector)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) override;
 
     private:
         Vec4Interpolator mData;
@@ -187,6 +197,7 @@ namespace NifOsg
         META_Object(NifOsg, GravityAffector)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) override;
         void beginOperate(osgParticle::Program*) override;
 
     private:
@@ -211,6 +222,7 @@ namespace NifOsg
         META_Object(NifOsg, ParticleBomb)
 
         void operate(osgParticle::Particle* particle, double dt) override;
+        void operateParticles(osgParticle::ParticleSystem* ps, double dt) override;
         void beginOperate(osgParticle::Program*) override;
 
     private:
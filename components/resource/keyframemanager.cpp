@@ -221,7 +221,7 @@ namespace Resource
             auto file = std::make_shared<Nif::NIFFile>(name);
             Nif::Reader reader(*file, mEncoder);
             reader.parse(mVFS->get(name));
-            NifOsg::Loader::loadKf(*file, *loaded.get());
+            NifOsg::Loader::loadKf(*file, *loaded.get(), mBakingRate);
         }
         else
         {
@@ -241,6 +241,13 @@ namespace Resource
     void KeyframeManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Keyframe", frameNumber, mCache->getStats(), *stats);
+
+        std::size_t bakedMemorySize = 0;
+        mCache->call([&](const auto& /*key*/, const osg::Object* object) {
+            if (const auto* keyframes = dynamic_cast<const SceneUtil::KeyframeHolder*>(object))
+                bakedMemorySize += keyframes->mBakedMemorySize;
+        });
+        stats->setAttribute(frameNumber, "Keyframe Baked Memory", static_cast<double>(bakedMemorySize));
     }
 
 }
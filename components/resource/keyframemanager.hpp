@@ -58,11 +58,16 @@ namespace Resource
         /// @note Throws an exception if the resource is not found.
         osg::ref_ptr<const SceneUtil::KeyframeHolder> get(VFS::Path::NormalizedView name);
 
+        /// Set the rate in samples per second at which KF animations are resampled when loaded, 0 disables baking.
+        /// @see SceneUtil::BakedKeyframes
+        void setBakingRate(float rate) { mBakingRate = rate; }
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
     private:
         SceneManager* mSceneManager;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
+        float mBakingRate = 0;
     };
 
 }
@@ -105,6 +105,12 @@ namespace Resource
                 "CellPreloader Expired",
             };
 
+            constexpr std::string_view lua[] = {
+                "Lua DeferredUpdates",
+                "Lua DeferredTimerQueues",
+                "Lua ThrottledScripts",
+            };
+
             constexpr std::string_view navMesh[] = {
                 "NavMesh Jobs",
                 "NavMesh Removing",
@@ -128,6 +134,38 @@ namespace Resource
                 "NavMesh Recast Water",
             };
 
+            constexpr std::string_view sound[] = {
+                "Sound CompressedCache Count",
+                "Sound CompressedCache Size",
+                "Sound CompressedCache Hit",
+                "Sound CompressedCache Miss",
+                "Sound DecodeTime",
+                "Sound Voices Real",
+                "Sound Voices Virtual",
+            };
+
+            constexpr std::string_view rendering[] = {
+                "Deformation Drawables",
+                "Particle Systems",
+                "LightBins Lights Per Bin",
+                "LightBins Max Lights Per Bin",
+                "LightBins Time",
+                "Object Chunk Builds",
+                "Object Chunk Baked Loads",
+                "Object Chunk Baked Stores",
+                "Object Chunk Gather Time",
+                "Object Chunk Instance Time",
+                "Object Chunk Optimize Time",
+                "Terrain Occluder Triangles",
+                "Terrain Occluded Chunks",
+                "Terrain Occluder Rasterize Time",
+                "Animation LOD Full",
+                "Animation LOD Reduced Rate",
+                "Animation LOD Reduced Bones",
+                "Animation LOD Frozen",
+                "Keyframe Baked Memory",
+            };
+
             std::vector<std::string> statNames;
 
             for (std::string_view name : firstPage)
@@ -143,12 +181,29 @@ namespace Resource
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : lua)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : sound)
+                statNames.emplace_back(name);
+
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : rendering)
+                statNames.emplace_back(name);
+
             return statNames;
         }
 
@@ -0,0 +1,116 @@
+#include "bakedkeyframes.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SceneUtil
+{
+    BakedKeyframes::BakedKeyframes(
+        const std::vector<const KeyframeController*>& tracks, float startTime, float stopTime, float rate)
+        : mStartTime(startTime)
+        , mStopTime(std::max(startTime, stopTime))
+        , mRate(rate)
+        , mSampleCount(static_cast<std::size_t>(std::ceil((mStopTime - mStartTime) * rate)) + 1)
+        , mTracks(tracks.size())
+    {
+        // The channels of a controller depend on which keys it has, not on the time.
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < tracks.size(); ++i)
+        {
+            const KeyframeController::KfTransform transform = tracks[i]->getTransformation(mStartTime);
+            Track& track = mTracks[i];
+            if (transform.mTranslation)
+            {
+                track.mChannels |= Channel_Translation;
+                track.mStride += 3;
+            }
+            if (transform.mRotation)
+            {
+                track.mChannels |= Channel_Rotation;
+                track.mStride += 4;
+            }
+            if (transform.mScale)
+            {
+                track.mChannels |= Channel_Scale;
+                track.mStride += 1;
+            }
+            track.mOffset = size;
+            size += track.mStride * mSampleCount;
+        }
+        mValues.resize(size);
+
+        for (std::size_t i = 0; i < tracks.size(); ++i)
+        {
+            const Track& track = mTracks[i];
+            if (track.mStride == 0)
+                continue;
+            float* previousRotation = nullptr;
+            for (std::size_t sample = 0; sample < mSampleCount; ++sample)
+            {
+                // Samples after the stop time only exist to complete the last interval, the controllers extrapolate
+                // them.
+                const float time = mStartTime + sample / mRate;
+                const auto [translation, rotation, scale] = tracks[i]->getTransformation(time);
+                float* values = mValues.data() + track.mOffset + sample * track.mStride;
+                if (track.mChannels & Channel_Translation)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                        values[j] = translation ? (*translation)[j] : 0.f;
+                    values += 3;
+                }
+                if (track.mChannels & Channel_Rotation)
+                {
+                    osg::Quat value = rotation ? *rotation : osg::Quat();
+                    // Keep consecutive samples in the same hemisphere, so the linear interpolation takes the short way.
+                    if (previousRotation != nullptr)
+                    {
+                        float dot = 0;
+                        for (std::size_t j = 0; j < 4; ++j)
+                            dot += value[j] * previousRotation[j];
+                        if (dot < 0)
+                            value = -value;
+                    }
+                    for (std::size_t j = 0; j < 4; ++j)
+                        values[j] = static_cast<float>(value[j]);
+                    previousRotation = values;
+                    values += 4;
+                }
+                if (track.mChannels & Channel_Scale)
+                    values[0] = scale ? *scale : 1.f;
+            }
+        }
+    }
+
+    KeyframeController::KfTransform BakedKeyframes::sample(std::size_t track, float time) const
+    {
+        const Track& info = mTracks[track];
+        const float position = (std::clamp(time, mStartTime, mStopTime) - mStartTime) * mRate;
+        const std::size_t low = std::min(static_cast<std::size_t>(position), mSampleCount - 1);
+        const std::size_t high = std::min(low + 1, mSampleCount - 1);
+        const float fraction = position - low;
+        const float* lowValues = mValues.data() + info.mOffset + low * info.mStride;
+        const float* highValues = mValues.data() + info.mOffset + high * info.mStride;
+        const auto interpolate = [&](std::size_t index) {
+            return lowValues[index] + (highValues[index] - lowValues[index]) * fraction;
+        };
+
+        KeyframeController::KfTransform result;
+        std::size_t index = 0;
+        if (info.mChannels & Channel_Translation)
+        {
+            result.mTranslation = osg::Vec3f(interpolate(index), interpolate(index + 1), interpolate(index + 2));
+            index += 3;
+        }
+        if (info.mChannels & Channel_Rotation)
+        {
+            osg::Quat rotation(
+                interpolate(index), interpolate(index + 1), interpolate(index + 2), interpolate(index + 3));
+            rotation /= rotation.length();
+            result.mRotation = rotation;
+            index += 4;
+        }
+        if (info.mChannels & Channel_Scale)
+            result.mScale = interpolate(index);
+        return result;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_BAKEDKEYFRAMES_H
+#define OPENMW_COMPONENTS_SCENEUTIL_BAKEDKEYFRAMES_H
+
+#include <osg/Referenced>
+
+#include <components/sceneutil/keyframe.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Keyframe tracks of an animation resampled at a uniform rate.
+    /// @par All tracks share the sample times, so sampling a track needs no key search and interpolates linearly
+    /// between two consecutive samples. Samples of a track are stored next to each other and only hold the channels the
+    /// track has.
+    /// @note Resampling rounds off motion between samples, sharp changes are spread over one sample interval.
+    class BakedKeyframes : public osg::Referenced
+    {
+    public:
+        /// Samples the controllers between startTime and stopTime.
+        /// @param rate Samples per second.
+        BakedKeyframes(
+            const std::vector<const KeyframeController*>& tracks, float startTime, float stopTime, float rate);
+
+        std::size_t getTrackCount() const { return mTracks.size(); }
+
+        /// Size of the samples in bytes.
+        std::size_t getMemorySize() const { return mValues.size() * sizeof(float); }
+
+        bool contains(float time) const { return time >= mStartTime && time <= mStopTime; }
+
+        /// Samples a single track.
+        KeyframeController::KfTransform sample(std::size_t track, float time) const;
+
+    private:
+        enum Channel : unsigned char
+        {
+            Channel_Translation = 1,
+            Channel_Rotation = 1 << 1,
+            Channel_Scale = 1 << 2,
+        };
+
+        struct Track
+        {
+            unsigned char mChannels = 0;
+            // Number of floats in a sample.
+            std::size_t mStride = 0;
+            // Index of the first sample in mValues.
+            std::size_t mOffset = 0;
+        };
+
+        float mStartTime;
+        float mStopTime;
+        float mRate;
+        std::size_t mSampleCount;
+        std::vector<Track> mTracks;
+        // Samples of a track in the order translation, rotation and scale, leaving out the missing channels.
+        std::vector<float> mValues;
+    };
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_SCENEUTIL_KEYFRAME_HPP
 #define OPENMW_COMPONENTS_SCENEUTIL_KEYFRAME_HPP
 
+#include <cstddef>
 #include <map>
 #include <optional>
 
@@ -33,6 +34,9 @@ namespace SceneUtil
 
         virtual osg::Vec3f getTranslation(float time) const { return osg::Vec3f(); }
 
+        /// Transformation at the time of the animation track, independent of the controller's input.
+        virtual KfTransform getTransformation(float time) const { return KfTransform(); }
+
         virtual KfTransform getCurrentTransformation(osg::NodeVisitor* nv) { return KfTransform(); }
 
         /// @note We could drop this function in favour of osg::Object::asCallback from OSG 3.6 on.
@@ -63,6 +67,7 @@ namespace SceneUtil
         KeyframeHolder(const KeyframeHolder& copy, const osg::CopyOp& copyop)
             : mTextKeys(copy.mTextKeys)
             , mKeyframeControllers(copy.mKeyframeControllers)
+            , mBakedMemorySize(copy.mBakedMemorySize)
         {
         }
 
@@ -73,6 +78,9 @@ namespace SceneUtil
         /// Controllers mapped to node name.
         typedef std::map<std::string, osg::ref_ptr<const KeyframeController>> KeyframeControllerMap;
         KeyframeControllerMap mKeyframeControllers;
+
+        /// Size in bytes of the baked keyframes the controllers sample.
+        std::size_t mBakedMemorySize = 0;
     };
 
 }
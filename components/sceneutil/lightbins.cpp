@@ -0,0 +1,127 @@
+#include "lightbins.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        osg::BoundingBox getBox(const osg::BoundingSphere& sphere)
+        {
+            osg::BoundingBox box;
+            box.expandBy(sphere);
+            return box;
+        }
+
+        std::size_t getBinIndex(std::size_t x, std::size_t y, std::size_t z)
+        {
+            return (x * LightBins::sResolution + y) * LightBins::sResolution + z;
+        }
+
+        template <class Function>
+        void forEachBin(const std::array<std::size_t, 3>& begin, const std::array<std::size_t, 3>& end, Function&& f)
+        {
+            for (std::size_t x = begin[0]; x < end[0]; ++x)
+                for (std::size_t y = begin[1]; y < end[1]; ++y)
+                    for (std::size_t z = begin[2]; z < end[2]; ++z)
+                        f(getBinIndex(x, y, z));
+        }
+    }
+
+    void LightBins::build(const std::vector<osg::BoundingSphere>& lights)
+    {
+        mLightCount = lights.size();
+        mNonEmptyBinCount = 0;
+        mMaxBinSize = 0;
+        mOffsets.assign(sBinCount + 1, 0);
+        mIndices.clear();
+        mBox.init();
+
+        for (const osg::BoundingSphere& light : lights)
+            mBox.expandBy(light);
+        if (!mBox.valid())
+            return;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float extent = mBox._max[axis] - mBox._min[axis];
+            mScale[axis] = extent > 0 ? static_cast<float>(sResolution) / extent : 0;
+        }
+
+        // Counting sort: count the lights of every bin, turn the counts into offsets and then fill the bins. Lights
+        // are visited in order, so every bin lists them in ascending order.
+        for (const osg::BoundingSphere& light : lights)
+        {
+            const Range range = getRange(getBox(light));
+            forEachBin(range.mBegin, range.mEnd, [&](std::size_t bin) { ++mOffsets[bin + 1]; });
+        }
+
+        for (std::size_t bin = 0; bin < sBinCount; ++bin)
+        {
+            const std::size_t size = mOffsets[bin + 1];
+            if (size > 0)
+                ++mNonEmptyBinCount;
+            mMaxBinSize = std::max(mMaxBinSize, size);
+            mOffsets[bin + 1] += mOffsets[bin];
+        }
+
+        mIndices.resize(mOffsets.back());
+        mCursors.assign(mOffsets.begin(), mOffsets.end() - 1);
+        for (std::size_t i = 0; i < lights.size(); ++i)
+        {
+            const Range range = getRange(getBox(lights[i]));
+            forEachBin(range.mBegin, range.mEnd, [&](std::size_t bin) { mIndices[mCursors[bin]++] = i; });
+        }
+    }
+
+    void LightBins::getCandidates(const osg::BoundingSphere& bound, std::vector<std::size_t>& candidates) const
+    {
+        candidates.clear();
+        if (!bound.valid() || !mBox.valid())
+            return;
+
+        const osg::BoundingBox box = getBox(bound);
+        if (!box.intersects(mBox))
+            return;
+
+        const Range range = getRange(box);
+        const std::size_t binCount = (range.mEnd[0] - range.mBegin[0]) * (range.mEnd[1] - range.mBegin[1])
+            * (range.mEnd[2] - range.mBegin[2]);
+
+        // Merging the bins of a large bound costs more than testing every light.
+        if (binCount >= mLightCount)
+        {
+            candidates.resize(mLightCount);
+            std::iota(candidates.begin(), candidates.end(), std::size_t{ 0 });
+            return;
+        }
+
+        forEachBin(range.mBegin, range.mEnd, [&](std::size_t bin) {
+            candidates.insert(
+                candidates.end(), mIndices.begin() + mOffsets[bin], mIndices.begin() + mOffsets[bin + 1]);
+        });
+
+        if (binCount > 1)
+        {
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        }
+    }
+
+    LightBins::Range LightBins::getRange(const osg::BoundingBox& box) const
+    {
+        Range result;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const auto getBin = [&](float value) {
+                const float bin = std::floor((value - mBox._min[axis]) * mScale[axis]);
+                return static_cast<std::size_t>(std::clamp(bin, 0.0f, static_cast<float>(sResolution - 1)));
+            };
+            result.mBegin[axis] = getBin(box._min[axis]);
+            result.mEnd[axis] = getBin(box._max[axis]) + 1;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTBINS_H
+#define OPENMW_COMPONENTS_SCENEUTIL_LIGHTBINS_H
+
+#include <osg/BoundingBox>
+#include <osg/BoundingSphere>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Uniform grid over the bounds of a set of lights, every bin lists the lights overlapping it.
+    /// @par Built once per frame and camera by the LightManager, so objects only test the lights from the bins their
+    /// bounds overlap instead of every light in view.
+    class LightBins
+    {
+    public:
+        /// Number of bins along each axis.
+        static constexpr std::size_t sResolution = 8;
+
+        /// Bins the lights, a light is identified by its index in the vector.
+        void build(const std::vector<osg::BoundingSphere>& lights);
+
+        /// Sets candidates to the ascending indices of the lights which may intersect the bound.
+        void getCandidates(const osg::BoundingSphere& bound, std::vector<std::size_t>& candidates) const;
+
+        /// Sum of the number of lights in every bin.
+        std::size_t getEntryCount() const { return mIndices.size(); }
+
+        std::size_t getNonEmptyBinCount() const { return mNonEmptyBinCount; }
+
+        std::size_t getMaxBinSize() const { return mMaxBinSize; }
+
+    private:
+        static constexpr std::size_t sBinCount = sResolution * sResolution * sResolution;
+
+        struct Range
+        {
+            std::array<std::size_t, 3> mBegin;
+            std::array<std::size_t, 3> mEnd;
+        };
+
+        osg::BoundingBox mBox;
+        osg::Vec3f mScale;
+        std::size_t mLightCount = 0;
+        std::size_t mNonEmptyBinCount = 0;
+        std::size_t mMaxBinSize = 0;
+        // Lights of a bin are mIndices[mOffsets[bin]] .. mIndices[mOffsets[bin + 1]].
+        std::vector<std::size_t> mOffsets;
+        std::vector<std::size_t> mIndices;
+        std::vector<std::size_t> mCursors;
+
+        Range getRange(const osg::BoundingBox& box) const;
+    };
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cstring>
 
+#include <osg/Stats>
+
 #include <osgUtil/CullVisitor>
 
 #include <components/debug/debuglog.hpp>
@@ -501,6 +503,9 @@ namespace SceneUtil
         if (mPPLightBuffer)
             mPPLightBuffer->clear(frameNum);
 
+        mLastBinningStats = mBinningStats;
+        mBinningStats = BinningStats{};
+
         mLights.clear();
         mLightsInViewSpace.clear();
         mLightListStateSets.clear();
@@ -566,6 +571,12 @@ namespace SceneUtil
 
     const std::vector<LightManager::LightSourceViewBound>& LightManager::getLightsInViewSpace(
         osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum)
+    {
+        return getViewLights(cv, viewMatrix, frameNum).mBounds;
+    }
+
+    const LightManager::ViewLights& LightManager::getViewLights(
+        osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum)
     {
         osg::Camera* camera = cv->getCurrentCamera();
 
@@ -574,7 +585,8 @@ namespace SceneUtil
 
         if (it == mLightsInViewSpace.end())
         {
-            it = mLightsInViewSpace.insert(std::make_pair(camPtr, LightSourceViewBoundCollection())).first;
+            it = mLightsInViewSpace.insert(std::make_pair(camPtr, ViewLights())).first;
+            std::vector<LightSourceViewBound>& bounds = it->second.mBounds;
 
             for (const auto& transform : mLights)
             {
@@ -602,7 +614,7 @@ namespace SceneUtil
                 LightSourceViewBound l;
                 l.mLightSource = transform.mLightSource;
                 l.mViewBound = viewBound;
-                it->second.push_back(l);
+                bounds.push_back(l);
             }
 
             const bool fillPPBuffer = mPPLightBuffer && it->first->getName() == Constants::SceneCamera;
@@ -615,10 +627,10 @@ namespace SceneUtil
                         < right.mViewBound.center().length2() - right.mViewBound.radius2();
                 };
 
-                std::sort(it->second.begin(), it->second.end(), sorter);
+                std::sort(bounds.begin(), bounds.end(), sorter);
 
                 osg::CullingSet& cullingSet = cv->getModelViewCullingStack().front();
-                for (auto& bound : it->second)
+                for (auto& bound : bounds)
                 {
                     const auto* light = bound.mLightSource->getLight(frameNum);
                     const float radius = bound.mLightSource->getRadius() * mPointLightRadiusMultiplier;
@@ -634,11 +646,37 @@ namespace SceneUtil
                         getPPLightsBuffer()->setLight(frameNum, light, radius);
                 }
             }
+
+            if (!mClusteredLighting)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                mBinnedBounds.clear();
+                for (const LightSourceViewBound& bound : bounds)
+                    mBinnedBounds.push_back(bound.mViewBound);
+                LightBins& bins = it->second.mBins;
+                bins.build(mBinnedBounds);
+                mBinningStats.mBinnedLights += bins.getEntryCount();
+                mBinningStats.mNonEmptyBins += bins.getNonEmptyBinCount();
+                mBinningStats.mMaxBinSize = std::max(mBinningStats.mMaxBinSize, bins.getMaxBinSize());
+                mBinningStats.mTime += std::chrono::steady_clock::now() - start;
+            }
         }
 
         return it->second;
     }
 
+    void LightManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        const BinningStats& binning = mLastBinningStats;
+        const double lightsPerBin = binning.mNonEmptyBins == 0
+            ? 0.0
+            : static_cast<double>(binning.mBinnedLights) / static_cast<double>(binning.mNonEmptyBins);
+        stats.setAttribute(frameNumber, "LightBins Lights Per Bin", lightsPerBin);
+        stats.setAttribute(frameNumber, "LightBins Max Lights Per Bin", static_cast<double>(binning.mMaxBinSize));
+        stats.setAttribute(
+            frameNumber, "LightBins Time", std::chrono::duration<double, std::milli>(binning.mTime).count());
+    }
+
     osg::ref_ptr<osg::Uniform> LightManager::generateLightBufferUniform()
     {
         osg::ref_ptr<osg::Uniform> uniform = new osg::Uniform(osg::Uniform::FLOAT_MAT4, "LightBuffer", getMaxLights());
@@ -699,9 +737,6 @@ namespace SceneUtil
         if (!(cv->getTraversalMask() & mLightManager->getLightingMask()))
             return false;
 
-        // Possible optimizations:
-        // - organize lights in a quad tree
-
         // Don't use Camera::getViewMatrix, that one might be relative to another camera!
         const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
 
@@ -725,12 +760,16 @@ namespace SceneUtil
 
             transformBoundingSphere(*cv->getModelViewMatrix(), nodeBound);
 
-            const std::vector<LightManager::LightSourceViewBound>& lights
-                = mLightManager->getLightsInViewSpace(cv, viewMatrix, mLastFrameNumber);
+            const LightManager::ViewLights& lights = mLightManager->getViewLights(cv, viewMatrix, mLastFrameNumber);
+
+            // The bins only narrow down the lights to test, they keep their order so the light lists and their
+            // cached state sets stay the same.
+            lights.mBins.getCandidates(nodeBound, mCandidates);
 
             mLightList.clear();
-            for (const LightManager::LightSourceViewBound& light : lights)
+            for (const std::size_t index : mCandidates)
             {
+                const LightManager::LightSourceViewBound& light = lights.mBounds[index];
                 if (mIgnoredLightSources.contains(light.mLightSource))
                     continue;
 
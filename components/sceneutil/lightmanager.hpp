@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_SCENEUTIL_LIGHTMANAGER_H
 
 #include <array>
+#include <chrono>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -16,8 +17,14 @@
 #include <components/misc/constants.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/sceneutil/clusteredlighting.hpp>
+#include <components/sceneutil/lightbins.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace SceneUtil
 {
     template <class T>
@@ -229,6 +236,13 @@ namespace SceneUtil
             bool mCulled = false;
         };
 
+        /// Lights of a camera in view space, binned only for per object lighting.
+        struct ViewLights
+        {
+            std::vector<LightSourceViewBound> mBounds;
+            LightBins mBins;
+        };
+
         using LightList = std::vector<const LightSourceViewBound*>;
         using SupportedMethods = std::array<bool, 3>;
 
@@ -255,6 +269,8 @@ namespace SceneUtil
         const std::vector<LightSourceViewBound>& getLightsInViewSpace(
             osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum);
 
+        const ViewLights& getViewLights(osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum);
+
         osg::ref_ptr<osg::StateSet> getLightListStateSet(
             const LightList& lightList, size_t frameNum, const osg::RefMatrix* viewMatrix);
 
@@ -289,7 +305,17 @@ namespace SceneUtil
 
         Resource::ResourceSystem* getResourceSystem() { return mResourceSystem; }
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
+        struct BinningStats
+        {
+            std::size_t mBinnedLights = 0;
+            std::size_t mNonEmptyBins = 0;
+            std::size_t mMaxBinSize = 0;
+            std::chrono::steady_clock::duration mTime{ 0 };
+        };
+
         void initPerObjectUniform(int targetLights);
         void initClustered();
 
@@ -301,8 +327,10 @@ namespace SceneUtil
 
         std::vector<LightSourceTransform> mLights;
 
-        using LightSourceViewBoundCollection = std::vector<LightSourceViewBound>;
-        std::map<osg::observer_ptr<osg::Camera>, LightSourceViewBoundCollection> mLightsInViewSpace;
+        std::map<osg::observer_ptr<osg::Camera>, ViewLights> mLightsInViewSpace;
+        std::vector<osg::BoundingSphere> mBinnedBounds;
+        BinningStats mBinningStats;
+        BinningStats mLastBinningStats;
 
         std::map<std::pair<const osg::RefMatrix*, std::vector<int>>, osg::ref_ptr<osg::StateSet>> mLightListStateSets;
 
@@ -401,6 +429,7 @@ namespace SceneUtil
         LightManager* mLightManager;
         size_t mLastFrameNumber;
         LightManager::LightList mLightList;
+        std::vector<std::size_t> mCandidates;
         std::set<SceneUtil::LightSource*> mIgnoredLightSources;
     };
 
@@ -5,11 +5,14 @@
 #include <cassert>
 #include <components/resource/scenemanager.hpp>
 
+#include "updatestage.hpp"
+
 namespace SceneUtil
 {
 
     MorphGeometry::MorphGeometry()
         : mLastFrameNumber(0)
+        , mLastCullFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
     {
@@ -19,6 +22,7 @@ namespace SceneUtil
         : osg::Drawable(copy, copyop)
         , mMorphTargets(copy.mMorphTargets)
         , mLastFrameNumber(0)
+        , mLastCullFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
     {
@@ -104,7 +108,11 @@ namespace SceneUtil
                 cv->popStateSet();
         }
         else
+        {
             nv.apply(*this);
+            if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
+                scheduleDeformation(nv);
+        }
 
         nv.popFromNodePath();
     }
@@ -172,17 +180,20 @@ namespace SceneUtil
 
     void MorphGeometry::cull(osg::NodeVisitor* nv)
     {
-        if (mLastFrameNumber == nv->getTraversalNumber() || !mDirty || mMorphTargets.size() == 0)
-        {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
-            return;
-        }
+        mLastCullFrameNumber = nv->getTraversalNumber();
+        if (mLastFrameNumber != nv->getTraversalNumber() && mDirty && mMorphTargets.size() != 0)
+            deform(nv->getTraversalNumber());
+
+        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
 
+    void MorphGeometry::deform(unsigned int frameNumber)
+    {
         mDirty = false;
-        mLastFrameNumber = nv->getTraversalNumber();
+        mLastFrameNumber = frameNumber;
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
         const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
@@ -204,10 +215,19 @@ namespace SceneUtil
         positionDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
+    }
 
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+    void MorphGeometry::scheduleDeformation(osg::NodeVisitor& nv)
+    {
+        // Same as for RigGeometry, only recently rendered geometries are worth morphing ahead of cull.
+        constexpr unsigned int recentFrames = 3;
+        const unsigned int traversalNumber = nv.getTraversalNumber();
+        if (!mDirty || mMorphTargets.empty() || mLastFrameNumber == traversalNumber)
+            return;
+        if (mLastCullFrameNumber == 0 || mLastCullFrameNumber + recentFrames < traversalNumber)
+            return;
+        if (UpdateStage* stage = UpdateStage::get(nv))
+            stage->add(*this);
     }
 
     osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
@@ -73,8 +73,13 @@ namespace SceneUtil
 
         osg::BoundingBox computeBoundingBox() const override;
 
+        /// Morphs the geometry for the frame ahead of the cull traversal, used by UpdateStage.
+        /// @note May be called from a worker thread.
+        void deform(unsigned int frameNumber);
+
     private:
         void cull(osg::NodeVisitor* nv);
+        void scheduleDeformation(osg::NodeVisitor& nv);
 
         MorphTargetList mMorphTargets;
 
@@ -84,6 +89,7 @@ namespace SceneUtil
         osg::Geometry* getGeometry(unsigned int frame) const;
 
         unsigned int mLastFrameNumber;
+        unsigned int mLastCullFrameNumber;
         bool mDirty; // Have any morph targets changed?
 
         mutable bool mMorphedBoundingBox;
@@ -0,0 +1,284 @@
+#include "occlusionbuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Triangles are clipped at this depth, boxes in front of it are never occluded.
+        constexpr float nearDepth = 1.0f;
+
+        constexpr float emptyDepth = std::numeric_limits<float>::infinity();
+
+        // Keeps the indices of the vertices within unsigned short.
+        constexpr std::size_t maxHeightfieldResolution = 254;
+
+        osg::Vec4f intersectNearPlane(const osg::Vec4f& a, const osg::Vec4f& b)
+        {
+            const float t = (nearDepth - a.w()) / (b.w() - a.w());
+            return a + (b - a) * t;
+        }
+
+        // Narrows [first, last] to the offsets where weight + step * offset is not negative.
+        void narrowSpan(float weight, float step, float& first, float& last)
+        {
+            if (step > 0)
+                first = std::max(first, -weight / step);
+            else if (step < 0)
+                last = std::min(last, -weight / step);
+            else if (weight < 0)
+                last = -1;
+        }
+
+        std::size_t roundUpToTiles(std::size_t value)
+        {
+            const std::size_t tileSize = OcclusionBuffer::sTileSize;
+            return (std::max<std::size_t>(value, 1) + tileSize - 1) / tileSize * tileSize;
+        }
+    }
+
+    osg::ref_ptr<Occluder> createHeightfieldOccluder(
+        std::span<const osg::Vec3f> positions, std::size_t verticesPerSide, std::size_t resolution)
+    {
+        osg::ref_ptr<Occluder> occluder = new Occluder;
+        if (verticesPerSide < 2 || resolution == 0 || positions.size() < verticesPerSide * verticesPerSide)
+            return occluder;
+
+        const std::size_t quads = std::min({ resolution, verticesPerSide - 1, maxHeightfieldResolution });
+        const auto getVertex = [&](std::size_t index) { return index * (verticesPerSide - 1) / quads; };
+
+        // Lowest vertex of the heightfield within every quad of the occluder, including its border.
+        std::vector<float> quadHeights(quads * quads, std::numeric_limits<float>::max());
+        for (std::size_t y = 0; y < quads; ++y)
+            for (std::size_t x = 0; x < quads; ++x)
+            {
+                float& height = quadHeights[y * quads + x];
+                for (std::size_t row = getVertex(y); row <= getVertex(y + 1); ++row)
+                    for (std::size_t column = getVertex(x); column <= getVertex(x + 1); ++column)
+                        height = std::min(height, positions[row * verticesPerSide + column].z());
+            }
+
+        // A vertex of the occluder takes the lowest height of its quads, so no triangle rises above the heightfield.
+        occluder->mVertices.reserve((quads + 1) * (quads + 1));
+        for (std::size_t y = 0; y <= quads; ++y)
+            for (std::size_t x = 0; x <= quads; ++x)
+            {
+                osg::Vec3f vertex = positions[getVertex(y) * verticesPerSide + getVertex(x)];
+                vertex.z() = std::numeric_limits<float>::max();
+                for (std::size_t quadY = std::max<std::size_t>(y, 1) - 1; quadY <= std::min(y, quads - 1); ++quadY)
+                    for (std::size_t quadX = std::max<std::size_t>(x, 1) - 1; quadX <= std::min(x, quads - 1); ++quadX)
+                        vertex.z() = std::min(vertex.z(), quadHeights[quadY * quads + quadX]);
+                occluder->mVertices.push_back(vertex);
+            }
+
+        const auto getIndex
+            = [&](std::size_t x, std::size_t y) { return static_cast<unsigned short>(y * (quads + 1) + x); };
+        occluder->mIndices.reserve(quads * quads * 6);
+        for (std::size_t y = 0; y < quads; ++y)
+            for (std::size_t x = 0; x < quads; ++x)
+                occluder->mIndices.insert(occluder->mIndices.end(),
+                    { getIndex(x, y), getIndex(x + 1, y), getIndex(x + 1, y + 1), getIndex(x, y),
+                        getIndex(x + 1, y + 1), getIndex(x, y + 1) });
+
+        return occluder;
+    }
+
+    OcclusionBuffer::OcclusionBuffer(std::size_t width, std::size_t height)
+        : mWidth(roundUpToTiles(width))
+        , mHeight(roundUpToTiles(height))
+        , mTilesX(mWidth / sTileSize)
+        , mTilesY(mHeight / sTileSize)
+        , mSamples((mWidth + 1) * (mHeight + 1), emptyDepth)
+        , mPixels(mWidth * mHeight, emptyDepth)
+        , mTiles(mTilesX * mTilesY, emptyDepth)
+    {
+    }
+
+    void OcclusionBuffer::clear()
+    {
+        std::fill(mSamples.begin(), mSamples.end(), emptyDepth);
+        std::fill(mPixels.begin(), mPixels.end(), emptyDepth);
+        std::fill(mTiles.begin(), mTiles.end(), emptyDepth);
+        mTriangleCount = 0;
+    }
+
+    void OcclusionBuffer::addOccluder(const Occluder& occluder, const osg::Matrixf& modelViewProjection)
+    {
+        mClipVertices.clear();
+        for (const osg::Vec3f& vertex : occluder.mVertices)
+            mClipVertices.push_back(osg::Vec4f(vertex, 1.f) * modelViewProjection);
+
+        for (std::size_t i = 0; i + 2 < occluder.mIndices.size(); i += 3)
+            addTriangle(mClipVertices[occluder.mIndices[i]], mClipVertices[occluder.mIndices[i + 1]],
+                mClipVertices[occluder.mIndices[i + 2]]);
+    }
+
+    void OcclusionBuffer::resolve()
+    {
+        std::fill(mTiles.begin(), mTiles.end(), 0.f);
+        const std::size_t rowSize = mWidth + 1;
+        for (std::size_t y = 0; y < mHeight; ++y)
+            for (std::size_t x = 0; x < mWidth; ++x)
+            {
+                const float* const top = mSamples.data() + y * rowSize + x;
+                const float* const bottom = top + rowSize;
+                const float depth = std::max({ top[0], top[1], bottom[0], bottom[1] });
+                mPixels[y * mWidth + x] = depth;
+                float& tile = mTiles[(y / sTileSize) * mTilesX + x / sTileSize];
+                tile = std::max(tile, depth);
+            }
+    }
+
+    bool OcclusionBuffer::isOccluded(const osg::BoundingBox& box, const osg::Matrixf& modelViewProjection) const
+    {
+        if (!box.valid())
+            return false;
+
+        float minX = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+        float minDepth = std::numeric_limits<float>::max();
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            const osg::Vec4f clip = osg::Vec4f(box.corner(i), 1.f) * modelViewProjection;
+            if (!(clip.w() >= nearDepth))
+                return false;
+            const ScreenVertex vertex = toScreen(clip);
+            minX = std::min(minX, vertex.mX);
+            maxX = std::max(maxX, vertex.mX);
+            minY = std::min(minY, vertex.mY);
+            maxY = std::max(maxY, vertex.mY);
+            minDepth = std::min(minDepth, clip.w());
+        }
+
+        // Boxes outside of the screen are left to the frustum culling.
+        const float width = static_cast<float>(mWidth);
+        const float height = static_cast<float>(mHeight);
+        if (maxX < 0 || minX >= width || maxY < 0 || minY >= height)
+            return false;
+
+        const std::size_t beginX = static_cast<std::size_t>(std::max(std::floor(minX), 0.f));
+        const std::size_t endX = static_cast<std::size_t>(std::min(std::floor(maxX) + 1, width));
+        const std::size_t beginY = static_cast<std::size_t>(std::max(std::floor(minY), 0.f));
+        const std::size_t endY = static_cast<std::size_t>(std::min(std::floor(maxY) + 1, height));
+
+        for (std::size_t tileY = beginY / sTileSize; tileY <= (endY - 1) / sTileSize; ++tileY)
+            for (std::size_t tileX = beginX / sTileSize; tileX <= (endX - 1) / sTileSize; ++tileX)
+            {
+                if (mTiles[tileY * mTilesX + tileX] < minDepth)
+                    continue;
+                for (std::size_t y = std::max(beginY, tileY * sTileSize); y < std::min(endY, (tileY + 1) * sTileSize);
+                     ++y)
+                    for (std::size_t x = std::max(beginX, tileX * sTileSize);
+                         x < std::min(endX, (tileX + 1) * sTileSize); ++x)
+                        if (mPixels[y * mWidth + x] >= minDepth)
+                            return false;
+            }
+
+        return true;
+    }
+
+    void OcclusionBuffer::addTriangle(const osg::Vec4f& a, const osg::Vec4f& b, const osg::Vec4f& c)
+    {
+        // Clipping a triangle at the near plane leaves up to 4 vertices.
+        const std::array<const osg::Vec4f*, 3> vertices{ &a, &b, &c };
+        std::array<osg::Vec4f, 4> clipped;
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            const osg::Vec4f& current = *vertices[i];
+            const osg::Vec4f& next = *vertices[(i + 1) % vertices.size()];
+            const bool currentInside = current.w() >= nearDepth;
+            if (currentInside)
+                clipped[count++] = current;
+            if (currentInside != (next.w() >= nearDepth))
+                clipped[count++] = intersectNearPlane(current, next);
+        }
+        if (count < 3)
+            return;
+
+        ++mTriangleCount;
+        const ScreenVertex first = toScreen(clipped[0]);
+        ScreenVertex previous = toScreen(clipped[1]);
+        for (std::size_t i = 2; i < count; ++i)
+        {
+            const ScreenVertex current = toScreen(clipped[i]);
+            rasterize(first, previous, current);
+            previous = current;
+        }
+    }
+
+    OcclusionBuffer::ScreenVertex OcclusionBuffer::toScreen(const osg::Vec4f& clip) const
+    {
+        const float inverseDepth = 1.f / clip.w();
+        return ScreenVertex{
+            .mX = (clip.x() * inverseDepth + 1.f) * 0.5f * static_cast<float>(mWidth),
+            .mY = (clip.y() * inverseDepth + 1.f) * 0.5f * static_cast<float>(mHeight),
+            .mInverseDepth = inverseDepth,
+        };
+    }
+
+    void OcclusionBuffer::rasterize(const ScreenVertex& a, const ScreenVertex& b, const ScreenVertex& c)
+    {
+        const float area = (b.mX - a.mX) * (c.mY - a.mY) - (b.mY - a.mY) * (c.mX - a.mX);
+        if (!std::isfinite(area) || area == 0)
+            return;
+
+        const float minX = std::max(std::ceil(std::min({ a.mX, b.mX, c.mX })), 0.f);
+        const float maxX = std::min(std::floor(std::max({ a.mX, b.mX, c.mX })), static_cast<float>(mWidth));
+        const float minY = std::max(std::ceil(std::min({ a.mY, b.mY, c.mY })), 0.f);
+        const float maxY = std::min(std::floor(std::max({ a.mY, b.mY, c.mY })), static_cast<float>(mHeight));
+        if (minX > maxX || minY > maxY)
+            return;
+
+        // Weights of b and c are linear in the sample position and divided by the signed area, so the triangle
+        // covers the samples where both and their sum are within [0, 1] whatever its winding is.
+        const float inverseArea = 1.f / area;
+        const float bStepX = (c.mY - a.mY) * inverseArea;
+        const float bStepY = (a.mX - c.mX) * inverseArea;
+        const float cStepX = (a.mY - b.mY) * inverseArea;
+        const float cStepY = (b.mX - a.mX) * inverseArea;
+        const float bInverseDepth = b.mInverseDepth - a.mInverseDepth;
+        const float cInverseDepth = c.mInverseDepth - a.mInverseDepth;
+
+        const std::size_t beginX = static_cast<std::size_t>(minX);
+        const std::size_t beginY = static_cast<std::size_t>(minY);
+        const std::size_t endY = static_cast<std::size_t>(maxY) + 1;
+        for (std::size_t y = beginY; y < endY; ++y)
+        {
+            const float offsetY = static_cast<float>(y) - a.mY;
+            const float rowBWeight = (minX - a.mX) * bStepX + offsetY * bStepY;
+            const float rowCWeight = (minX - a.mX) * cStepX + offsetY * cStepY;
+
+            // Skip the samples of the row outside of the triangle, large triangles cover a small part of their bounds.
+            float first = 0;
+            float last = maxX - minX;
+            narrowSpan(rowBWeight, bStepX, first, last);
+            narrowSpan(rowCWeight, cStepX, first, last);
+            narrowSpan(1 - rowBWeight - rowCWeight, -bStepX - cStepX, first, last);
+            first = std::ceil(first);
+            last = std::floor(last);
+            if (first > last)
+                continue;
+
+            const float offsetX = minX + first - a.mX;
+            float bWeight = offsetX * bStepX + offsetY * bStepY;
+            float cWeight = offsetX * cStepX + offsetY * cStepY;
+            float* const row = mSamples.data() + y * (mWidth + 1);
+            const std::size_t spanEnd = beginX + static_cast<std::size_t>(last) + 1;
+            for (std::size_t x = beginX + static_cast<std::size_t>(first); x < spanEnd;
+                 ++x, bWeight += bStepX, cWeight += cStepX)
+            {
+                if (bWeight < 0 || cWeight < 0 || bWeight + cWeight > 1)
+                    continue;
+                const float depth = 1.f / (a.mInverseDepth + bWeight * bInverseDepth + cWeight * cInverseDepth);
+                row[x] = std::min(row[x], depth);
+            }
+        }
+    }
+}
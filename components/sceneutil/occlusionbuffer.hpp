@@ -0,0 +1,120 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_OCCLUSIONBUFFER_H
+#define OPENMW_COMPONENTS_SCENEUTIL_OCCLUSIONBUFFER_H
+
+#include <osg/BoundingBox>
+#include <osg/Matrixf>
+#include <osg/Node>
+#include <osg/Object>
+#include <osg/UserDataContainer>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// Triangles hiding everything behind them, in the local space of the node they are attached to as a user object.
+    /// @note The triangles have to lie inside of the geometry they stand for, so they never hide anything the
+    /// geometry does not hide.
+    struct Occluder : public osg::Object
+    {
+    public:
+        Occluder() {}
+        Occluder(const Occluder& copy, const osg::CopyOp& copyop)
+            : osg::Object(copy, copyop)
+            , mVertices(copy.mVertices)
+            , mIndices(copy.mIndices)
+        {
+        }
+
+        std::vector<osg::Vec3f> mVertices;
+        std::vector<unsigned short> mIndices;
+
+        META_Object(SceneUtil, Occluder)
+    };
+
+    /// Calls f with every occluder attached to the node.
+    template <class Function>
+    void forEachOccluder(const osg::Node& node, Function&& f)
+    {
+        const osg::UserDataContainer* container = node.getUserDataContainer();
+        if (container == nullptr)
+            return;
+        for (unsigned int i = 0; i < container->getNumUserObjects(); ++i)
+            if (const Occluder* occluder = dynamic_cast<const Occluder*>(container->getUserObject(i)))
+                f(*occluder);
+    }
+
+    /// Creates an occluder for a heightfield, which never rises above the heightfield.
+    /// @param positions vertices of the heightfield in row-major order, a row is parallel to the x-axis
+    /// @param verticesPerSide number of vertices of a row and of a column
+    /// @param resolution number of quads of the occluder along each side, reduced to the number of quads of the
+    /// heightfield when it has less
+    osg::ref_ptr<Occluder> createHeightfieldOccluder(
+        std::span<const osg::Vec3f> positions, std::size_t verticesPerSide, std::size_t resolution);
+
+    /// @brief Low resolution depth buffer of occluders rasterized on the CPU, used to skip drawing bounding boxes
+    /// hidden behind them.
+    /// @par Depth is the distance along the view direction (clip space w), so only perspective projections are
+    /// supported. Occluders are sampled at the corners of every pixel and a pixel keeps the farthest depth of its
+    /// corners, a bounding box is occluded when it is behind the pixels covering its screen rectangle.
+    class OcclusionBuffer
+    {
+    public:
+        /// Number of pixels along each side of a tile, keeping the farthest depth of its pixels.
+        static constexpr std::size_t sTileSize = 8;
+
+        /// @param width, height number of pixels, rounded up to a multiple of sTileSize.
+        OcclusionBuffer(std::size_t width, std::size_t height);
+
+        std::size_t getWidth() const { return mWidth; }
+
+        std::size_t getHeight() const { return mHeight; }
+
+        /// Removes every occluder.
+        void clear();
+
+        /// Rasterizes the triangles of the occluder, the matrix transforms its vertices into clip space.
+        void addOccluder(const Occluder& occluder, const osg::Matrixf& modelViewProjection);
+
+        /// Computes the depth of the pixels and tiles, has to be called after adding occluders before testing.
+        void resolve();
+
+        /// @return true if the box is behind the occluders everywhere on screen, boxes crossing the near plane
+        /// are never occluded. The matrix transforms the box into clip space.
+        bool isOccluded(const osg::BoundingBox& box, const osg::Matrixf& modelViewProjection) const;
+
+        /// Number of triangles rasterized since the last clear.
+        std::size_t getTriangleCount() const { return mTriangleCount; }
+
+    private:
+        struct ScreenVertex
+        {
+            float mX;
+            float mY;
+            float mInverseDepth;
+        };
+
+        std::size_t mWidth;
+        std::size_t mHeight;
+        std::size_t mTilesX;
+        std::size_t mTilesY;
+        // Depth at the corners of the pixels, (mWidth + 1) * (mHeight + 1) in row-major order.
+        std::vector<float> mSamples;
+        std::vector<float> mPixels;
+        std::vector<float> mTiles;
+        std::vector<osg::Vec4f> mClipVertices;
+        std::size_t mTriangleCount = 0;
+
+        void addTriangle(const osg::Vec4f& a, const osg::Vec4f& b, const osg::Vec4f& c);
+
+        ScreenVertex toScreen(const osg::Vec4f& clip) const;
+
+        void rasterize(const ScreenVertex& a, const ScreenVertex& b, const ScreenVertex& c);
+    };
+}
+
+#endif
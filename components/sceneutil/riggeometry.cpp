@@ -9,10 +9,45 @@
 #include <components/resource/scenemanager.hpp>
 
 #include "skeleton.hpp"
+#include "skinning.hpp"
+#include "updatestage.hpp"
 #include "util.hpp"
 
+#include <algorithm>
+
 namespace SceneUtil
 {
+    namespace
+    {
+        static_assert(sizeof(osg::Matrixf) == 16 * sizeof(float));
+
+        template <class Array>
+        void appendComponents(
+            const Array& source, const std::vector<unsigned short>& vertices, std::array<std::vector<float>, 3>& result)
+        {
+            for (unsigned short vertex : vertices)
+                for (std::size_t i = 0; i < 3; ++i)
+                    result[i].push_back(source[vertex][i]);
+        }
+
+        ConstSkinningStream getStream(const std::array<std::vector<float>, 3>& components, std::size_t offset)
+        {
+            return { components[0].data() + offset, components[1].data() + offset, components[2].data() + offset };
+        }
+
+        void scatter(const SkinningStream& values, const std::vector<unsigned short>& vertices, osg::Vec3Array& result)
+        {
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+                result[vertices[i]].set(values[0][i], values[1][i], values[2][i]);
+        }
+
+        void scatter(const SkinningStream& values, const std::vector<unsigned short>& vertices,
+            const osg::Vec4Array& source, osg::Vec4Array& result)
+        {
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+                result[vertices[i]].set(values[0][i], values[1][i], values[2][i], source[vertices[i]].w());
+        }
+    }
 
     RigGeometry::RigGeometry()
     {
@@ -25,6 +60,7 @@ namespace SceneUtil
         , mData(copy.mData)
     {
         setSourceGeometry(copy.mSourceGeometry);
+        mSkinningData = copy.mSkinningData;
         setNumChildrenRequiringUpdateTraversal(1);
     }
 
@@ -34,6 +70,7 @@ namespace SceneUtil
             mGeometry[i] = nullptr;
 
         mSourceGeometry = sourceGeometry;
+        mSkinningData = new SkinningData;
 
         for (unsigned int i = 0; i < 2; ++i)
         {
@@ -124,11 +161,11 @@ namespace SceneUtil
             return false;
         }
 
-        mNodes.clear();
+        mBones.clear();
         for (const BoneInfo& info : mData->mBones)
         {
-            mNodes.push_back(mSkeleton->getBone(info.mName));
-            if (!mNodes.back())
+            mBones.push_back(mSkeleton->getBone(info.mName));
+            if (mBones.back() == Skeleton::sNoBone)
                 Log(Debug::Error) << "Error: RigGeometry did not find bone " << info.mName;
         }
 
@@ -147,35 +184,45 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        mLastCullFrameNumber = traversalNumber;
+        if (mLastFrameNumber != traversalNumber
+            && (mLastFrameNumber == 0
+                || (mSkeleton->getActive() && !mSkeleton->isPoseUnchanged(traversalNumber))))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
-            return;
+            mSkeleton->updateBoneMatrices(traversalNumber);
+            deform(traversalNumber);
         }
-        mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
-        mSkeleton->updateBoneMatrices(traversalNumber);
+        osg::Geometry& geom = *getGeometry();
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
+
+    void RigGeometry::deform(unsigned int frameNumber)
+    {
+        mLastFrameNumber = frameNumber;
+        mCurrentGeometry ^= 1;
+        osg::Geometry& geom = *getGeometry();
 
-        // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
         const osg::Vec4Array* tangentSrc = mSourceTangents;
 
         osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
         osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
         osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-        std::vector<osg::Matrixf> boneMatrices(mNodes.size());
-        std::vector<Bone*>::const_iterator bone = mNodes.begin();
+        const SkinningData& skinning = getSkinningData();
+
+        // Missing bones get a zero matrix, so they don't contribute to the blended matrices.
+        mBoneMatrices.resize(mBones.size());
+        std::vector<std::size_t>::const_iterator bone = mBones.begin();
         std::vector<BoneInfo>::const_iterator boneInfo = mData->mBones.begin();
-        for (osg::Matrixf& boneMat : boneMatrices)
+        for (osg::Matrixf& boneMat : mBoneMatrices)
         {
-            if (*bone != nullptr)
-                boneMat = boneInfo->mInvBindMatrix * (*bone)->mMatrixInSkeletonSpace;
+            if (*bone != Skeleton::sNoBone)
+                boneMat = boneInfo->mInvBindMatrix * mSkeleton->getBoneMatrix(*bone);
+            else
+                std::fill(boneMat.ptr(), boneMat.ptr() + 16, 0.f);
             ++bone;
             ++boneInfo;
         }
@@ -186,37 +233,40 @@ namespace SceneUtil
         else
             transform = mData->mTransform;
 
+        const std::size_t capacity = skinning.mMaxGroupSize;
+        mSkinnedVertices.resize(3 * capacity);
+        const SkinningStream skinned{ mSkinnedVertices.data(), mSkinnedVertices.data() + capacity,
+            mSkinnedVertices.data() + 2 * capacity };
+        const float* const boneMatrices = reinterpret_cast<const float*>(mBoneMatrices.data());
+
+        std::size_t influenceOffset = 0;
+        std::size_t vertexOffset = 0;
         for (const auto& [influences, vertices] : mData->mInfluences)
         {
-            osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
-
-            for (const auto& [index, weight] : influences)
-            {
-                if (mNodes[index] == nullptr)
-                    continue;
-                const float* boneMatPtr = boneMatrices[index].ptr();
-                float* resultMatPtr = resultMat.ptr();
-                for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
-                    if (i % 4 != 3)
-                        *resultMatPtr += *boneMatPtr * weight;
-            }
+            osg::Matrixf resultMat;
+            blendSkinningMatrices(boneMatrices, skinning.mBoneIndices.data() + influenceOffset,
+                skinning.mBoneWeights.data() + influenceOffset, influences.size(), resultMat.ptr());
+            influenceOffset += influences.size();
 
             resultMat *= transform;
 
-            for (unsigned short vertex : vertices)
+            const std::size_t count = vertices.size();
+            skinPositions(resultMat.ptr(), getStream(skinning.mPositions, vertexOffset), count, skinned);
+            scatter(skinned, vertices, *positionDst);
+
+            if (normalDst)
             {
-                (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-                if (normalDst)
-                    (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+                skinDirections(resultMat.ptr(), getStream(skinning.mNormals, vertexOffset), count, skinned);
+                scatter(skinned, vertices, *normalDst);
+            }
 
-                if (tangentDst)
-                {
-                    const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                    osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
-                        osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                    (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-                }
+            if (tangentDst)
+            {
+                skinDirections(resultMat.ptr(), getStream(skinning.mTangents, vertexOffset), count, skinned);
+                scatter(skinned, vertices, *tangentSrc, *tangentDst);
             }
+
+            vertexOffset += count;
         }
 
         positionDst->dirty();
@@ -226,10 +276,50 @@ namespace SceneUtil
             tangentDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
+    }
 
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+    void RigGeometry::scheduleDeformation(osg::NodeVisitor& nv)
+    {
+        // Rigs rendered in one of the last frames are likely to be rendered in this one too, others are skinned only
+        // when culled.
+        constexpr unsigned int recentFrames = 3;
+        const unsigned int traversalNumber = nv.getTraversalNumber();
+        if (mSkeleton == nullptr || mLastCullFrameNumber == 0 || mLastCullFrameNumber + recentFrames < traversalNumber)
+            return;
+        if (mLastFrameNumber == traversalNumber || !mSkeleton->getActive())
+            return;
+        // Bones may still be animated later in the traversal, so only the stage updates the bone matrices.
+        if (UpdateStage* stage = UpdateStage::get(nv))
+            stage->add(*this);
+    }
+
+    void RigGeometry::updateBoneMatrices(unsigned int frameNumber)
+    {
+        mSkeleton->updateBoneMatrices(frameNumber);
+    }
+
+    const RigGeometry::SkinningData& RigGeometry::getSkinningData()
+    {
+        SkinningData& data = *mSkinningData;
+        std::call_once(data.mInitialized, [&] {
+            const osg::Vec3Array* positions = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+            const osg::Vec3Array* normals = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+            for (const auto& [influences, vertices] : mData->mInfluences)
+            {
+                for (const auto& [index, weight] : influences)
+                {
+                    data.mBoneIndices.push_back(index);
+                    data.mBoneWeights.push_back(weight);
+                }
+                appendComponents(*positions, vertices, data.mPositions);
+                if (normals != nullptr)
+                    appendComponents(*normals, vertices, data.mNormals);
+                if (mSourceTangents != nullptr)
+                    appendComponents(*mSourceTangents, vertices, data.mTangents);
+                data.mMaxGroupSize = std::max(data.mMaxGroupSize, vertices.size());
+            }
+        });
+        return data;
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -258,12 +348,12 @@ namespace SceneUtil
         size_t index = 0;
         for (const BoneInfo& info : mData->mBones)
         {
-            const Bone* bone = mNodes[index++];
-            if (bone == nullptr)
+            const std::size_t bone = mBones[index++];
+            if (bone == Skeleton::sNoBone)
                 continue;
 
             osg::BoundingSpheref bs = info.mBoundSphere;
-            transformBoundingSphere(bone->mMatrixInSkeletonSpace * transform, bs);
+            transformBoundingSphere(mSkeleton->getBoneMatrix(bone) * transform, bs);
             box.expandBy(bs);
         }
 
@@ -343,6 +433,7 @@ namespace SceneUtil
 
         mData->mInfluences.reserve(influencesToVertices.size());
         mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mSkinningData = new SkinningData;
     }
 
     void RigGeometry::setTransform(osg::Matrixf&& transform)
@@ -380,7 +471,10 @@ namespace SceneUtil
                 cv->popStateSet();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
+        {
             updateBounds(&nv);
+            scheduleDeformation(nv);
+        }
         else
             nv.apply(*this);
 
@@ -389,12 +483,12 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        getGeometry()->accept(func);
     }
 
-    osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
+    osg::Geometry* RigGeometry::getGeometry() const
     {
-        return mGeometry[frame % 2].get();
+        return mGeometry[mCurrentGeometry].get();
     }
 
 }
@@ -4,12 +4,14 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <array>
+#include <mutex>
 #include <string_view>
+#include <vector>
 
 namespace SceneUtil
 {
     class Skeleton;
-    class Bone;
 
     // TODO: This class has a lot of issues.
     // - We require too many workarounds to ensure safety.
@@ -25,6 +27,7 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note Skinning is skipped in frames where the Skeleton's animation LOD kept the pose unchanged.
     class RigGeometry : public osg::Drawable
     {
     public:
@@ -66,6 +69,14 @@ namespace SceneUtil
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
 
+        /// Updates the bone matrices of the skeleton for the frame, used by UpdateStage before deform.
+        /// @note The matrices are shared by all rigs of the skeleton, so this must be called from a single thread.
+        void updateBoneMatrices(unsigned int frameNumber);
+
+        /// Skins the geometry for the frame ahead of the cull traversal, used by UpdateStage.
+        /// @note May be called from a worker thread, bone matrices must already be updated for the frame.
+        void deform(unsigned int frameNumber);
+
         struct CopyBoundingBoxCallback : osg::Drawable::ComputeBoundingBoxCallback
         {
             osg::BoundingBox boundingBox;
@@ -83,9 +94,13 @@ namespace SceneUtil
     private:
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
+        void scheduleDeformation(osg::NodeVisitor& nv);
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
-        osg::Geometry* getGeometry(unsigned int frame) const;
+        // Skinning alternates between the geometries, so the one drawn last frame is never written to even when some
+        // frames reuse the previous skinning.
+        unsigned int mCurrentGeometry{ 0 };
+        osg::Geometry* getGeometry() const;
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
         osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
@@ -102,13 +117,35 @@ namespace SceneUtil
             std::string mRootBone;
         };
         osg::ref_ptr<InfluenceData> mData;
-        std::vector<Bone*> mNodes;
+        // Indices of mData->mBones in the skeleton.
+        std::vector<std::size_t> mBones;
+
+        // Influences and source vertices rearranged for the skinning kernels: vertices of each influence group are
+        // consecutive, components are stored in separate arrays. Built on first use and shared between copies.
+        struct SkinningData : public osg::Referenced
+        {
+            std::once_flag mInitialized;
+            std::vector<std::size_t> mBoneIndices;
+            std::vector<float> mBoneWeights;
+            std::array<std::vector<float>, 3> mPositions;
+            std::array<std::vector<float>, 3> mNormals;
+            std::array<std::vector<float>, 3> mTangents;
+            std::size_t mMaxGroupSize = 0;
+        };
+        osg::ref_ptr<SkinningData> mSkinningData;
+
+        // Scratch buffers reused by every skinning to avoid allocations.
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::vector<float> mSkinnedVertices;
 
         unsigned int mLastFrameNumber{ 0 };
+        unsigned int mLastCullFrameNumber{ 0 };
         bool mBoundsFirstFrame{ true };
 
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
 
+        const SkinningData& getSkinningData();
+
         void updateSkinToSkelMatrix(const osg::NodePath& nodePath);
     };
 
@@ -12,6 +12,7 @@
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 #include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/texturetype.hpp>
+#include <components/shader/removedalphafunc.hpp>
 
 namespace SceneUtil
 {
@@ -156,6 +157,16 @@ namespace SceneUtil
         }
     };
 
+    class RemovedAlphaFuncSerializer : public osgDB::ObjectWrapper
+    {
+    public:
+        RemovedAlphaFuncSerializer()
+            : osgDB::ObjectWrapper(createInstanceFunc<Shader::RemovedAlphaFunc>, "Shader::RemovedAlphaFunc",
+                "osg::Object osg::StateAttribute osg::AlphaFunc Shader::RemovedAlphaFunc")
+        {
+        }
+    };
+
     osgDB::ObjectWrapper* makeDummySerializer(const std::string& classname)
     {
         return new osgDB::ObjectWrapper(createInstanceFunc<osg::DummyObject>, classname, "osg::Object");
@@ -171,13 +182,28 @@ namespace SceneUtil
         }
     };
 
+    void registerReadableSerializers()
+    {
+        static const bool done = [] {
+            osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
+            mgr->addWrapper(new PositionAttitudeTransformSerializer);
+            mgr->addWrapper(new MatrixTransformSerializer);
+            mgr->addWrapper(new AutoTransformSerializer);
+            mgr->addWrapper(new TextureTypeSerializer);
+            mgr->addWrapper(new RemovedAlphaFuncSerializer);
+            return true;
+        }();
+        static_cast<void>(done);
+    }
+
     void registerSerializers()
     {
         static bool done = false;
         if (!done)
         {
+            registerReadableSerializers();
+
             osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
-            mgr->addWrapper(new PositionAttitudeTransformSerializer);
             mgr->addWrapper(new SkeletonSerializer);
             mgr->addWrapper(new RigGeometrySerializer);
             mgr->addWrapper(new RigGeometryHolderSerializer);
@@ -185,9 +211,6 @@ namespace SceneUtil
             mgr->addWrapper(new MorphGeometrySerializer);
             mgr->addWrapper(new LightManagerSerializer);
             mgr->addWrapper(new CameraRelativeTransformSerializer);
-            mgr->addWrapper(new MatrixTransformSerializer);
-            mgr->addWrapper(new AutoTransformSerializer);
-            mgr->addWrapper(new TextureTypeSerializer);
 
             // Don't serialize Geometry data as we are more interested in the overall structure rather than tons of
             // vertex data that would make the file large and hard to read.
@@ -213,6 +236,7 @@ namespace SceneUtil
                 "SceneUtil::DisableLight",
                 "SceneUtil::MWShadowTechnique",
                 "SceneUtil::TextKeyMapHolder",
+                "SceneUtil::Occluder",
                 "Shader::AddedState",
                 "Shader::RemovedAlphaFunc",
                 "NifOsg::FlipController",
@@ -7,6 +7,10 @@ namespace SceneUtil
     /// Register osg node serializers for certain SceneUtil classes if not already done so
     void registerSerializers();
 
+    /// Register the subset of the serializers of registerSerializers that write everything needed to read the node
+    /// back, if not already done so. Unlike registerSerializers, doesn't discard the data of osg::Geometry.
+    void registerReadableSerializers();
+
 }
 
 #endif
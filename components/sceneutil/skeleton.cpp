@@ -1,94 +1,168 @@
 #include "skeleton.hpp"
 
+#include <osg/CullStack>
 #include <osg/MatrixTransform>
 
-#include <components/debug/debuglog.hpp>
-#include <components/misc/strings/lower.hpp>
+#include <components/misc/strings/algorithm.hpp>
+
+#include "updatestage.hpp"
 
 #include <algorithm>
+#include <string_view>
 
 namespace SceneUtil
 {
 
-    class InitBoneCacheVisitor : public osg::NodeVisitor
+    namespace
     {
-    public:
-        typedef std::vector<osg::MatrixTransform*> TransformPath;
-        InitBoneCacheVisitor(std::unordered_map<std::string, TransformPath>& cache)
-            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
-            , mCache(cache)
+        bool isDetailBone(std::string_view name)
         {
+            constexpr std::string_view detailBones[] = { "finger", "toe", "jaw", "tongue", "eye", "brow", "lip" };
+            return std::any_of(std::begin(detailBones), std::end(detailBones), [&](std::string_view detail) {
+                return Misc::StringUtils::ciFind(name, detail) != std::string_view::npos;
+            });
         }
 
-        void apply(osg::MatrixTransform& node) override
+        class InitNodesVisitor : public osg::NodeVisitor
         {
-            mPath.push_back(&node);
-            mCache.emplace(Misc::StringUtils::lowerCase(node.getName()), mPath);
-            traverse(node);
-            mPath.pop_back();
-        }
+        public:
+            InitNodesVisitor(std::vector<osg::MatrixTransform*>& nodes, std::vector<std::size_t>& parents)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mNodes(nodes)
+                , mParents(parents)
+            {
+            }
 
-    private:
-        TransformPath mPath;
-        std::unordered_map<std::string, TransformPath>& mCache;
-    };
+            void apply(osg::MatrixTransform& node) override
+            {
+                const std::size_t index = mNodes.size();
+                mNodes.push_back(&node);
+                mParents.push_back(mPath.empty() ? Skeleton::sNoBone : mPath.back());
+                mPath.push_back(index);
+                traverse(node);
+                mPath.pop_back();
+            }
+
+        private:
+            std::vector<std::size_t> mPath;
+            std::vector<osg::MatrixTransform*>& mNodes;
+            std::vector<std::size_t>& mParents;
+        };
+
+        class InitDetailBonesVisitor : public osg::NodeVisitor
+        {
+        public:
+            InitDetailBonesVisitor(std::vector<std::pair<osg::Node*, osg::Node::NodeMask>>& detailBones)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mDetailBones(detailBones)
+            {
+            }
+
+            void apply(osg::MatrixTransform& node) override
+            {
+                // Children of a detail bone are skipped along with it.
+                if (isDetailBone(node.getName()))
+                    mDetailBones.emplace_back(&node, node.getNodeMask());
+                else
+                    traverse(node);
+            }
+
+        private:
+            std::vector<std::pair<osg::Node*, osg::Node::NodeMask>>& mDetailBones;
+        };
+    }
+
+    std::array<float, Skeleton::sLodCount - 1> Skeleton::sLodScreenSizes{};
 
     Skeleton::Skeleton()
-        : mBoneCacheInit(false)
+        : mNodesInit(false)
         , mNeedToUpdateBoneMatrices(true)
         , mActive(Active)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLod(Lod::Full)
+        , mScreenSize(0)
+        , mScreenSizeFrameNumber(0)
+        , mLastUpdateFrameNumber(0)
+        , mSkippedFrameNumber(0)
+        , mLastPoseFrameNumber(0)
+        , mPreviousPoseFrameNumber(0)
+        , mPoseExtrapolated(false)
+        , mDetailBonesInit(false)
     {
     }
 
     Skeleton::Skeleton(const Skeleton& copy, const osg::CopyOp& copyop)
         : osg::Group(copy, copyop)
-        , mBoneCacheInit(false)
+        , mNodesInit(false)
         , mNeedToUpdateBoneMatrices(true)
         , mActive(copy.mActive)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLod(Lod::Full)
+        , mScreenSize(0)
+        , mScreenSizeFrameNumber(0)
+        , mLastUpdateFrameNumber(0)
+        , mSkippedFrameNumber(0)
+        , mLastPoseFrameNumber(0)
+        , mPreviousPoseFrameNumber(0)
+        , mPoseExtrapolated(false)
+        , mDetailBonesInit(false)
     {
     }
 
-    Bone* Skeleton::getBone(const std::string& name)
+    void Skeleton::initNodes()
     {
-        if (!mBoneCacheInit)
+        mNodes.clear();
+        mNodeParents.clear();
+        mNodeByName.clear();
+        InitNodesVisitor visitor(mNodes, mNodeParents);
+        accept(visitor);
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
+            mNodeByName.emplace(mNodes[i]->getName(), i);
+
+        // Bones added before the skeleton was changed keep their indices.
+        mNodeBones.assign(mNodes.size(), sNoBone);
+        if (!mBoneNodes.empty())
         {
-            InitBoneCacheVisitor visitor(mBoneCache);
-            accept(visitor);
-            mBoneCacheInit = true;
+            std::unordered_map<const osg::MatrixTransform*, std::size_t> nodeIndices;
+            for (std::size_t i = 0; i < mNodes.size(); ++i)
+                nodeIndices.emplace(mNodes[i], i);
+            for (std::size_t i = 0; i < mBoneNodes.size(); ++i)
+            {
+                const auto found = nodeIndices.find(mBoneNodes[i]);
+                if (found != nodeIndices.end())
+                    mNodeBones[found->second] = i;
+            }
         }
 
-        BoneCache::iterator found = mBoneCache.find(Misc::StringUtils::lowerCase(name));
-        if (found == mBoneCache.end())
-            return nullptr;
-
-        // find or insert in the bone hierarchy
-
-        if (!mRootBone.get())
-        {
-            mRootBone = std::make_unique<Bone>();
-        }
+        mNodesInit = true;
+    }
 
-        Bone* bone = mRootBone.get();
-        for (osg::MatrixTransform* matrixTransform : found->second)
-        {
-            const auto it = std::find_if(bone->mChildren.begin(), bone->mChildren.end(),
-                [&](const auto& v) { return v->mNode == matrixTransform; });
+    std::size_t Skeleton::getBone(std::string_view name)
+    {
+        if (!mNodesInit)
+            initNodes();
 
-            if (it == bone->mChildren.end())
-            {
-                bone = bone->mChildren.emplace_back(std::make_unique<Bone>()).get();
-                mNeedToUpdateBoneMatrices = true;
-            }
-            else
-                bone = it->get();
+        const auto found = mNodeByName.find(name);
+        if (found == mNodeByName.end())
+            return sNoBone;
 
-            bone->mNode = matrixTransform;
-        }
+        return addBone(found->second);
+    }
 
+    std::size_t Skeleton::addBone(std::size_t node)
+    {
+        if (mNodeBones[node] != sNoBone)
+            return mNodeBones[node];
+
+        const std::size_t parent = mNodeParents[node] == sNoBone ? sNoBone : addBone(mNodeParents[node]);
+        const std::size_t bone = mBoneNodes.size();
+        mBoneNodes.push_back(mNodes[node]);
+        mBoneParents.push_back(parent);
+        mBoneMatrices.emplace_back();
+        mNodeBones[node] = bone;
+        mNeedToUpdateBoneMatrices = true;
         return bone;
     }
 
@@ -101,10 +175,13 @@ namespace SceneUtil
 
         if (mNeedToUpdateBoneMatrices)
         {
-            if (mRootBone.get())
+            for (std::size_t i = 0; i < mBoneNodes.size(); ++i)
             {
-                for (const auto& child : mRootBone->mChildren)
-                    child->update(nullptr);
+                const std::size_t parent = mBoneParents[i];
+                if (parent == sNoBone)
+                    mBoneMatrices[i] = mBoneNodes[i]->getMatrix();
+                else
+                    mBoneMatrices[i] = mBoneNodes[i]->getMatrix() * mBoneMatrices[parent];
             }
 
             mNeedToUpdateBoneMatrices = false;
@@ -121,11 +198,22 @@ namespace SceneUtil
         return mActive != Inactive;
     }
 
+    void Skeleton::setLodScreenSizes(const std::array<float, sLodCount - 1>& sizes)
+    {
+        sLodScreenSizes = sizes;
+    }
+
     void Skeleton::markDirty()
     {
         mLastFrameNumber = 0;
-        mBoneCache.clear();
-        mBoneCacheInit = false;
+        mNodesInit = false;
+        // Removed nodes may be gone already, so an extrapolated pose can't be reset. Controllers set the animated
+        // channels again on the next update.
+        mLastPoseFrameNumber = 0;
+        mPreviousPoseFrameNumber = 0;
+        mPoseExtrapolated = false;
+        mDetailBones.clear();
+        mDetailBonesInit = false;
     }
 
     void Skeleton::traverse(osg::NodeVisitor& nv)
@@ -134,44 +222,162 @@ namespace SceneUtil
         {
             if (mActive == Inactive && mLastFrameNumber != 0)
                 return;
-            if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
+            const unsigned int traversalNumber = nv.getTraversalNumber();
+            if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= traversalNumber)
+                return;
+
+            mLod = Lod::Full;
+            for (std::size_t i = 0; i < sLodScreenSizes.size(); ++i)
+                if (mScreenSize < sLodScreenSizes[i])
+                    mLod = static_cast<Lod>(i + 1);
+
+            if (UpdateStage* stage = UpdateStage::get(nv))
+                stage->addSkeleton(mLod);
+
+            if (mLastFrameNumber != 0 && skipUpdate(traversalNumber))
+            {
+                if (!extrapolatePose(traversalNumber))
+                    mSkippedFrameNumber = traversalNumber;
                 return;
+            }
+            mLastUpdateFrameNumber = traversalNumber;
+
+            restorePose();
+
+            if (mLod == Lod::ReducedBones)
+                traverseWithoutDetailBones(nv);
+            else
+                osg::Group::traverse(nv);
+
+            if (mLod == Lod::ReducedRate || mLod == Lod::ReducedBones)
+                storePose(traversalNumber);
+
+            // Rig bounds are updated during the traversal, possibly before all bones were animated, so the bone
+            // matrices are computed again for skinning.
+            mNeedToUpdateBoneMatrices = true;
+            return;
+        }
+
+        if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
+        {
+            const unsigned int traversalNumber = nv.getTraversalNumber();
+            mLastCullFrameNumber = traversalNumber;
+            // The largest size among the perspective views of the frame, orthographic ones are for shadow maps.
+            osg::CullStack* cullStack = nv.asCullStack();
+            if (cullStack != nullptr && (*cullStack->getProjectionMatrix())(3, 3) == 0)
+            {
+                const float screenSize = cullStack->clampedPixelSize(getBound());
+                if (mScreenSizeFrameNumber != traversalNumber)
+                    mScreenSize = screenSize;
+                else
+                    mScreenSize = std::max(mScreenSize, screenSize);
+                mScreenSizeFrameNumber = traversalNumber;
+            }
         }
-        else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
-            mLastCullFrameNumber = nv.getTraversalNumber();
 
         osg::Group::traverse(nv);
     }
 
-    void Skeleton::childInserted(unsigned int)
+    bool Skeleton::skipUpdate(unsigned int traversalNumber) const
     {
-        markDirty();
+        switch (mLod)
+        {
+            case Lod::Full:
+                return false;
+            case Lod::ReducedRate:
+            case Lod::ReducedBones:
+                return traversalNumber < mLastUpdateFrameNumber + 2;
+            case Lod::Frozen:
+                return true;
+        }
+        return false;
     }
 
-    void Skeleton::childRemoved(unsigned int, unsigned int)
+    void Skeleton::storePose(unsigned int traversalNumber)
     {
-        markDirty();
+        if (!mNodesInit)
+            initNodes();
+
+        std::swap(mLastPose, mPreviousPose);
+        mLastPose.resize(mNodes.size());
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
+            mLastPose[i] = mNodes[i]->getMatrix();
+
+        mPreviousPoseFrameNumber = mLastPoseFrameNumber;
+        mLastPoseFrameNumber = traversalNumber;
+    }
+
+    bool Skeleton::extrapolatePose(unsigned int traversalNumber)
+    {
+        if (mLod != Lod::ReducedRate && mLod != Lod::ReducedBones)
+            return false;
+
+        // Only extrapolate from two consecutive updates at the reduced rate, a longer gap means the skeleton wasn't
+        // animated in between and the motion is unknown.
+        if (!mNodesInit || mPreviousPoseFrameNumber == 0 || mLastPoseFrameNumber != mLastUpdateFrameNumber
+            || mLastPoseFrameNumber > mPreviousPoseFrameNumber + 2 || mPreviousPose.size() != mNodes.size()
+            || mLastPose.size() != mNodes.size())
+            return false;
+
+        // The matrices are extrapolated component-wise. Rotations change little over a couple of frames, so this stays
+        // close to extrapolating the rotation itself and is much cheaper.
+        const float factor = static_cast<float>(traversalNumber - mLastPoseFrameNumber)
+            / static_cast<float>(mLastPoseFrameNumber - mPreviousPoseFrameNumber);
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
+        {
+            const float* last = mLastPose[i].ptr();
+            const float* previous = mPreviousPose[i].ptr();
+            osg::Matrixf matrix;
+            float* result = matrix.ptr();
+            for (std::size_t j = 0; j < 16; ++j)
+                result[j] = last[j] + (last[j] - previous[j]) * factor;
+            mNodes[i]->setMatrix(matrix);
+        }
+
+        mPoseExtrapolated = true;
+        mNeedToUpdateBoneMatrices = true;
+        return true;
     }
 
-    Bone::Bone()
-        : mNode(nullptr)
+    void Skeleton::restorePose()
     {
+        if (!mPoseExtrapolated)
+            return;
+
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
+            mNodes[i]->setMatrix(mLastPose[i]);
+
+        mPoseExtrapolated = false;
     }
 
-    void Bone::update(const osg::Matrixf* parentMatrixInSkeletonSpace)
+    void Skeleton::traverseWithoutDetailBones(osg::NodeVisitor& nv)
     {
-        if (!mNode)
+        if (!mDetailBonesInit)
         {
-            Log(Debug::Error) << "Error: Bone without node";
-            return;
+            InitDetailBonesVisitor visitor(mDetailBones);
+            osg::Group::traverse(visitor);
+            mDetailBonesInit = true;
         }
-        if (parentMatrixInSkeletonSpace)
-            mMatrixInSkeletonSpace = mNode->getMatrix() * (*parentMatrixInSkeletonSpace);
-        else
-            mMatrixInSkeletonSpace = mNode->getMatrix();
 
-        for (const auto& child : mChildren)
-            child->update(&mMatrixInSkeletonSpace);
+        // The update traversal runs before the cull traversal of the frame, so other traversals never see the masks.
+        for (auto& [node, mask] : mDetailBones)
+        {
+            mask = node->getNodeMask();
+            node->setNodeMask(0);
+        }
+        osg::Group::traverse(nv);
+        for (const auto& [node, mask] : mDetailBones)
+            node->setNodeMask(mask);
+    }
+
+    void Skeleton::childInserted(unsigned int)
+    {
+        markDirty();
+    }
+
+    void Skeleton::childRemoved(unsigned int, unsigned int)
+    {
+        markDirty();
     }
 
 }
@@ -2,33 +2,32 @@
 #define OPENMW_COMPONENTS_NIFOSG_SKELETON_H
 
 #include <osg/Group>
+#include <osg/Matrixf>
 
-#include <memory>
+#include <components/misc/strings/algorithm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
-namespace SceneUtil
+namespace osg
 {
+    class MatrixTransform;
+}
 
-    /// @brief Defines a Bone hierarchy, used for updating of skeleton-space bone matrices.
-    /// @note To prevent unnecessary updates, only bones that are used for skinning will be added to this hierarchy.
-    class Bone
-    {
-    public:
-        Bone();
-
-        osg::Matrixf mMatrixInSkeletonSpace;
-
-        osg::MatrixTransform* mNode;
-
-        std::vector<std::unique_ptr<Bone>> mChildren;
-
-        /// Update the skeleton-space matrix of this bone and all its children.
-        void update(const osg::Matrixf* parentMatrixInSkeletonSpace);
-    };
+namespace SceneUtil
+{
 
     /// @brief Handles the bone matrices for any number of child RigGeometries.
     /// @par Bones should be created as osg::MatrixTransform children of the skeleton.
     /// To be a referenced by a RigGeometry, a bone needs to have a unique name.
+    /// @par Only bones used for skinning and their parents are updated. They are stored in flat arrays sorted so that
+    /// parents come before their children, so the skeleton-space matrices are computed in one pass over the arrays.
     class Skeleton : public osg::Group
     {
     public:
@@ -37,8 +36,14 @@ namespace SceneUtil
 
         META_Node(SceneUtil, Skeleton)
 
-        /// Retrieve a bone by name.
-        Bone* getBone(const std::string& name);
+        static constexpr std::size_t sNoBone = std::numeric_limits<std::size_t>::max();
+
+        /// Retrieve the index of a bone by name, sNoBone if there is none. Adds the bone to the updated ones.
+        /// @note Indices stay valid for the lifetime of the skeleton.
+        std::size_t getBone(std::string_view name);
+
+        /// Skeleton-space matrix of the bone as of the last updateBoneMatrices.
+        const osg::Matrixf& getBoneMatrix(std::size_t bone) const { return mBoneMatrices[bone]; }
 
         /// Request an update of bone matrices. May be a no-op if already updated in this frame.
         void updateBoneMatrices(unsigned int traversalNumber);
@@ -56,6 +61,29 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// @brief Animation level of detail, chosen from the size of the skeleton on screen in the last frame.
+        /// @note Only the scene graph update is affected, the animation state is advanced elsewhere at full rate, so
+        /// the bones always take the pose of the current animation time when they are updated.
+        enum class Lod
+        {
+            Full,
+            ReducedRate, /// Bones are updated every other frame, the pose of skipped frames is extrapolated
+            ReducedBones, /// Like ReducedRate, but detail bones (fingers, toes, face) keep their pose
+            Frozen, /// Bones keep their pose
+        };
+
+        static constexpr std::size_t sLodCount = 4;
+
+        /// Set the screen sizes in pixels below which skeletons use a lower LOD, in the order of the Lod values
+        /// starting with ReducedRate. 0 disables the LOD.
+        static void setLodScreenSizes(const std::array<float, sLodCount - 1>& sizes);
+
+        Lod getLod() const { return mLod; }
+
+        /// Returns true if the LOD skipped the update of the frame without extrapolating the pose, so the bone matrices
+        /// are the same as before.
+        bool isPoseUnchanged(unsigned int traversalNumber) const { return mSkippedFrameNumber == traversalNumber; }
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -64,13 +92,19 @@ namespace SceneUtil
         void childRemoved(unsigned int, unsigned int) override;
 
     private:
-        // The root bone is not a "real" bone, it has no corresponding node in the scene graph.
-        // As far as the scene graph goes we support multiple root bones.
-        std::unique_ptr<Bone> mRootBone;
-
-        typedef std::unordered_map<std::string, std::vector<osg::MatrixTransform*>> BoneCache;
-        BoneCache mBoneCache;
-        bool mBoneCacheInit;
+        // All transforms below the skeleton in depth-first order with the index of their parent transform, looked up
+        // by name. Built on first use, as a skeleton is cloned from its template before it's used.
+        std::vector<osg::MatrixTransform*> mNodes;
+        std::vector<std::size_t> mNodeParents;
+        std::vector<std::size_t> mNodeBones;
+        std::unordered_map<std::string, std::size_t, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> mNodeByName;
+        bool mNodesInit;
+
+        // Updated bones, parents come before their children. As far as the scene graph goes we support multiple root
+        // bones, they have no parent.
+        std::vector<osg::MatrixTransform*> mBoneNodes;
+        std::vector<std::size_t> mBoneParents;
+        std::vector<osg::Matrixf> mBoneMatrices;
 
         bool mNeedToUpdateBoneMatrices;
 
@@ -78,6 +112,36 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        Lod mLod;
+        float mScreenSize;
+        unsigned int mScreenSizeFrameNumber;
+        unsigned int mLastUpdateFrameNumber;
+        unsigned int mSkippedFrameNumber;
+
+        // Matrices of mNodes after the last two updates using a reduced rate LOD, to extrapolate the pose in the frames
+        // in between.
+        std::vector<osg::Matrixf> mLastPose;
+        std::vector<osg::Matrixf> mPreviousPose;
+        unsigned int mLastPoseFrameNumber;
+        unsigned int mPreviousPoseFrameNumber;
+        // The matrices of mNodes are extrapolated and need to be reset to mLastPose before the next update, as
+        // controllers may only set a part of them.
+        bool mPoseExtrapolated;
+
+        // Topmost detail bones with the node masks to restore after the update traversal.
+        std::vector<std::pair<osg::Node*, osg::Node::NodeMask>> mDetailBones;
+        bool mDetailBonesInit;
+
+        static std::array<float, sLodCount - 1> sLodScreenSizes;
+
+        void initNodes();
+        std::size_t addBone(std::size_t node);
+        bool skipUpdate(unsigned int traversalNumber) const;
+        void storePose(unsigned int traversalNumber);
+        bool extrapolatePose(unsigned int traversalNumber);
+        void restorePose();
+        void traverseWithoutDetailBones(osg::NodeVisitor& nv);
     };
 
 }
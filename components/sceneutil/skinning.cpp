@@ -0,0 +1,62 @@
+#include "skinning.hpp"
+
+#include <algorithm>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        template <bool withTranslation>
+        void skin(const float* matrix, ConstSkinningStream source, std::size_t count, SkinningStream result)
+        {
+            const float* const x = source[0];
+            const float* const y = source[1];
+            const float* const z = source[2];
+            // One loop per result component: with a single output array the compiler needs only a few runtime alias
+            // checks to vectorize it, with three outputs it gives up.
+            for (std::size_t component = 0; component < 3; ++component)
+            {
+                const float mx = matrix[component];
+                const float my = matrix[4 + component];
+                const float mz = matrix[8 + component];
+                const float mw = matrix[12 + component];
+                float* const out = result[component];
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if constexpr (withTranslation)
+                        out[i] = x[i] * mx + y[i] * my + z[i] * mz + mw;
+                    else
+                        out[i] = x[i] * mx + y[i] * my + z[i] * mz;
+                }
+            }
+        }
+    }
+
+    void blendSkinningMatrices(
+        const float* matrices, const std::size_t* indices, const float* weights, std::size_t count, float* result)
+    {
+        float sum[16] = {};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float* const matrix = matrices + indices[i] * 16;
+            const float weight = weights[i];
+            for (std::size_t j = 0; j < 16; ++j)
+                sum[j] += matrix[j] * weight;
+        }
+        sum[3] = 0;
+        sum[7] = 0;
+        sum[11] = 0;
+        sum[15] = 1;
+        std::copy(sum, sum + 16, result);
+    }
+
+    void skinPositions(const float* matrix, ConstSkinningStream source, std::size_t count, SkinningStream result)
+    {
+        skin<true>(matrix, source, count, result);
+    }
+
+    void skinDirections(const float* matrix, ConstSkinningStream source, std::size_t count, SkinningStream result)
+    {
+        skin<false>(matrix, source, count, result);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <array>
+#include <cstddef>
+
+namespace SceneUtil
+{
+    // Vertex components stored in separate arrays (x, y, z), so the same operation applies to consecutive floats.
+    using SkinningStream = std::array<float*, 3>;
+    using ConstSkinningStream = std::array<const float*, 3>;
+
+    // Kernels used by RigGeometry. The matrix has the osg::Matrixf layout: 16 floats, row major, vectors are
+    // multiplied as rows, so translation is in the last row. The loops are written to be vectorized by the compiler
+    // with the instruction set the build targets (SSE2 or AVX2 on x86-64, NEON on AArch64).
+
+    // Sets `result` to the sum of `matrices[indices[i]] * weights[i]` with the last column set to (0, 0, 0, 1).
+    void blendSkinningMatrices(const float* matrices, const std::size_t* indices, const float* weights,
+        std::size_t count, float* result);
+
+    void skinPositions(const float* matrix, ConstSkinningStream source, std::size_t count, SkinningStream result);
+
+    // Applies only the 3x3 part of the matrix.
+    void skinDirections(const float* matrix, ConstSkinningStream source, std::size_t count, SkinningStream result);
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "updatestage.hpp"
+
+#include <osg/NodeVisitor>
+
+#include <osgParticle/ParticleSystem>
+
+#include "morphgeometry.hpp"
+#include "riggeometry.hpp"
+#include "workqueue.hpp"
+
+#include <algorithm>
+
+namespace SceneUtil
+{
+    class UpdateStage::Item : public WorkItem
+    {
+    public:
+        Item(UpdateStage& stage, unsigned int frameNumber)
+            : mStage(stage)
+            , mFrameNumber(frameNumber)
+        {
+        }
+
+        void doWork() override { mStage.process(mFrameNumber); }
+
+    private:
+        UpdateStage& mStage;
+        const unsigned int mFrameNumber;
+    };
+
+    UpdateStage::UpdateStage(std::size_t workerThreads)
+        : mWorkerThreads(workerThreads)
+    {
+        if (workerThreads > 0)
+            mWorkQueue = new WorkQueue(workerThreads);
+    }
+
+    UpdateStage::~UpdateStage() = default;
+
+    void UpdateStage::add(RigGeometry& rig)
+    {
+        mRigs.emplace_back(&rig);
+    }
+
+    void UpdateStage::add(MorphGeometry& morph)
+    {
+        mMorphs.emplace_back(&morph);
+    }
+
+    void UpdateStage::add(osgParticle::ParticleSystem& system, double dt, UpdateParticles update)
+    {
+        mParticleSystems.push_back({ &system, dt, update });
+    }
+
+    UpdateStage* UpdateStage::get(osg::NodeVisitor& visitor)
+    {
+        if (UpdateStageVisitor* updateStageVisitor = dynamic_cast<UpdateStageVisitor*>(&visitor))
+            return &updateStageVisitor->getStage();
+        return nullptr;
+    }
+
+    void UpdateStage::run(osg::NodeVisitor& visitor)
+    {
+        const unsigned int frameNumber = visitor.getTraversalNumber();
+
+        mLastSkeletonCounts = mSkeletonCounts;
+        mSkeletonCounts.fill(0);
+
+        mLastCount = mRigs.size() + mMorphs.size();
+        mLastParticleSystemCount = mParticleSystems.size();
+        const std::size_t tasks = mLastCount + mLastParticleSystemCount;
+        if (tasks == 0)
+            return;
+
+        // Bone matrices are shared by all rigs of the skeleton, so they are updated before going to the worker threads
+        for (const osg::ref_ptr<RigGeometry>& rig : mRigs)
+            rig->updateBoneMatrices(frameNumber);
+
+        mNext = 0;
+        // Every drawable and particle system is a separate task taken by whichever thread is free, the calling thread
+        // works too.
+        std::vector<osg::ref_ptr<Item>> items;
+        if (mWorkQueue != nullptr && tasks > 1)
+        {
+            const std::size_t count = std::min(mWorkerThreads, tasks - 1);
+            items.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                items.push_back(new Item(*this, frameNumber));
+                mWorkQueue->addWorkItem(items.back(), true);
+            }
+        }
+
+        process(frameNumber);
+
+        for (const osg::ref_ptr<Item>& item : items)
+            item->waitTillDone();
+
+        // Dirtying the bound goes up to the parents, which may be shared with other particle systems.
+        for (const ParticleSystemUpdate& update : mParticleSystems)
+            update.mSystem->dirtyBound();
+
+        mRigs.clear();
+        mMorphs.clear();
+        mParticleSystems.clear();
+    }
+
+    void UpdateStage::process(unsigned int frameNumber)
+    {
+        while (true)
+        {
+            const std::size_t index = mNext.fetch_add(1, std::memory_order_relaxed);
+            if (index < mRigs.size())
+                mRigs[index]->deform(frameNumber);
+            else if (index < mRigs.size() + mMorphs.size())
+                mMorphs[index - mRigs.size()]->deform(frameNumber);
+            else if (index < mRigs.size() + mMorphs.size() + mParticleSystems.size())
+            {
+                const ParticleSystemUpdate& update = mParticleSystems[index - mRigs.size() - mMorphs.size()];
+                // The draw thread reads the particles under the read lock.
+                osgParticle::ParticleSystem::ScopedWriteLock lock(*update.mSystem->getReadWriteMutex());
+                update.mUpdate(*update.mSystem, update.mDt);
+            }
+            else
+                return;
+        }
+    }
+}
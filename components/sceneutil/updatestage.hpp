@@ -0,0 +1,116 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_UPDATESTAGE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_UPDATESTAGE_H
+
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <osgUtil/UpdateVisitor>
+
+#include "skeleton.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace osgParticle
+{
+    class ParticleSystem;
+}
+
+namespace SceneUtil
+{
+    class MorphGeometry;
+    class RigGeometry;
+    class WorkQueue;
+
+    /// @brief Skins and morphs drawables and simulates particle systems ahead of the cull traversal using worker
+    /// threads.
+    /// @par Drawables that were culled recently schedule themselves while the update traversal visits them. After the
+    /// update traversal run() updates the bone matrices of their skeletons on the calling thread, as the bones may be
+    /// animated anywhere in the traversal, then processes all of the drawables in parallel. The cull traversal then
+    /// only picks the prepared geometry, drawables that weren't scheduled are still deformed during cull.
+    /// @par Particle systems are independent of each other once their emitters and programs ran, so their per particle
+    /// update is deferred to run() as well. The workers only touch the particles, the bounds of the systems and their
+    /// parents are dirtied on the calling thread once the workers are done.
+    /// @par Skeletons visited by the update traversal are counted by their animation LOD for statistics.
+    class UpdateStage : public osg::Referenced
+    {
+    public:
+        /// @param workerThreads Number of threads in addition to the calling thread.
+        explicit UpdateStage(std::size_t workerThreads);
+
+        ~UpdateStage();
+
+        /// Returns the stage of the UpdateStageVisitor or nullptr for other visitors.
+        static UpdateStage* get(osg::NodeVisitor& visitor);
+
+        void add(RigGeometry& rig);
+
+        void add(MorphGeometry& morph);
+
+        /// Updates the particles of the system, called from a worker thread under the write lock of the system.
+        /// Shouldn't touch the scene graph, e.g. by dirtying the bound.
+        using UpdateParticles = void (*)(osgParticle::ParticleSystem& system, double dt);
+
+        void add(osgParticle::ParticleSystem& system, double dt, UpdateParticles update);
+
+        void addSkeleton(Skeleton::Lod lod) { ++mSkeletonCounts[static_cast<std::size_t>(lod)]; }
+
+        /// Processes everything scheduled by the update traversal of the visitor and clears the schedule. Blocks until
+        /// done.
+        void run(osg::NodeVisitor& visitor);
+
+        /// Number of drawables deformed by the last run.
+        std::size_t getLastCount() const { return mLastCount; }
+
+        /// Number of particle systems updated by the last run.
+        std::size_t getLastParticleSystemCount() const { return mLastParticleSystemCount; }
+
+        /// Number of skeletons with the LOD counted before the last run.
+        std::size_t getLastSkeletonCount(Skeleton::Lod lod) const
+        {
+            return mLastSkeletonCounts[static_cast<std::size_t>(lod)];
+        }
+
+    private:
+        class Item;
+
+        struct ParticleSystemUpdate
+        {
+            osg::ref_ptr<osgParticle::ParticleSystem> mSystem;
+            double mDt;
+            UpdateParticles mUpdate;
+        };
+
+        osg::ref_ptr<WorkQueue> mWorkQueue;
+        std::size_t mWorkerThreads;
+        std::vector<osg::ref_ptr<RigGeometry>> mRigs;
+        std::vector<osg::ref_ptr<MorphGeometry>> mMorphs;
+        std::vector<ParticleSystemUpdate> mParticleSystems;
+        std::atomic<std::size_t> mNext{ 0 };
+        std::size_t mLastCount = 0;
+        std::size_t mLastParticleSystemCount = 0;
+        std::array<std::size_t, Skeleton::sLodCount> mSkeletonCounts{};
+        std::array<std::size_t, Skeleton::sLodCount> mLastSkeletonCounts{};
+
+        void process(unsigned int frameNumber);
+    };
+
+    /// @brief Update visitor through which the traversed drawables schedule themselves on the stage.
+    class UpdateStageVisitor : public osgUtil::UpdateVisitor
+    {
+    public:
+        explicit UpdateStageVisitor(UpdateStage& stage)
+            : mStage(&stage)
+        {
+        }
+
+        UpdateStage& getStage() const { return *mStage; }
+
+    private:
+        osg::ref_ptr<UpdateStage> mStage;
+    };
+}
+
+#endif
@@ -2,10 +2,65 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <memory>
 #include <numeric>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        struct ParallelRun
+        {
+            // Only called for taken indices, so the caller waits for every call and keeps the function alive.
+            const std::function<void(std::size_t)>* mFunction;
+            std::size_t mCount;
+            std::atomic<std::size_t> mNext{ 0 };
+            std::size_t mDone = 0;
+            std::exception_ptr mError;
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+
+            void process()
+            {
+                while (true)
+                {
+                    const std::size_t index = mNext.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= mCount)
+                        return;
+                    std::exception_ptr error;
+                    try
+                    {
+                        (*mFunction)(index);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                    const std::lock_guard lock(mMutex);
+                    if (error != nullptr && mError == nullptr)
+                        mError = error;
+                    if (++mDone == mCount)
+                        mCondition.notify_all();
+                }
+            }
+        };
+
+        class ParallelRunItem : public WorkItem
+        {
+        public:
+            explicit ParallelRunItem(std::shared_ptr<ParallelRun> run)
+                : mRun(std::move(run))
+            {
+            }
+
+            void doWork() override { mRun->process(); }
+
+        private:
+            const std::shared_ptr<ParallelRun> mRun;
+        };
+    }
 
     void WorkItem::waitTillDone()
     {
@@ -142,4 +197,25 @@ namespace SceneUtil
         return mActive;
     }
 
+    void runInParallel(WorkQueue* workQueue, std::size_t count, const std::function<void(std::size_t)>& function)
+    {
+        const auto run = std::make_shared<ParallelRun>();
+        run->mFunction = &function;
+        run->mCount = count;
+
+        if (workQueue != nullptr && count > 1)
+        {
+            const std::size_t helpers = std::min(workQueue->getNumThreads(), count - 1);
+            for (std::size_t i = 0; i < helpers; ++i)
+                workQueue->addWorkItem(new ParallelRunItem(run), true);
+        }
+
+        run->process();
+
+        std::unique_lock lock(run->mMutex);
+        run->mCondition.wait(lock, [&] { return run->mDone == run->mCount; });
+        if (run->mError != nullptr)
+            std::rethrow_exception(run->mError);
+    }
+
 }
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -66,6 +67,8 @@ namespace SceneUtil
 
         size_t getNumActiveThreads() const;
 
+        std::size_t getNumThreads() const { return mThreads.size(); }
+
     private:
         bool mIsReleased;
         std::deque<osg::ref_ptr<WorkItem>> mQueue;
@@ -94,6 +97,13 @@ namespace SceneUtil
         void run();
     };
 
+    /// Calls function(i) for every i < count on the calling thread and the threads of the work queue, returns when all
+    /// calls are done. Rethrows the first exception thrown by a call.
+    /// @par The queue threads only help: work items which start after everything was taken return right away, so
+    /// this may be called from a work item of the same queue without waiting for other items.
+    /// @param workQueue May be nullptr to do everything on the calling thread.
+    void runInParallel(WorkQueue* workQueue, std::size_t count, const std::function<void(std::size_t)>& function);
+
 }
 
 #endif
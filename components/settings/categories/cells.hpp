@@ -25,6 +25,7 @@ namespace Settings
         SettingValue<bool> mPreloadDoors{ mIndex, "Cells", "preload doors" };
         SettingValue<float> mPreloadDistance{ mIndex, "Cells", "preload distance", makeMaxStrictSanitizerFloat(0) };
         SettingValue<bool> mPreloadInstances{ mIndex, "Cells", "preload instances" };
+        SettingValue<bool> mPreloadReferences{ mIndex, "Cells", "preload references" };
         SettingValue<int> mPreloadCellCacheMin{ mIndex, "Cells", "preload cell cache min", makeMaxSanitizerInt(1) };
         SettingValue<int> mPreloadCellCacheMax{ mIndex, "Cells", "preload cell cache max", makeMaxSanitizerInt(1) };
         SettingValue<float> mPreloadCellExpiryDelay{ mIndex, "Cells", "preload cell expiry delay",
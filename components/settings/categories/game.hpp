@@ -40,6 +40,13 @@ namespace Settings
         SettingValue<bool> mRebalanceSoulGemValues{ mIndex, "Game", "rebalance soul gem values" };
         SettingValue<bool> mUseAdditionalAnimSources{ mIndex, "Game", "use additional anim sources" };
         SettingValue<bool> mSmoothAnimTransitions{ mIndex, "Game", "smooth animation transitions" };
+        SettingValue<float> mAnimationLodReducedRateSize{ mIndex, "Game", "animation lod reduced rate size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAnimationLodReducedBonesSize{ mIndex, "Game", "animation lod reduced bones size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAnimationLodFrozenSize{ mIndex, "Game", "animation lod frozen size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAnimationBakingRate{ mIndex, "Game", "animation baking rate", makeMaxSanitizerFloat(0) };
         SettingValue<bool> mBarterDispositionChangeIsPermanent{ mIndex, "Game",
             "barter disposition change is permanent" };
         SettingValue<int> mStrengthInfluencesHandToHand{ mIndex, "Game", "strength influences hand to hand",
@@ -32,6 +32,8 @@ namespace Settings
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<int> mUpdateStageNumThreads{ mIndex, "General", "update stage num threads",
+            makeMaxSanitizerInt(0) };
     };
 }
 
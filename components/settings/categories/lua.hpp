@@ -27,6 +27,12 @@ namespace Settings
         SettingValue<std::uint64_t> mInstructionLimitPerCall{ mIndex, "Lua", "instruction limit per call",
             makeMaxSanitizerUInt64(1001) };
         SettingValue<int> mGcStepsPerFrame{ mIndex, "Lua", "gc steps per frame", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mBytecodeCache{ mIndex, "Lua", "bytecode cache" };
+        SettingValue<std::uint64_t> mUpdateInstructionBudgetPerScript{ mIndex, "Lua",
+            "update instruction budget per script" };
+        SettingValue<float> mUpdateTimeBudget{ mIndex, "Lua", "update time budget", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mMaxDeferredUpdateFrames{ mIndex, "Lua", "max deferred update frames",
+            makeMaxSanitizerInt(0) };
     };
 }
 
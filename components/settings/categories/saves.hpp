@@ -21,6 +21,9 @@ namespace Settings
         SettingValue<std::string> mCharacter{ mIndex, "Saves", "character" };
         SettingValue<bool> mAutosave{ mIndex, "Saves", "autosave" };
         SettingValue<int> mMaxQuicksaves{ mIndex, "Saves", "max quicksaves", makeMaxSanitizerInt(1) };
+        SettingValue<bool> mAsyncWrite{ mIndex, "Saves", "async write" };
+        SettingValue<bool> mCompression{ mIndex, "Saves", "compression" };
+        SettingValue<bool> mReuseUnchangedCells{ mIndex, "Saves", "reuse unchanged cells" };
     };
 }
 
@@ -37,7 +37,9 @@ namespace Settings
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mObjectPagingCache{ mIndex, "Terrain", "object paging cache" };
         SettingValue<bool> mWaterCulling{ mIndex, "Terrain", "water culling" };
+        SettingValue<bool> mOcclusionCulling{ mIndex, "Terrain", "occlusion culling" };
     };
 }
 
@@ -54,6 +54,8 @@ namespace Shader
             , mUniforms(rhs.mUniforms)
             , mModes(rhs.mModes)
             , mAttributes(rhs.mAttributes)
+            , mTextureAttributes(rhs.mTextureAttributes)
+            , mShaderPrefix(rhs.mShaderPrefix)
         {
         }
 
@@ -106,11 +108,16 @@ namespace Shader
             return hasAttribute(osg::StateAttribute::TypeMemberPair(type, member));
         }
 
+        void setShaderPrefix(const std::string& shaderPrefix) { mShaderPrefix = shaderPrefix; }
+
+        const std::unordered_set<std::string>& getUniforms() { return mUniforms; }
+        const std::unordered_set<osg::StateAttribute::GLMode>& getModes() { return mModes; }
         const std::set<osg::StateAttribute::TypeMemberPair>& getAttributes() { return mAttributes; }
         const std::unordered_map<unsigned int, std::set<osg::StateAttribute::TypeMemberPair>>& getTextureAttributes()
         {
             return mTextureAttributes;
         }
+        const std::string& getShaderPrefix() { return mShaderPrefix; }
 
         bool empty()
         {
@@ -141,6 +148,7 @@ namespace Shader
         ModeSet mModes;
         AttributeSet mAttributes;
         std::unordered_map<unsigned int, AttributeSet> mTextureAttributes;
+        std::string mShaderPrefix;
     };
 
     ShaderVisitor::ShaderRequirements::ShaderRequirements()
@@ -699,6 +707,7 @@ namespace Shader
         auto program = mShaderManager.getProgram(shaderPrefix, defineMap, mProgramTemplate);
         writableStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
         addedState->setAttributeAndModes(std::move(program));
+        addedState->setShaderPrefix(shaderPrefix);
 
         for (const auto& [unit, name] : reqs.mTextures)
         {
@@ -919,4 +928,42 @@ namespace Shader
         traverse(node);
     }
 
+    std::string removeShaderState(osg::StateSet& stateSet)
+    {
+        osg::UserDataContainer* userData = stateSet.getUserDataContainer();
+        if (userData == nullptr)
+            return {};
+
+        std::string shaderPrefix;
+        if (const osg::ref_ptr<AddedState> addedState = getAddedState(stateSet))
+        {
+            for (const std::string& name : addedState->getUniforms())
+                stateSet.removeUniform(name);
+            for (const osg::StateAttribute::GLMode mode : addedState->getModes())
+                stateSet.removeMode(mode);
+            for (const auto& [type, member] : addedState->getAttributes())
+                stateSet.removeAttribute(type, member);
+            for (const auto& [unit, attributes] : addedState->getTextureAttributes())
+                for (const auto& [type, member] : attributes)
+                    stateSet.removeTextureAttribute(unit, type);
+            shaderPrefix = addedState->getShaderPrefix();
+            userData->removeUserObject(userData->getUserObjectIndex("addedState"));
+        }
+
+        if (const osg::ref_ptr<osg::StateSet> removedState = getRemovedState(stateSet))
+        {
+            for (const auto& [mode, value] : removedState->getModeList())
+                stateSet.setMode(mode, value);
+            for (const auto& [type, attribute] : removedState->getAttributeList())
+                stateSet.setAttribute(attribute.first, attribute.second);
+            userData->removeUserObject(userData->getUserObjectIndex("removedState"));
+        }
+
+        if (userData->getNumUserObjects() == 0 && userData->getNumDescriptions() == 0
+            && userData->getUserData() == nullptr)
+            stateSet.setUserDataContainer(nullptr);
+
+        return shaderPrefix;
+    }
+
 }
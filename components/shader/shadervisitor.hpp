@@ -130,6 +130,12 @@ namespace Shader
         bool mAllowedToModifyStateSets;
     };
 
+    /// Removes the state added by ShaderVisitor, including the program, and reinstates the state it removed, so the
+    /// ShaderVisitor can create the shaders again from scratch. Unlike ReinstateRemovedStateVisitor, modifies the
+    /// state set and its user data in place, both must not be shared with a live subgraph.
+    /// @return shader prefix the program was created with, empty if the ShaderVisitor created none.
+    std::string removeShaderState(osg::StateSet& stateSet);
+
 }
 
 #endif
@@ -10,6 +10,7 @@
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/occlusionbuffer.hpp>
 
 #include "compositemaprenderer.hpp"
 #include "material.hpp"
@@ -19,6 +20,11 @@
 
 namespace Terrain
 {
+    namespace
+    {
+        // Quads along each side of the occluder of a chunk, distant chunks are large but cover few pixels.
+        constexpr std::size_t occluderResolution = 4;
+    }
 
     struct UpdateTextureFilteringFunctor
     {
@@ -255,6 +261,10 @@ namespace Terrain
 
         geometry->addPrimitiveSet(mBufferCache.getIndexBuffer(numVerts, lodFlags));
 
+        const osg::Vec3Array& positions = static_cast<const osg::Vec3Array&>(*geometry->getVertexArray());
+        geometry->getOrCreateUserDataContainer()->addUserObject(
+            SceneUtil::createHeightfieldOccluder(positions.asVector(), numVerts, occluderResolution));
+
         bool useCompositeMap = chunkSize >= mCompositeMapLevel;
         unsigned int numUvSets = useCompositeMap ? 1 : 2;
 
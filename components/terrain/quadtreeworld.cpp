@@ -1,17 +1,20 @@
 #include "quadtreeworld.hpp"
 
+#include <osg/ComputeBoundsVisitor>
 #include <osg/Material>
 #include <osg/PolygonMode>
 #include <osg/ShapeDrawable>
 #include <osgUtil/CullVisitor>
 
 #include <limits>
+#include <utility>
 
 #include <components/esm/util.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/mathutil.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/occlusionbuffer.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 
 #include "chunkmanager.hpp"
@@ -403,7 +406,58 @@ namespace Terrain
                     pat->addChild(n);
             }
             entry.mRenderingNode = pat;
+
+            if (mOcclusionCulling)
+            {
+                osg::ComputeBoundsVisitor computeBounds;
+                pat->accept(computeBounds);
+                entry.mBoundingBox = computeBounds.getBoundingBox();
+            }
+        }
+    }
+
+    SceneUtil::OcclusionBuffer* QuadTreeWorld::rasterizeOccluders(
+        ViewData& vd, osgUtil::CullVisitor& cv, const osg::Matrixf& viewProjection)
+    {
+        // Other cameras, like the ones of reflections and shadow maps, see the scene from elsewhere and would need
+        // their own buffer
+        if (cv.getCurrentCamera() == nullptr || cv.getCurrentCamera()->getName() != Constants::SceneCamera)
+            return nullptr;
+
+        // Depth in the buffer is the distance along the view direction, which orthographic projections don't have
+        if ((*cv.getProjectionMatrix())(3, 3) != 0)
+            return nullptr;
+
+        // Occluders of the terrain lie below its surface, so they only hide what the terrain hides when seen from
+        // above
+        const osg::Vec3f eyePoint = cv.getEyePoint();
+        if (eyePoint.z() < getHeightAt(eyePoint))
+            return nullptr;
+
+        SceneUtil::OcclusionBuffer& buffer = vd.getOcclusionBuffer();
+        buffer.clear();
+
+        for (unsigned int i = 0; i < vd.getNumEntries(); ++i)
+        {
+            const ViewDataEntry& entry = vd.getEntry(i);
+            if (!entry.mBoundingBox.valid() || cv.isCulled(entry.mBoundingBox))
+                continue;
+
+            const auto& pat = static_cast<const SceneUtil::PositionAttitudeTransform&>(*entry.mRenderingNode);
+            const osg::Matrixf modelViewProjection = osg::Matrixf::translate(pat.getPosition()) * viewProjection;
+            for (unsigned int j = 0; j < pat.getNumChildren(); ++j)
+            {
+                const osg::Node& child = *pat.getChild(j);
+                if (!cv.validNodeMask(child))
+                    continue;
+                SceneUtil::forEachOccluder(child, [&](const SceneUtil::Occluder& occluder) {
+                    buffer.addOccluder(occluder, modelViewProjection);
+                });
+            }
         }
+
+        buffer.resolve();
+        return &buffer;
     }
 
     namespace
@@ -490,13 +544,41 @@ namespace Terrain
 
         const float cellWorldSize = static_cast<float>(ESM::getCellSize(mWorldspace));
 
+        for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
+            loadRenderingNode(vd->getEntry(i), vd, cellWorldSize, mActiveGrid, false);
+
+        osg::Matrixf viewProjection;
+        SceneUtil::OcclusionBuffer* occlusionBuffer = nullptr;
+        std::chrono::steady_clock::duration occlusionTime{};
+        if (isCullVisitor && mOcclusionCulling)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            osgUtil::CullVisitor& cv = static_cast<osgUtil::CullVisitor&>(nv);
+            viewProjection = osg::Matrixf(*cv.getModelViewMatrix() * *cv.getProjectionMatrix());
+            occlusionBuffer = rasterizeOccluders(*vd, cv, viewProjection);
+            occlusionTime = std::chrono::steady_clock::now() - start;
+        }
+
+        std::size_t occludedChunks = 0;
         for (unsigned int i = 0; i < vd->getNumEntries(); ++i)
         {
             ViewDataEntry& entry = vd->getEntry(i);
-            loadRenderingNode(entry, vd, cellWorldSize, mActiveGrid, false);
+            if (occlusionBuffer != nullptr && occlusionBuffer->isOccluded(entry.mBoundingBox, viewProjection))
+            {
+                ++occludedChunks;
+                continue;
+            }
             entry.mRenderingNode->accept(nv);
         }
 
+        if (occlusionBuffer != nullptr)
+        {
+            const std::lock_guard lock(mOcclusionStatsMutex);
+            mOcclusionStats.mTriangles += occlusionBuffer->getTriangleCount();
+            mOcclusionStats.mOccludedChunks += occludedChunks;
+            mOcclusionStats.mRasterizeTime += occlusionTime;
+        }
+
         if (mHeightCullCallback && isCullVisitor)
             updateWaterCullingView(mHeightCullCallback, vd, static_cast<osgUtil::CullVisitor*>(&nv),
                 mStorage->getCellWorldSize(mWorldspace), !isGridEmpty());
@@ -571,6 +653,20 @@ namespace Terrain
         if (mCompositeMapRenderer)
             stats->setAttribute(
                 frameNumber, "Composite", static_cast<double>(mCompositeMapRenderer->getCompileSetSize()));
+
+        if (!mOcclusionCulling)
+            return;
+
+        OcclusionStats occlusionStats;
+        {
+            const std::lock_guard lock(mOcclusionStatsMutex);
+            occlusionStats = std::exchange(mOcclusionStats, OcclusionStats{});
+        }
+        stats->setAttribute(frameNumber, "Terrain Occluder Triangles", static_cast<double>(occlusionStats.mTriangles));
+        stats->setAttribute(
+            frameNumber, "Terrain Occluded Chunks", static_cast<double>(occlusionStats.mOccludedChunks));
+        stats->setAttribute(frameNumber, "Terrain Occluder Rasterize Time",
+            std::chrono::duration<double, std::milli>(occlusionStats.mRasterizeTime).count());
     }
 
     void QuadTreeWorld::loadCell(int x, int y)
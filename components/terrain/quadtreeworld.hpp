@@ -4,6 +4,8 @@
 #include "terraingrid.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
@@ -13,9 +15,20 @@ namespace osg
 {
     class NodeVisitor;
     class Group;
+    class Matrixf;
     class Stats;
 }
 
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
+namespace SceneUtil
+{
+    class OcclusionBuffer;
+}
+
 namespace Terrain
 {
     class RootNode;
@@ -87,10 +100,24 @@ namespace Terrain
         };
         void addChunkManager(ChunkManager*);
 
+        /// Skips the chunks hidden behind the occluders of the chunks in front of them, for the cull visitors of the
+        /// scene camera.
+        void setOcclusionCulling(bool enabled) { mOcclusionCulling = enabled; }
+
     private:
+        struct OcclusionStats
+        {
+            std::size_t mTriangles = 0;
+            std::size_t mOccludedChunks = 0;
+            std::chrono::steady_clock::duration mRasterizeTime{};
+        };
+
         void ensureQuadTreeBuilt();
         void loadRenderingNode(
             ViewDataEntry& entry, ViewData* vd, float cellWorldSize, const osg::Vec4i& gridbounds, bool compile);
+        /// @return nullptr if occlusion culling does not apply to the cull visitor.
+        SceneUtil::OcclusionBuffer* rasterizeOccluders(
+            ViewData& vd, osgUtil::CullVisitor& cv, const osg::Matrixf& viewProjection);
 
         osg::ref_ptr<RootNode> mRootNode;
 
@@ -106,6 +133,9 @@ namespace Terrain
         float mMinSize;
         bool mDebugTerrainChunks;
         std::unique_ptr<DebugChunkManager> mDebugChunkManager;
+        bool mOcclusionCulling = false;
+        std::mutex mOcclusionStatsMutex;
+        OcclusionStats mOcclusionStats;
     };
 
 }
@@ -2,6 +2,8 @@
 
 #include "quadtreenode.hpp"
 
+#include <components/sceneutil/occlusionbuffer.hpp>
+
 #include <algorithm>
 
 namespace Terrain
@@ -107,6 +109,14 @@ namespace Terrain
         mNodes.erase(it);
     }
 
+    SceneUtil::OcclusionBuffer& ViewData::getOcclusionBuffer()
+    {
+        // Coarse enough to rasterize the occluders of every chunk in view each frame
+        if (mOcclusionBuffer == nullptr)
+            mOcclusionBuffer = std::make_unique<SceneUtil::OcclusionBuffer>(256, 128);
+        return *mOcclusionBuffer;
+    }
+
     ViewDataEntry::ViewDataEntry()
         : mNode(nullptr)
         , mLodFlags(0)
@@ -2,12 +2,19 @@
 #define OPENMW_COMPONENTS_TERRAIN_VIEWDATA_H
 
 #include <deque>
+#include <memory>
 #include <vector>
 
+#include <osg/BoundingBox>
 #include <osg/Node>
 
 #include "view.hpp"
 
+namespace SceneUtil
+{
+    class OcclusionBuffer;
+}
+
 namespace Terrain
 {
 
@@ -23,6 +30,8 @@ namespace Terrain
 
         unsigned int mLodFlags;
         osg::ref_ptr<osg::Node> mRenderingNode;
+        /// Bounds of mRenderingNode, only computed when occlusion culling is enabled.
+        osg::BoundingBox mBoundingBox;
     };
 
     class ViewData : public View
@@ -78,6 +87,9 @@ namespace Terrain
 
         void removeNodeFromIndex(const QuadTreeNode* node);
 
+        /// Occluders of the entries as seen by the viewer of this view in the last frame.
+        SceneUtil::OcclusionBuffer& getOcclusionBuffer();
+
     private:
         std::vector<ViewDataEntry> mEntries;
         std::vector<const QuadTreeNode*> mNodes;
@@ -88,6 +100,7 @@ namespace Terrain
         bool mHasViewPoint;
         osg::Vec4i mActiveGrid;
         unsigned int mWorldUpdateRevision;
+        std::unique_ptr<SceneUtil::OcclusionBuffer> mOcclusionBuffer;
     };
 
     class ViewDataMap : public osg::Referenced
@@ -52,6 +52,27 @@
 -- @param #string description human readable description of the save
 -- @param #string slotName name of the save slot
 
+---
+-- Save the state of the running game in memory, replacing the snapshot with the same name.
+-- A snapshot is an in-memory saved game: it is not written to disk, is not compressed, has no screenshot and is
+-- lost on exit. Unlike saved games, it also contains the global and the player storage sections with the
+-- `GameSession` life time, so restoring it returns them to the same state as well. Persistent storage sections are
+-- not affected by restoring a snapshot, like by loading a saved game.
+-- @function [parent=#menu] saveSnapshot
+-- @param #string name name of the snapshot
+
+---
+-- Restore the state of the game from a snapshot. The state is replaced at the end of the frame.
+-- Restoring works like loading a saved game: the current game is unloaded and the world is rebuilt from the snapshot,
+-- only reading the file is skipped.
+-- @function [parent=#menu] restoreSnapshot
+-- @param #string name name of the snapshot
+
+---
+-- Delete a snapshot
+-- @function [parent=#menu] deleteSnapshot
+-- @param #string name name of the snapshot
+
 ---
 -- @type SaveInfo
 -- @field #string description
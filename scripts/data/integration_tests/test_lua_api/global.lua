@@ -3,6 +3,7 @@ local core = require('openmw.core')
 local async = require('openmw.async')
 local util = require('openmw.util')
 local types = require('openmw.types')
+local storage = require('openmw.storage')
 local vfs = require('openmw.vfs')
 local world = require('openmw.world')
 local I = require('openmw.interfaces')
@@ -342,6 +343,33 @@ testing.registerGlobalTestStep('load while teleporting - teleport', function()
     landracer:teleport(player.cell, player.position)
 end)
 
+testing.registerGlobalTestStep('snapshot - init', function()
+    local player = initPlayer()
+    local section = storage.globalSection('SnapshotTest')
+    section:setLifeTime(storage.LIFE_TIME.GameSession)
+    section:set('value', 1)
+    storage.globalSection('SnapshotTestPersistent'):set('value', 1)
+    testing.expectEqualWithDelta(player.position.x, 4096, 1, 'incorrect position after teleporting')
+end)
+
+testing.registerGlobalTestStep('snapshot - change', function()
+    local player = world.players[1]
+    storage.globalSection('SnapshotTest'):set('value', 2)
+    storage.globalSection('SnapshotTestPersistent'):set('value', 2)
+    player:teleport('', util.vector3(8192, 4096, 1745), util.transform.identity)
+    coroutine.yield()
+    testing.expectEqualWithDelta(player.position.x, 8192, 1, 'incorrect position after teleporting')
+end)
+
+testing.registerGlobalTestStep('snapshot - check', function()
+    local player = world.players[1]
+    testing.expectEqual(storage.globalSection('SnapshotTest'):get('value'), 1, 'storage is not restored from the snapshot')
+    testing.expectEqual(storage.globalSection('SnapshotTestPersistent'):get('value'), 2,
+        'persistent storage is restored from the snapshot')
+    testing.expectEqualWithDelta(player.position.x, 4096, 1, 'position is not restored from the snapshot')
+    testing.expectEqualWithDelta(player.position.y, 4096, 1, 'position is not restored from the snapshot')
+end)
+
 testing.registerGlobalTest('world.setGameTimeScale should not accept nan', function()
     local nan = 0.0 / 0.0
     local ok, err = pcall(function() world.setGameTimeScale(nan) end)
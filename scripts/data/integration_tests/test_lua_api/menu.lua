@@ -58,6 +58,41 @@ testing.registerMenuTest('load while teleporting', function()
     menu.deleteGame(' - 1', 'load_while_teleporting.omwsave')
 end)
 
+testing.registerMenuTest('save and restore snapshot', function()
+    menu.newGame()
+    coroutine.yield()
+
+    testing.runGlobalTest('snapshot - init')
+
+    menu.saveSnapshot('test')
+
+    testing.runGlobalTest('snapshot - change')
+
+    menu.restoreSnapshot('test')
+    coroutine.yield()
+
+    testing.runGlobalTest('snapshot - check')
+
+    menu.deleteSnapshot('test')
+    local ok = pcall(function() menu.restoreSnapshot('test') end)
+    testing.expectEqual(ok, false, 'Deleted snapshot should not be restored')
+end)
+
+-- The durations are logged by the engine and summarized by integration_tests.py --benchmarks
+testing.registerMenuBenchmark('restore snapshot', function()
+    menu.newGame()
+    coroutine.yield()
+
+    testing.runGlobalTest('snapshot - init')
+
+    menu.saveSnapshot('benchmark')
+    for _ = 1, 1000 do
+        menu.restoreSnapshot('benchmark')
+        coroutine.yield()
+    end
+    menu.deleteSnapshot('benchmark')
+end)
+
 return {
     engineHandlers = {
         onFrame = testing.makeUpdateMenu(),
@@ -5,6 +5,7 @@ local M = {}
 
 local menuTestsOrder = {}
 local menuTests = {}
+local menuBenchmarksOrder = {}
 local discoveredTests = {}
 local setupGlobalTest = function() end
 
@@ -108,6 +109,11 @@ end
 function M.makeUpdateMenu()
     return makeTestCoroutine(function()
         local menu = require('openmw.menu')
+        if testConfig.benchmarks == true then
+            print('Running benchmarks...')
+            runTests(menuBenchmarksOrder)
+            return
+        end
         print('Discovering tests...')
         menu.newGame({bypass = true})
         coroutine.yield()
@@ -146,6 +152,11 @@ function M.registerMenuTest(name, fn)
     table.insert(menuTestsOrder, {name = name, fn = fn})
 end
 
+-- Benchmarks run only with --benchmarks, instead of the tests
+function M.registerMenuBenchmark(name, fn)
+    table.insert(menuBenchmarksOrder, {name = name, fn = fn})
+end
+
 function M.setSetupGlobalTest(fn)
     setupGlobalTest = fn
 end
@@ -3,7 +3,9 @@
 import argparse
 import datetime
 import os
+import re
 import shutil
+import statistics
 import subprocess
 import sys
 import time
@@ -33,6 +35,10 @@ parser.add_argument(
     "--list_tests", action='store_true',
     help="print test names instead of running them",
 )
+parser.add_argument(
+    "--benchmarks", action='store_true',
+    help="run benchmarks instead of tests and print the durations logged by the engine",
+)
 args = parser.parse_args()
 
 example_suite_dir = Path(args.example_suite).resolve()
@@ -74,10 +80,16 @@ def write_test_config_module():
         fields.append(f"filter = {lua_string_literal(args.test_filter)}")
     if args.list_tests:
         fields.append("list = true")
+    if args.benchmarks:
+        fields.append("benchmarks = true")
     with open(test_config_dir / "test_config.lua", "w", encoding="utf-8") as stream:
         stream.write(f"return {{ {', '.join(fields)} }}\n")
 
 
+# Durations logged by the engine, e.g. "Snapshot 'name' is restored in 12.5ms"
+benchmark_duration_pattern = re.compile(r"(Snapshot '.*' is \w+) in ([0-9.]+)ms")
+
+
 def parse_test_name(status, line):
     return line.split(status)[1].strip().split("\t", maxsplit=1)
 
@@ -111,7 +123,8 @@ def run_test(test_name):
             "[Video]\n"
             "resolution x = 640\n"
             "resolution y = 480\n"
-            "framerate limit = 60\n"
+            # Benchmarks run as fast as possible
+            f"framerate limit = {0 if args.benchmarks else 60}\n"
             "[Game]\n"
             "smooth animation transitions = true\n"
             "[Lua]\n"
@@ -119,6 +132,7 @@ def run_test(test_name):
             "lua profiler = true\n"
         )
     stdout_lines = list()
+    durations = dict()
     test_success = True
     fatal_errors = list()
     with subprocess.Popen(
@@ -143,6 +157,10 @@ def run_test(test_name):
                 sys.stdout.write(line)
             else:
                 stdout_lines.append(line)
+            if args.benchmarks:
+                match = benchmark_duration_pattern.search(line)
+                if match:
+                    durations.setdefault(match.group(1), []).append(float(match.group(2)))
             if "Quit requested by a Lua script" in line:
                 quit_requested = True
             elif "TEST_FOUND" in line:
@@ -180,6 +198,11 @@ def run_test(test_name):
         shutil.copyfile(config_dir / "openmw.log", work_dir / f"{test_name}.{time_str}.log")
     if fatal_errors and not args.verbose:
         sys.stdout.writelines(stdout_lines)
+    for name, values in sorted(durations.items()):
+        print(
+            f"[ BENCHMARK] {name}: {len(values)} times, mean {statistics.mean(values):.3f} ms, "
+            f"median {statistics.median(values):.3f} ms, min {min(values):.3f} ms, max {max(values):.3f} ms"
+        )
     if not args.list_tests:
         total_duration = (time.time() - start) * 1000
         print(f'\n[----------] {count} tests from {test_name} ({total_duration:.3f} ms total)')